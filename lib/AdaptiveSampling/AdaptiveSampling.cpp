@@ -0,0 +1,130 @@
+#include "AdaptiveSampling.h"
+#include <math.h>
+
+AdaptiveChannel::AdaptiveChannel(const SamplingPolicy &policy)
+{
+    _watchCount = 0;
+    setPolicy(policy);
+    reset();
+}
+
+void AdaptiveChannel::setPolicy(const SamplingPolicy &policy)
+{
+    _policy = policy;
+    if (_policy.minPeriodMs < 1)
+        _policy.minPeriodMs = 1;
+    if (_policy.maxPeriodMs < _policy.minPeriodMs)
+        _policy.maxPeriodMs = _policy.minPeriodMs;
+}
+
+void AdaptiveChannel::setWatch(const float *levels, uint8_t count)
+{
+    _watchCount = 0;
+    for (uint8_t i = 0; levels != nullptr && i < count && _watchCount < ADAPTIVE_MAX_WATCH; i++)
+        if (!isnan(levels[i]))
+            _watch[_watchCount++] = levels[i];
+}
+
+uint32_t AdaptiveChannel::watchLimit(float value, float slopePerMs) const
+{
+    uint32_t limit = _policy.maxPeriodMs;
+    for (uint8_t i = 0; i < _watchCount; i++)
+    {
+        float remaining = _watch[i] - value;
+
+        // Em cima do limiar o ruído pode cruzá-lo a qualquer momento
+        if (fabsf(remaining) < _policy.deadband)
+            return _policy.minPeriodMs;
+
+        // Indo na direção do limiar: lê antes da metade do tempo até cruzá-lo
+        if (remaining * slopePerMs > 0)
+        {
+            float ms = remaining / slopePerMs / 2;
+            if (ms < limit)
+                limit = ms < _policy.minPeriodMs ? _policy.minPeriodMs : (uint32_t)ms;
+        }
+    }
+    return limit;
+}
+
+void AdaptiveChannel::reset()
+{
+    _valid = false;
+    _value = NAN;
+    _reported = NAN;
+    _lastMs = 0;
+    _nextMs = 0;
+    _periodMs = _policy.minPeriodMs;
+    _samples = 0;
+    _changes = 0;
+}
+
+bool AdaptiveChannel::due(uint32_t nowMs) const
+{
+    if (_samples == 0)
+        return true;
+    // Comparação com sinal para sobreviver ao overflow do millis()
+    return (int32_t)(nowMs - _nextMs) >= 0;
+}
+
+bool AdaptiveChannel::update(uint32_t nowMs, float value)
+{
+    _samples++;
+
+    // Leitura falhou: mantém o último valor e tenta de novo logo
+    if (isnan(value))
+    {
+        _nextMs = nowMs + _policy.minPeriodMs;
+        return false;
+    }
+
+    if (!_valid)
+    {
+        // Primeira leitura: começa rápido e deixa o canal provar que está estável
+        _valid = true;
+        _value = value;
+        _reported = value;
+        _lastMs = nowMs;
+        _periodMs = _policy.minPeriodMs;
+        _nextMs = nowMs + _periodMs;
+        _changes++;
+        return true;
+    }
+
+    uint32_t dtMs = nowMs - _lastMs;
+    float delta = fabsf(value - _value);
+    float slope = dtMs > 0 ? (value - _value) / dtMs : 0;
+    _value = value;
+    _lastMs = nowMs;
+
+    // Período que levaria o canal a andar uma deadband na taxa atual
+    uint32_t target = _policy.maxPeriodMs;
+    if (dtMs > 0 && delta > 0)
+    {
+        float ms = _policy.deadband * dtMs / delta;
+        if (ms < target)
+            target = ms < _policy.minPeriodMs ? _policy.minPeriodMs : (uint32_t)ms;
+    }
+
+    // Perto de um limiar vigiado vale o menor dos dois, sem esperar o crescimento gradual
+    uint32_t watch = watchLimit(value, slope);
+    if (watch < target)
+        target = watch;
+
+    // Acelera na hora; desacelera no máximo 50% por amostra
+    if (target <= _periodMs)
+        _periodMs = target;
+    else
+    {
+        uint32_t grown = _periodMs + _periodMs / 2 + 1;
+        _periodMs = target < grown ? target : grown;
+    }
+    _nextMs = nowMs + _periodMs;
+
+    if (fabsf(value - _reported) < _policy.deadband)
+        return false;
+
+    _reported = value;
+    _changes++;
+    return true;
+}
@@ -0,0 +1,100 @@
+#ifndef ADAPTIVESAMPLING_H
+#define ADAPTIVESAMPLING_H
+
+#include <stdint.h>
+
+#define ADAPTIVE_MAX_WATCH 4 // Limiares vigiados por canal
+
+/**
+ * @brief Limites e sensibilidade da amostragem de um canal
+ */
+struct SamplingPolicy
+{
+    uint32_t minPeriodMs; // Período mais curto (canal mudando rápido)
+    uint32_t maxPeriodMs; // Período mais longo (canal estável)
+    float deadband;       // Variação considerada relevante, na unidade do canal
+};
+
+/**
+ * @brief Agenda de amostragem guiada pela taxa de variação
+ *
+ * Cada amostra estima a taxa de variação em relação à anterior e escolhe o
+ * período que levaria o canal a andar uma deadband: deadband / taxa, limitado
+ * a [minPeriodMs, maxPeriodMs]. O período encurta de imediato quando o canal
+ * acelera e cresce no máximo 50% por amostra quando ele estabiliza, para não
+ * perder o começo de uma nova mudança por causa de um ruído isolado.
+ *
+ * Limiares vigiados (ex: os das regras de alarme) encurtam o período perto
+ * deles: a próxima leitura sai antes da metade do tempo estimado até o
+ * canal cruzar o limiar, e a menos de uma deadband dele o canal é lido no
+ * período mínimo. Assim uma mudança lenta longe dos limiares custa poucas
+ * leituras, e a travessia de um limiar é vista tão cedo quanto numa
+ * leitura fixa no período mínimo.
+ *
+ * Não faz leitura nenhuma: o chamador consulta due() e entrega o valor lido
+ * em update(), que também diz se ele se afastou do último valor relevante.
+ */
+class AdaptiveChannel
+{
+public:
+    AdaptiveChannel(const SamplingPolicy &policy);
+
+    void setPolicy(const SamplingPolicy &policy);
+
+    /**
+     * @brief Troca os limiares vigiados (no máximo ADAPTIVE_MAX_WATCH; o resto é ignorado)
+     * @param levels Limiares na unidade do canal (nullptr/0 = nenhum)
+     */
+    void setWatch(const float *levels, uint8_t count);
+
+    /**
+     * @brief Esquece o histórico; a próxima consulta a due() já é verdadeira
+     */
+    void reset();
+
+    /**
+     * @brief Indica se o canal deve ser lido agora
+     * @param nowMs Tempo atual em milissegundos
+     */
+    bool due(uint32_t nowMs) const;
+
+    /**
+     * @brief Registra uma leitura e reagenda a próxima
+     * @param nowMs Instante da leitura em milissegundos
+     * @param value Valor lido (NaN = leitura falhou, tenta de novo em minPeriodMs)
+     * @return true se o valor andou pelo menos uma deadband desde a última
+     *         mudança relevante (ou é a primeira leitura válida)
+     */
+    bool update(uint32_t nowMs, float value);
+
+    // Último valor válido e o valor da última mudança relevante
+    float value() const { return _value; }
+    float reported() const { return _reported; }
+
+    uint32_t periodMs() const { return _periodMs; }
+    uint8_t watchCount() const { return _watchCount; }
+    uint32_t nextMs() const { return _nextMs; }
+
+    // Contadores desde o reset()
+    uint32_t samples() const { return _samples; }
+    uint32_t changes() const { return _changes; }
+
+private:
+    SamplingPolicy _policy;
+    float _watch[ADAPTIVE_MAX_WATCH];
+    uint8_t _watchCount;
+
+    bool _valid;
+    float _value;
+    float _reported;
+    uint32_t _lastMs;
+    uint32_t _nextMs;
+    uint32_t _periodMs;
+
+    uint32_t _samples;
+    uint32_t _changes;
+
+    uint32_t watchLimit(float value, float slopePerMs) const;
+};
+
+#endif
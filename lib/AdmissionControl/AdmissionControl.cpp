@@ -0,0 +1,111 @@
+#include "AdmissionControl.h"
+#include <string.h>
+
+AdmissionControl::AdmissionControl(const AdmissionConfig &config)
+{
+    _config = config;
+    if (_config.maxInFlight < 1)
+        _config.maxInFlight = 1;
+    if (_config.maxPerClient < 1)
+        _config.maxPerClient = 1;
+    if (_config.retryAfterSec < 1)
+        _config.retryAfterSec = 1;
+    memset(_clients, 0, sizeof(_clients));
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+AdmissionClient *AdmissionControl::find(uint32_t ip)
+{
+    for (AdmissionClient &c : _clients)
+        if (c.ip == ip)
+            return &c;
+    return nullptr;
+}
+
+AdmissionClient *AdmissionControl::allocate(uint32_t ip, uint32_t nowMs)
+{
+    // Posição livre, senão o cliente ocioso há mais tempo
+    AdmissionClient *slot = nullptr;
+    for (AdmissionClient &c : _clients)
+    {
+        if (c.ip == 0)
+        {
+            slot = &c;
+            break;
+        }
+        if (c.inFlight == 0 && nowMs - c.lastSeenMs >= _config.idleMs &&
+            (slot == nullptr || c.lastSeenMs - slot->lastSeenMs > 0x80000000u))
+            slot = &c;
+    }
+    if (slot == nullptr)
+        return nullptr;
+
+    if (slot->ip != 0)
+        _stats.evictions++;
+    else
+        _stats.clients++;
+    memset(slot, 0, sizeof(*slot));
+    slot->ip = ip;
+    return slot;
+}
+
+AdmissionResult AdmissionControl::shed(AdmissionClient *client, AdmissionResult result)
+{
+    if (client != nullptr)
+        client->shed++;
+    _stats.results[result]++;
+    return result;
+}
+
+AdmissionResult AdmissionControl::admit(uint32_t ip, uint32_t nowMs, bool poll, uint16_t &retryAfterSec)
+{
+    retryAfterSec = _config.retryAfterSec;
+
+    AdmissionClient *client = find(ip);
+    if (client == nullptr)
+        client = allocate(ip, nowMs);
+    if (client == nullptr)
+        return shed(nullptr, ADMIT_SHED_TABLE);
+    client->lastSeenMs = nowMs;
+
+    if (poll && client->polled && nowMs - client->lastPollMs < _config.minPollMs)
+    {
+        // Arredonda para cima: Retry-After é em segundos inteiros
+        uint32_t waitMs = _config.minPollMs - (nowMs - client->lastPollMs);
+        retryAfterSec = (uint16_t)((waitMs + 999) / 1000);
+        return shed(client, ADMIT_SHED_RATE);
+    }
+    uint32_t limit = _config.maxInFlight;
+    if (client->inFlight > 0)
+        limit = limit > _config.reserved ? limit - _config.reserved : 1;
+    if (_stats.inFlight >= limit || client->inFlight >= _config.maxPerClient)
+        return shed(client, ADMIT_SHED_BUSY);
+
+    if (poll)
+    {
+        client->lastPollMs = nowMs;
+        client->polled = 1;
+    }
+    client->inFlight++;
+    client->admitted++;
+    _stats.inFlight++;
+    if (_stats.inFlight > _stats.peakInFlight)
+        _stats.peakInFlight = _stats.inFlight;
+    _stats.results[ADMIT_OK]++;
+    return ADMIT_OK;
+}
+
+void AdmissionControl::release(uint32_t ip)
+{
+    AdmissionClient *client = find(ip);
+    if (client != nullptr && client->inFlight > 0)
+        client->inFlight--;
+    if (_stats.inFlight > 0)
+        _stats.inFlight--;
+}
+
+const char *AdmissionControl::resultName(AdmissionResult result)
+{
+    static const char *NAMES[ADMIT_RESULT_COUNT] = {"admitted", "shed_busy", "shed_rate", "shed_table"};
+    return result < ADMIT_RESULT_COUNT ? NAMES[result] : "?";
+}
@@ -0,0 +1,117 @@
+#ifndef ADMISSIONCONTROL_H
+#define ADMISSIONCONTROL_H
+
+#include <stdint.h>
+
+#define ADMISSION_MAX_CLIENTS 16 // O softAP do ESP32 aceita no máximo 10 estações
+
+/**
+ * @brief Limites da admissão de requisições HTTP
+ */
+struct AdmissionConfig
+{
+    uint8_t maxInFlight;    // Requisições em andamento no servidor inteiro
+    uint8_t maxPerClient;   // Requisições em andamento por cliente
+    uint8_t reserved;       // Posições que só aceitam a primeira requisição de um cliente
+    uint32_t minPollMs;     // Intervalo mínimo entre requisições de polling do mesmo cliente
+    uint32_t idleMs;        // Cliente sem requisição há esse tempo libera a posição na tabela
+    uint16_t retryAfterSec; // Retry-After sugerido quando o servidor está cheio
+};
+
+// 6 em andamento (2 por cliente, 2 guardadas para quem não tem nenhuma),
+// polling no máximo a cada 500 ms
+const AdmissionConfig ADMISSION_DEFAULT_CONFIG = {6, 2, 2, 500, 30000, 2};
+
+// Resultado de admit()
+enum AdmissionResult
+{
+    ADMIT_OK = 0,
+    ADMIT_SHED_BUSY,  // Servidor (ou o próprio cliente) no limite de requisições em andamento
+    ADMIT_SHED_RATE,  // Polling antes de minPollMs
+    ADMIT_SHED_TABLE, // Tabela de clientes cheia de clientes ativos
+    ADMIT_RESULT_COUNT
+};
+
+/**
+ * @brief Estado de um cliente (por endereço IPv4)
+ */
+struct AdmissionClient
+{
+    uint32_t ip; // 0 = posição livre
+    uint32_t lastSeenMs;
+    uint32_t lastPollMs;
+    uint8_t inFlight;
+    uint8_t polled; // lastPollMs já tem um valor
+    uint16_t reserved;
+    uint32_t admitted;
+    uint32_t shed;
+};
+
+/**
+ * @brief Contadores desde o início (uint32_t: podem ir direto para o /metrics)
+ */
+struct AdmissionStats
+{
+    uint32_t results[ADMIT_RESULT_COUNT]; // Requisições por AdmissionResult
+    uint32_t inFlight;
+    uint32_t peakInFlight;
+    uint32_t clients;   // Posições ocupadas na tabela
+    uint32_t evictions; // Clientes ociosos retirados para dar lugar a um novo
+};
+
+/**
+ * @brief Controle de admissão e descarte de carga do servidor web
+ *
+ * Cada requisição passa por admit() antes de qualquer trabalho: ou entra
+ * (e precisa de um release() quando terminar), ou é recusada na hora com
+ * o tempo sugerido para o Retry-After. Recusar custa uma resposta curta; sem
+ * o limite, cada requisição a mais segura um PCB do lwIP e heap do AsyncTCP
+ * até acabar, e alguns clientes agressivos esgotam os dois.
+ *
+ * Justiça entre clientes: a segunda requisição de um cliente só entra se
+ * ainda sobrarem 'reserved' posições livres, de modo que quem não tem nada
+ * em andamento (a página fazendo polling) ainda encontra lugar.
+ *
+ * A tabela é fixa (ADMISSION_MAX_CLIENTS); um cliente novo reaproveita a
+ * posição do mais antigo ocioso há idleMs. O limite de polling vale só
+ * para as rotas marcadas como polling, e conta do início da requisição
+ * anterior que entrou.
+ *
+ * Não é thread-safe: no firmware todas as chamadas vêm da tarefa do AsyncTCP.
+ */
+class AdmissionControl
+{
+public:
+    AdmissionControl(const AdmissionConfig &config = ADMISSION_DEFAULT_CONFIG);
+
+    /**
+     * @brief Decide se uma requisição entra
+     * @param ip Endereço IPv4 do cliente
+     * @param nowMs Tempo atual em milissegundos
+     * @param poll true para rotas de polling (sujeitas a minPollMs)
+     * @param retryAfterSec Preenchido quando a requisição é recusada
+     */
+    AdmissionResult admit(uint32_t ip, uint32_t nowMs, bool poll, uint16_t &retryAfterSec);
+
+    /**
+     * @brief Fim de uma requisição admitida (resposta enviada ou conexão caída)
+     */
+    void release(uint32_t ip);
+
+    const AdmissionStats &stats() const { return _stats; }
+    const AdmissionConfig &config() const { return _config; }
+    const AdmissionClient &client(uint8_t index) const { return _clients[index]; }
+
+    static const char *resultName(AdmissionResult result);
+
+private:
+    AdmissionConfig _config;
+    AdmissionClient _clients[ADMISSION_MAX_CLIENTS];
+    AdmissionStats _stats;
+
+    AdmissionClient *find(uint32_t ip);
+    AdmissionClient *allocate(uint32_t ip, uint32_t nowMs);
+    AdmissionResult shed(AdmissionClient *client, AdmissionResult result);
+};
+
+#endif
@@ -0,0 +1,301 @@
+#include "AlarmEngine.h"
+#include <math.h>
+#include <string.h>
+
+static const char CHANNEL_KEYS[ALARM_CH_COUNT] = {'t', 'h', 'p', 'u', 'l'};
+static const char *const KIND_NAMES[ALARM_KIND_COUNT] = {"above", "below", "rise", "fall"};
+static const char *const STATE_NAMES[] = {"idle", "pending", "active", "acked"};
+static const uint32_t RULE_IMAGE_MAGIC = 0x414C5231; // "ALR1"
+
+// Quanto a medida passou do limiar (> 0 = além, < -hysteresis = desarma)
+static float excess(const AlarmRule &rule, float measure)
+{
+    switch (rule.kind)
+    {
+    case ALARM_BELOW:
+        return rule.threshold - measure;
+    case ALARM_FALL:
+        return -measure - rule.threshold;
+    default: // ALARM_ABOVE, ALARM_RISE
+        return measure - rule.threshold;
+    }
+}
+
+AlarmEngine::AlarmEngine()
+{
+    clear();
+}
+
+void AlarmEngine::clear()
+{
+    memset(&_snap, 0, sizeof(_snap));
+    _activeCount = 0;
+    _ackedCount = 0;
+}
+
+static uint32_t imageChecksum(const AlarmRuleImage &image)
+{
+    uint32_t hash = 2166136261u;
+    const uint8_t *bytes = (const uint8_t *)image.rules;
+    hash = (hash ^ image.count) * 16777619u;
+    for (size_t i = 0; i < sizeof(image.rules); i++)
+        hash = (hash ^ bytes[i]) * 16777619u;
+    return hash;
+}
+
+void AlarmEngine::saveRules(AlarmRuleImage &image) const
+{
+    memset(&image, 0, sizeof(image));
+    image.magic = RULE_IMAGE_MAGIC;
+    image.count = _snap.count;
+    memcpy(image.rules, _snap.rules, _snap.count * sizeof(AlarmRule));
+    image.checksum = imageChecksum(image);
+}
+
+bool AlarmEngine::loadRules(const AlarmRuleImage &image)
+{
+    if (image.magic != RULE_IMAGE_MAGIC || image.count > ALARM_MAX_RULES || image.checksum != imageChecksum(image))
+        return false;
+    for (uint8_t i = 0; i < image.count; i++)
+        if (!valid(image.rules[i]))
+            return false;
+
+    clear();
+    for (uint8_t i = 0; i < image.count; i++)
+        addRule(image.rules[i]);
+    return true;
+}
+
+bool AlarmEngine::valid(const AlarmRule &rule)
+{
+    if (rule.channel >= ALARM_CH_COUNT || rule.kind >= ALARM_KIND_COUNT)
+        return false;
+    if (!isfinite(rule.threshold) || !isfinite(rule.hysteresis) || rule.hysteresis < 0)
+        return false;
+    // Taxa: limiar positivo (a direção vem do tipo) e janela de pelo menos 1 s
+    if (rule.kind == ALARM_RISE || rule.kind == ALARM_FALL)
+        return rule.threshold > 0 && rule.rateWindowMs >= 1000;
+    return true;
+}
+
+int AlarmEngine::addRule(const AlarmRule &rule)
+{
+    if (_snap.count >= ALARM_MAX_RULES || !valid(rule))
+        return -1;
+    uint8_t index = _snap.count++;
+    _snap.rules[index] = rule;
+    memset(&_snap.status[index], 0, sizeof(AlarmRuleStatus));
+    return index;
+}
+
+bool AlarmEngine::setRule(uint8_t index, const AlarmRule &rule)
+{
+    if (index == _snap.count)
+        return addRule(rule) >= 0;
+    if (index > _snap.count || !valid(rule))
+        return false;
+    _snap.rules[index] = rule;
+    memset(&_snap.status[index], 0, sizeof(AlarmRuleStatus));
+    recount();
+    return true;
+}
+
+bool AlarmEngine::removeRule(uint8_t index)
+{
+    if (index >= _snap.count)
+        return false;
+    // Mantém a ordem: os índices seguintes andam uma posição
+    for (uint8_t i = index; i + 1 < _snap.count; i++)
+    {
+        _snap.rules[i] = _snap.rules[i + 1];
+        _snap.status[i] = _snap.status[i + 1];
+    }
+    _snap.count--;
+    recount();
+    return true;
+}
+
+bool AlarmEngine::acknowledge(uint8_t index)
+{
+    if (index >= _snap.count || _snap.status[index].state != RULE_ACTIVE)
+        return false;
+    _snap.status[index].state = RULE_ACKED;
+    recount();
+    return true;
+}
+
+void AlarmEngine::acknowledgeAll()
+{
+    for (uint8_t i = 0; i < _snap.count; i++)
+        if (_snap.status[i].state == RULE_ACTIVE)
+            _snap.status[i].state = RULE_ACKED;
+    recount();
+}
+
+bool AlarmEngine::apply(const AlarmCommand &command)
+{
+    switch (command.op)
+    {
+    case ALARM_OP_SET:
+        return setRule(command.index, command.rule);
+    case ALARM_OP_REMOVE:
+        return removeRule(command.index);
+    case ALARM_OP_ACK:
+        return acknowledge(command.index);
+    case ALARM_OP_ACK_ALL:
+        acknowledgeAll();
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool AlarmEngine::measure(const AlarmRule &rule, AlarmRuleStatus &status, float value, uint32_t nowMs)
+{
+    if (rule.kind != ALARM_RISE && rule.kind != ALARM_FALL)
+    {
+        status.measure = value;
+        status.measured = 1;
+        return true;
+    }
+
+    // Taxa pelas pontas da janela: O(1), sem guardar as amostras do meio
+    if (status.rateStage == 0)
+    {
+        status.rateRef = value;
+        status.rateRefMs = nowMs;
+        status.rateStage = 1;
+        return false;
+    }
+    uint32_t elapsed = nowMs - status.rateRefMs;
+    if (elapsed >= rule.rateWindowMs)
+    {
+        status.measure = (value - status.rateRef) * 3600000.0f / elapsed;
+        status.rateRef = value;
+        status.rateRefMs = nowMs;
+        status.rateStage = 2;
+        status.measured = 1;
+    }
+    return status.rateStage == 2;
+}
+
+void AlarmEngine::enter(AlarmRuleStatus &status, uint8_t state, uint32_t nowMs)
+{
+    status.state = state;
+    status.sinceMs = nowMs;
+}
+
+void AlarmEngine::evaluate(const float values[ALARM_CH_COUNT], uint32_t nowMs)
+{
+    for (uint8_t i = 0; i < _snap.count; i++)
+    {
+        const AlarmRule &rule = _snap.rules[i];
+        AlarmRuleStatus &status = _snap.status[i];
+
+        if (!rule.enabled)
+        {
+            if (status.state != RULE_IDLE)
+                enter(status, RULE_IDLE, nowMs);
+            continue;
+        }
+
+        float value = values[rule.channel];
+        if (isnan(value) || !measure(rule, status, value, nowMs))
+            continue;
+
+        float over = excess(rule, status.measure);
+        switch (status.state)
+        {
+        case RULE_IDLE:
+            if (over <= 0)
+                break;
+            enter(status, RULE_PENDING, nowMs);
+            // Sem duração mínima dispara na mesma amostra
+            if (rule.minDurationMs > 0)
+                break;
+            // fall through
+        case RULE_PENDING:
+            if (over <= 0)
+                enter(status, RULE_IDLE, nowMs);
+            else if (nowMs - status.sinceMs >= rule.minDurationMs)
+            {
+                enter(status, RULE_ACTIVE, nowMs);
+                status.triggers++;
+            }
+            break;
+        default: // RULE_ACTIVE, RULE_ACKED: só desarma depois da histerese
+            if (over < -rule.hysteresis)
+                enter(status, RULE_IDLE, nowMs);
+            break;
+        }
+    }
+    recount();
+}
+
+bool AlarmEngine::exceeds(const float values[ALARM_CH_COUNT]) const
+{
+    for (uint8_t i = 0; i < _snap.count; i++)
+    {
+        const AlarmRule &rule = _snap.rules[i];
+        if (!rule.enabled || rule.kind == ALARM_RISE || rule.kind == ALARM_FALL)
+            continue;
+        float value = values[rule.channel];
+        if (!isnan(value) && excess(rule, value) > 0)
+            return true;
+    }
+    return false;
+}
+
+void AlarmEngine::recount()
+{
+    _activeCount = 0;
+    _ackedCount = 0;
+    for (uint8_t i = 0; i < _snap.count; i++)
+    {
+        if (_snap.status[i].state == RULE_ACTIVE)
+            _activeCount++;
+        else if (_snap.status[i].state == RULE_ACKED)
+            _ackedCount++;
+    }
+}
+
+bool AlarmEngine::parseChannel(const char *text, uint8_t &channel)
+{
+    for (uint8_t c = 0; c < ALARM_CH_COUNT; c++)
+    {
+        if (text[0] == CHANNEL_KEYS[c] && text[1] == '\0')
+        {
+            channel = c;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool AlarmEngine::parseKind(const char *text, uint8_t &kind)
+{
+    for (uint8_t k = 0; k < ALARM_KIND_COUNT; k++)
+    {
+        if (strcmp(text, KIND_NAMES[k]) == 0)
+        {
+            kind = k;
+            return true;
+        }
+    }
+    return false;
+}
+
+char AlarmEngine::channelKey(uint8_t channel)
+{
+    return channel < ALARM_CH_COUNT ? CHANNEL_KEYS[channel] : '?';
+}
+
+const char *AlarmEngine::kindName(uint8_t kind)
+{
+    return kind < ALARM_KIND_COUNT ? KIND_NAMES[kind] : "?";
+}
+
+const char *AlarmEngine::stateName(uint8_t state)
+{
+    return state <= RULE_ACKED ? STATE_NAMES[state] : "?";
+}
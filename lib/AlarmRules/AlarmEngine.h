@@ -0,0 +1,221 @@
+#ifndef ALARMENGINE_H
+#define ALARMENGINE_H
+
+#include <stdint.h>
+
+#define ALARM_MAX_RULES 12
+
+// Canais avaliados (mesma ordem e chaves do JSON: t, h, p, u, l)
+enum AlarmChannel
+{
+    ALARM_CH_TEMP = 0,
+    ALARM_CH_HUM,
+    ALARM_CH_PRES,
+    ALARM_CH_UV,
+    ALARM_CH_LUMENS,
+    ALARM_CH_COUNT
+};
+
+// O que a regra compara com o limiar
+enum AlarmKind
+{
+    ALARM_ABOVE = 0, // Valor acima do limiar
+    ALARM_BELOW,     // Valor abaixo do limiar
+    ALARM_RISE,      // Subida mais rápida que o limiar (unidade por hora)
+    ALARM_FALL,      // Queda mais rápida que o limiar (unidade por hora)
+    ALARM_KIND_COUNT
+};
+
+/**
+ * @brief Uma linha da tabela de alarmes
+ */
+struct AlarmRule
+{
+    uint8_t channel; // AlarmChannel
+    uint8_t kind;    // AlarmKind
+    uint8_t enabled;
+    uint8_t reserved;
+    float threshold;        // Limiar (valor, ou taxa por hora)
+    float hysteresis;       // Quanto precisa voltar para desarmar
+    uint32_t minDurationMs; // Tempo contínuo além do limiar antes de disparar
+    uint32_t rateWindowMs;  // Janela da estimativa de taxa (RISE/FALL)
+};
+
+// Estado de uma regra
+enum AlarmRuleState
+{
+    RULE_IDLE = 0, // Dentro do limite
+    RULE_PENDING,  // Além do limiar, esperando minDurationMs
+    RULE_ACTIVE,   // Disparado e ainda não confirmado
+    RULE_ACKED     // Confirmado; rearma sozinho quando a condição some
+};
+
+/**
+ * @brief Estado de avaliação de uma regra
+ */
+struct AlarmRuleStatus
+{
+    uint8_t state;     // AlarmRuleState
+    uint8_t rateStage; // 0 = sem referência, 1 = janela aberta, 2 = taxa válida
+    uint8_t measured;  // measure já tem um valor
+    uint8_t reserved;
+    uint32_t sinceMs;  // Início do estado atual
+    uint32_t triggers; // Disparos desde a última edição da regra
+    float measure;     // Último valor comparado (valor ou taxa por hora)
+    float rateRef;     // Valor no início da janela de taxa
+    uint32_t rateRefMs;
+};
+
+/**
+ * @brief Cópia da tabela e dos estados (trivialmente copiável, para SeqLock)
+ */
+struct AlarmSnapshot
+{
+    uint8_t count;
+    uint8_t reserved[3];
+    AlarmRule rules[ALARM_MAX_RULES];
+    AlarmRuleStatus status[ALARM_MAX_RULES];
+};
+
+/**
+ * @brief Cópia só das regras, para guardar fora da RAM (ex: memória RTC no deep sleep)
+ *
+ * O magic e o checksum distinguem uma tabela salva de lixo após perda de energia.
+ */
+struct AlarmRuleImage
+{
+    uint32_t magic;
+    uint8_t count;
+    uint8_t reserved[3];
+    AlarmRule rules[ALARM_MAX_RULES];
+    uint32_t checksum; // FNV-1a de count e rules
+};
+
+// Operações de AlarmCommand
+enum AlarmOp
+{
+    ALARM_OP_SET = 0, // Substitui a regra 'index' (index == count acrescenta)
+    ALARM_OP_REMOVE,
+    ALARM_OP_ACK,     // Confirma a regra 'index'
+    ALARM_OP_ACK_ALL
+};
+
+/**
+ * @brief Edição pedida por outra tarefa (ex: WebServer), aplicada pelo dono da tabela
+ */
+struct AlarmCommand
+{
+    uint8_t op; // AlarmOp
+    uint8_t index;
+    uint16_t reserved;
+    AlarmRule rule;
+};
+
+/**
+ * @brief Tabela de regras de alarme com histerese, duração mínima e rearme
+ *
+ * Cada regra é uma máquina de estados IDLE -> PENDING -> ACTIVE -> ACKED.
+ * Dispara só depois de minDurationMs contínuos além do limiar, e só volta a
+ * IDLE quando o valor recua 'hysteresis' (sem oscilar em cima do limiar).
+ * A confirmação vale por regra e dura só até a condição sumir; o próximo
+ * evento dispara de novo.
+ *
+ * As regras de taxa comparam a variação entre as pontas de uma janela de
+ * rateWindowMs, convertida para unidade por hora. evaluate() custa O(regras)
+ * e não aloca. A tabela tem um único dono (uma tarefa); as outras pedem
+ * edições com AlarmCommand e leem cópias com snapshot().
+ */
+class AlarmEngine
+{
+public:
+    AlarmEngine();
+
+    /**
+     * @brief Remove todas as regras
+     */
+    void clear();
+
+    /**
+     * @brief Acrescenta uma regra
+     * @return Índice da regra, ou -1 se a tabela está cheia ou a regra é inválida
+     */
+    int addRule(const AlarmRule &rule);
+
+    /**
+     * @brief Substitui uma regra (o estado dela recomeça em IDLE)
+     */
+    bool setRule(uint8_t index, const AlarmRule &rule);
+
+    bool removeRule(uint8_t index);
+
+    /**
+     * @brief Confirma uma regra ativa
+     */
+    bool acknowledge(uint8_t index);
+    void acknowledgeAll();
+
+    /**
+     * @brief Aplica uma edição recebida de outra tarefa
+     */
+    bool apply(const AlarmCommand &command);
+
+    /**
+     * @brief Avalia todas as regras com uma nova amostra
+     * @param values Valores na ordem de AlarmChannel (NaN = ausente, regra mantém o estado)
+     * @param nowMs Tempo atual em milissegundos
+     */
+    void evaluate(const float values[ALARM_CH_COUNT], uint32_t nowMs);
+
+    /**
+     * @brief Avaliação instantânea das regras de limiar, sem estado nem duração
+     *
+     * Para quem só tem uma amostra isolada (ex: despertar do modo de baixo consumo).
+     */
+    bool exceeds(const float values[ALARM_CH_COUNT]) const;
+
+    // Alguma regra disparada e não confirmada
+    bool active() const { return _activeCount > 0; }
+    // Alguma regra disparada (confirmada ou não)
+    bool raised() const { return _activeCount + _ackedCount > 0; }
+
+    uint8_t count() const { return _snap.count; }
+    const AlarmRule &rule(uint8_t index) const { return _snap.rules[index]; }
+    const AlarmRuleStatus &status(uint8_t index) const { return _snap.status[index]; }
+
+    /**
+     * @brief Tabela e estados atuais, para publicar a outras tarefas
+     */
+    const AlarmSnapshot &snapshot() const { return _snap; }
+
+    /**
+     * @brief Guarda as regras atuais (sem estado de avaliação)
+     */
+    void saveRules(AlarmRuleImage &image) const;
+
+    /**
+     * @brief Substitui a tabela pelas regras guardadas (estados recomeçam em IDLE)
+     * @return false, sem mexer na tabela, se a cópia não é válida
+     */
+    bool loadRules(const AlarmRuleImage &image);
+
+    static bool valid(const AlarmRule &rule);
+
+    // Chaves usadas na web: canal "t|h|p|u|l", tipo "above|below|rise|fall",
+    // estado "idle|pending|active|acked"
+    static bool parseChannel(const char *text, uint8_t &channel);
+    static bool parseKind(const char *text, uint8_t &kind);
+    static char channelKey(uint8_t channel);
+    static const char *kindName(uint8_t kind);
+    static const char *stateName(uint8_t state);
+
+private:
+    AlarmSnapshot _snap;
+    uint8_t _activeCount;
+    uint8_t _ackedCount;
+
+    bool measure(const AlarmRule &rule, AlarmRuleStatus &status, float value, uint32_t nowMs);
+    void enter(AlarmRuleStatus &status, uint8_t state, uint32_t nowMs);
+    void recount();
+};
+
+#endif
@@ -0,0 +1,76 @@
+#include "AlarmJsonStream.h"
+#include <math.h>
+#include <string.h>
+#include "JsonWriter.h"
+
+AlarmJsonStream::AlarmJsonStream(const AlarmSnapshot &snapshot)
+{
+    _snap = snapshot;
+    _next = 0;
+    _headerDone = false;
+    _done = false;
+}
+
+size_t AlarmJsonStream::fill(uint8_t *buffer, size_t maxLen)
+{
+    size_t len = 0;
+    char item[224];
+
+    while (!_done)
+    {
+        JsonWriter w(item, sizeof(item));
+
+        if (!_headerDone)
+        {
+            w.raw("{\"rules\":[");
+        }
+        else if (_next < _snap.count)
+        {
+            const AlarmRule &rule = _snap.rules[_next];
+            const AlarmRuleStatus &status = _snap.status[_next];
+            char ch[2] = {AlarmEngine::channelKey(rule.channel), '\0'};
+
+            if (_next > 0)
+                w.raw(",");
+            w.beginObject();
+            w.field("i", (uint32_t)_next);
+            w.key("ch");
+            w.string(ch);
+            w.key("kind");
+            w.string(AlarmEngine::kindName(rule.kind));
+            w.field("thr", rule.threshold, 2);
+            w.field("hyst", rule.hysteresis, 2);
+            w.field("min", rule.minDurationMs);
+            w.field("win", rule.rateWindowMs);
+            w.field("on", rule.enabled != 0);
+            w.key("state");
+            w.string(AlarmEngine::stateName(status.state));
+            // Sem amostra (ou taxa sem janela completa) ainda: null
+            w.field("value", status.measured ? status.measure : NAN, 2);
+            w.field("n", status.triggers);
+            w.endObject();
+        }
+        else
+        {
+            w.raw("]}");
+        }
+
+        // Cada item vai inteiro ou fica para o próximo pedaço
+        if (len + w.length() > maxLen)
+            break;
+        memcpy(buffer + len, item, w.length());
+        len += w.length();
+
+        if (!_headerDone)
+            _headerDone = true;
+        else if (_next < _snap.count)
+            _next++;
+        else
+            _done = true;
+    }
+
+    // Nem a próxima regra coube (janela TCP apertada): 0 encerraria a resposta
+    if (len == 0 && !_done)
+        return RESPONSE_TRY_AGAIN;
+    return len;
+}
@@ -0,0 +1,38 @@
+#ifndef ALARMJSONSTREAM_H
+#define ALARMJSONSTREAM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "AlarmEngine.h"
+#include "JsonWriter.h" // RESPONSE_TRY_AGAIN
+
+/**
+ * @brief Gera o JSON de /rules em pedaços, a partir de uma cópia da tabela
+ *
+ * Mesmo contrato do HistoryJsonStream: cada fill() escreve regras inteiras
+ * até maxLen bytes. Formato:
+ * {"rules":[{"i":0,"ch":"t","kind":"above","thr":40.00,"hyst":1.00,
+ *   "min":5000,"win":0,"on":true,"state":"idle","value":23.41,"n":0},...]}
+ * onde "value" é a última medida comparada (valor ou taxa por hora) e "n"
+ * a quantidade de disparos.
+ */
+class AlarmJsonStream
+{
+public:
+    AlarmJsonStream(const AlarmSnapshot &snapshot);
+
+    /**
+     * @brief Escreve o próximo pedaço
+     * @return Bytes escritos; 0 quando terminou; RESPONSE_TRY_AGAIN se o
+     * próximo item não cabe em maxLen (a resposta continua)
+     */
+    size_t fill(uint8_t *buffer, size_t maxLen);
+
+private:
+    AlarmSnapshot _snap;
+    uint8_t _next;
+    bool _headerDone;
+    bool _done;
+};
+
+#endif
@@ -0,0 +1,28 @@
+#include "AnalogAcquisition.h"
+
+AnalogAcquisition::AnalogAcquisition(AdcSource &source, const uint8_t *pins, uint8_t count)
+{
+    _source = &source;
+    if (count > AnalogSnapshot::MAX_CHANNELS)
+        count = AnalogSnapshot::MAX_CHANNELS;
+    _count = count;
+
+    for (uint8_t i = 0; i < AnalogSnapshot::MAX_CHANNELS; i++)
+    {
+        _pins[i] = (i < count) ? pins[i] : 0;
+        _snapshot.raw[i] = 0;
+    }
+    _snapshot.seq = 0;
+    _snapshot.timestampMs = 0;
+}
+
+const AnalogSnapshot &AnalogAcquisition::scan(uint32_t nowMs)
+{
+    // Varredura em lote: canais lidos em sequência, sem delays
+    for (uint8_t i = 0; i < _count; i++)
+        _snapshot.raw[i] = _source->read(_pins[i]);
+
+    _snapshot.timestampMs = nowMs;
+    _snapshot.seq++;
+    return _snapshot;
+}
@@ -0,0 +1,60 @@
+#ifndef ANALOGACQUISITION_H
+#define ANALOGACQUISITION_H
+
+#include <stdint.h>
+#include "AdcSource.h"
+
+/**
+ * @brief Foto instantânea de todos os canais analógicos
+ *
+ * Todos os valores de um snapshot vêm da mesma varredura, então os
+ * consumidores (tracker, sensores, alarme) enxergam leituras coerentes.
+ */
+struct AnalogSnapshot
+{
+    static const uint8_t MAX_CHANNELS = 8;
+
+    uint32_t seq;         // Número da varredura (0 = nenhuma ainda)
+    uint32_t timestampMs; // millis() no momento da varredura
+    int raw[MAX_CHANNELS];
+};
+
+/**
+ * @brief Serviço único de aquisição dos canais ADC
+ *
+ * Faz a leitura de todos os pinos em uma única passada e publica o
+ * resultado como um AnalogSnapshot. Ninguém mais chama analogRead().
+ */
+class AnalogAcquisition
+{
+private:
+    AdcSource *_source;
+    uint8_t _pins[AnalogSnapshot::MAX_CHANNELS];
+    uint8_t _count;
+
+    AnalogSnapshot _snapshot;
+
+public:
+    /**
+     * @param source Fonte das leituras ADC
+     * @param pins Lista de pinos, na ordem dos índices do snapshot
+     * @param count Quantidade de pinos (máx. AnalogSnapshot::MAX_CHANNELS)
+     */
+    AnalogAcquisition(AdcSource &source, const uint8_t *pins, uint8_t count);
+
+    /**
+     * @brief Lê todos os canais em sequência e publica um novo snapshot
+     * @param nowMs Tempo atual em milissegundos
+     * @return Snapshot recém publicado
+     */
+    const AnalogSnapshot &scan(uint32_t nowMs);
+
+    /**
+     * @brief Último snapshot publicado (não faz conversões)
+     */
+    const AnalogSnapshot &latest() const { return _snapshot; }
+
+    uint8_t channelCount() const { return _count; }
+};
+
+#endif
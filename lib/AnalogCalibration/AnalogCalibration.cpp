@@ -0,0 +1,80 @@
+#include "AnalogCalibration.h"
+
+#ifdef ARDUINO
+#include <esp_adc_cal.h>
+#endif
+
+// Curva típica do ADC1 a 11 dB (mV a cada 128 contagens). Gerada a partir do
+// polinômio de correção mais usado para o ESP32 sem calibração de fábrica:
+// V = -9.824e-12 x³ + 1.6557e-8 x² + 8.54597e-4 x + 0.06544
+static const uint16_t TYPICAL_LUT[AdcCalibration::LUT_SIZE] = {
+    65, 175, 285, 395, 506, 617, 727, 837, 947, 1057, 1166,
+    1274, 1382, 1488, 1594, 1698, 1801, 1902, 2002, 2100, 2197, 2291,
+    2384, 2474, 2562, 2648, 2731, 2811, 2889, 2963, 3035, 3103, 3169};
+
+int32_t calInterpolate(const CalCurve &curve, int32_t x)
+{
+    if (curve.count == 0)
+        return 0;
+    if (x <= curve.points[0].in)
+        return curve.points[0].out;
+
+    if (x >= curve.points[curve.count - 1].in)
+        return curve.points[curve.count - 1].out;
+
+    // Segmento [lo, hi] com points[lo].in < x <= points[hi].in
+    uint8_t lo = 0, hi = curve.count - 1;
+    while (hi - lo > 1)
+    {
+        uint8_t mid = (lo + hi) / 2;
+        if (x <= curve.points[mid].in)
+            hi = mid;
+        else
+            lo = mid;
+    }
+
+    const CalPoint &p0 = curve.points[lo];
+    const CalPoint &p1 = curve.points[hi];
+    return p0.out + (int32_t)((int64_t)(p1.out - p0.out) * (x - p0.in) / (p1.in - p0.in));
+}
+
+AdcCalibration::AdcCalibration()
+{
+    setTypical();
+}
+
+void AdcCalibration::setTypical()
+{
+    for (uint8_t i = 0; i < LUT_SIZE; i++)
+        _lut[i] = TYPICAL_LUT[i];
+    _source = "típica";
+}
+
+void AdcCalibration::setLinear(uint16_t vRefMv)
+{
+    // O último ponto (4096) extrapola a reta para manter a interpolação exata
+    for (uint8_t i = 0; i < LUT_SIZE; i++)
+        _lut[i] = (uint16_t)((((uint32_t)i << LUT_SHIFT) * vRefMv + 2047) / 4095);
+    _source = "linear";
+}
+
+bool AdcCalibration::loadFromEfuse()
+{
+#ifdef ARDUINO
+    esp_adc_cal_characteristics_t chars;
+    esp_adc_cal_value_t type = esp_adc_cal_characterize(ADC_UNIT_1, ADC_ATTEN_DB_11, ADC_WIDTH_BIT_12, 1100, &chars);
+    if (type == ESP_ADC_CAL_VAL_DEFAULT_VREF)
+        return false;
+
+    // A caracterização é cara (float e tabelas do IDF): avalia só nos pontos da tabela
+    for (uint8_t i = 0; i < LUT_SIZE; i++)
+    {
+        uint32_t raw = (uint32_t)i << LUT_SHIFT;
+        _lut[i] = (uint16_t)esp_adc_cal_raw_to_voltage(raw > 4095 ? 4095 : raw, &chars);
+    }
+    _source = (type == ESP_ADC_CAL_VAL_EFUSE_TP) ? "eFuse Two Point" : "eFuse Vref";
+    return true;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,89 @@
+#ifndef ANALOGCALIBRATION_H
+#define ANALOGCALIBRATION_H
+
+#include <stdint.h>
+
+/**
+ * @brief Curva linear por partes em inteiros (entrada crescente)
+ *
+ * Fora da faixa o resultado é limitado ao primeiro/último ponto.
+ */
+#define CAL_MAX_POINTS 32
+
+struct CalPoint
+{
+    int32_t in;
+    int32_t out;
+};
+
+struct CalCurve
+{
+    uint8_t count;
+    CalPoint points[CAL_MAX_POINTS];
+};
+
+/**
+ * @brief Interpola a curva em x (busca binária e uma divisão inteira)
+ */
+int32_t calInterpolate(const CalCurve &curve, int32_t x);
+
+/**
+ * @brief Conversão contagens ADC (12 bits) -> milivolts por tabela
+ *
+ * A tabela tem 33 pontos a cada 128 contagens; a conversão é uma
+ * interpolação com deslocamentos, sem float nem divisão. A tabela é gerada
+ * uma vez, a partir da caracterização gravada no eFuse do ESP32 quando
+ * existir, ou de uma curva típica / linear.
+ */
+class AdcCalibration
+{
+public:
+    static const uint8_t LUT_SHIFT = 7; // 128 contagens por segmento
+    static const uint8_t LUT_SIZE = (4096 >> LUT_SHIFT) + 1;
+
+    /**
+     * @brief Começa com a curva típica do ADC1 a 11 dB
+     */
+    AdcCalibration();
+
+    /**
+     * @brief Curva típica do ADC1 do ESP32 a 11 dB (sem dados de fábrica)
+     */
+    void setTypical();
+
+    /**
+     * @brief Reta ideal 0 -> 0 mV, 4095 -> vRefMv (fórmula antiga)
+     */
+    void setLinear(uint16_t vRefMv);
+
+    /**
+     * @brief Usa a caracterização de fábrica (eFuse Two Point ou Vref) do ADC1 a 11 dB
+     * @return true se havia dados no eFuse; false mantém a curva atual
+     * @note Só no ESP32; no host sempre retorna false
+     */
+    bool loadFromEfuse();
+
+    /**
+     * @brief Converte contagens (0 a 4095) em milivolts
+     */
+    uint16_t rawToMv(uint16_t raw) const
+    {
+        if (raw > 4095)
+            raw = 4095;
+        uint16_t i = raw >> LUT_SHIFT;
+        int32_t frac = raw & ((1 << LUT_SHIFT) - 1);
+        int32_t a = _lut[i], b = _lut[i + 1];
+        return (uint16_t)(a + (((b - a) * frac + (1 << (LUT_SHIFT - 1))) >> LUT_SHIFT));
+    }
+
+    /**
+     * @brief Origem da tabela em uso ("eFuse Two Point", "eFuse Vref", "típica", "linear")
+     */
+    const char *source() const { return _source; }
+
+private:
+    uint16_t _lut[LUT_SIZE];
+    const char *_source;
+};
+
+#endif
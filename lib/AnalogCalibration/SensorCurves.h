@@ -0,0 +1,25 @@
+#ifndef SENSORCURVES_H
+#define SENSORCURVES_H
+
+#include "AnalogCalibration.h"
+
+/**
+ * @brief GY-ML8511: mV -> µW/cm² (0.001 mW/cm²)
+ *
+ * Reta do datasheet: 0.99 V no escuro -> 0, 2.80 V -> 15 mW/cm².
+ * Pode receber mais pontos medidos contra um radiômetro.
+ */
+const CalCurve GYML8511_UV_CURVE = {2, {{990, 0}, {2800, 15000}}};
+
+/**
+ * @brief LDR (GL5528) em divisor com 10 kΩ para o GND: mV -> lux
+ *
+ * Modelo R = 15 kΩ * (10 lux / E)^0.7 com 3.3 V no LDR; pontos em progressão
+ * geométrica (razão 1.5) para a interpolação linear acompanhar a lei de
+ * potência (erro de interpolação < 4% acima de 10 lux, mais a resolução de
+ * 1 lux da saída). Substituir por pontos medidos com um
+ * luxímetro quando disponíveis.
+ */
+const CalCurve LDR_LUX_CURVE = {26, {{0, 0}, {387, 1}, {586, 2}, {736, 3}, {960, 5}, {1198, 8}, {1373, 11}, {1622, 17}, {1866, 26}, {2077, 38}, {2295, 58}, {2476, 86}, {2642, 130}, {2779, 195}, {2891, 292}, {2983, 438}, {3055, 657}, {3112, 985}, {3157, 1478}, {3191, 2217}, {3217, 3325}, {3237, 4988}, {3253, 7482}, {3264, 11223}, {3273, 16834}, {3280, 25251}}};
+
+#endif
@@ -0,0 +1,117 @@
+#include "BME280Burst.h"
+#include <math.h>
+
+// Registradores
+#define REG_CHIP_ID 0xD0
+#define REG_RESET 0xE0
+#define REG_CTRL_HUM 0xF2
+#define REG_STATUS 0xF3
+#define REG_CTRL_MEAS 0xF4
+#define REG_CONFIG 0xF5
+
+#define CHIP_ID_BME280 0x60
+#define RESET_WORD 0xB6
+#define STATUS_IM_UPDATE 0x01
+
+#define MODE_SLEEP 0x00
+#define MODE_FORCED 0x01
+#define MODE_NORMAL 0x03
+
+// Valor devolvido pelo sensor quando a grandeza ainda não foi medida
+#define ADC_SKIPPED_20BIT 0x80000
+#define ADC_SKIPPED_16BIT 0x8000
+
+BME280Burst::BME280Burst(HalI2C &bus)
+{
+    _bus = &bus;
+    _address = 0x76;
+    _config = BME280_WEATHER_CONFIG;
+}
+
+bool BME280Burst::begin(uint8_t address, const BME280Config &config)
+{
+    _address = address;
+
+    uint8_t id = 0;
+    if (!_bus->readRegs(_address, REG_CHIP_ID, &id, 1) || id != CHIP_ID_BME280)
+        return false;
+
+    // Reset por software e espera a cópia da NVM para os registradores
+    _bus->writeReg(_address, REG_RESET, RESET_WORD);
+    Hal::clock().delayMs(2);
+    uint8_t status = STATUS_IM_UPDATE;
+    for (int i = 0; i < 10 && (status & STATUS_IM_UPDATE); i++)
+    {
+        Hal::clock().delayMs(1);
+        if (!_bus->readRegs(_address, REG_STATUS, &status, 1))
+            return false;
+    }
+
+    uint8_t block1[BME280_CALIB1_LEN];
+    uint8_t block2[BME280_CALIB2_LEN];
+    if (!_bus->readRegs(_address, BME280_CALIB1_REG, block1, sizeof(block1)) ||
+        !_bus->readRegs(_address, BME280_CALIB2_REG, block2, sizeof(block2)))
+        return false;
+    bme280ParseCalib(block1, block2, _calib);
+
+    return configure(config);
+}
+
+bool BME280Burst::configure(const BME280Config &config)
+{
+    _config = config;
+
+    // O registrador config só é aceito com segurança em modo sleep
+    if (!_bus->writeReg(_address, REG_CTRL_MEAS, MODE_SLEEP))
+        return false;
+    if (!_bus->writeReg(_address, REG_CONFIG, ((config.standby & 0x07) << 5) | ((config.filter & 0x07) << 2)))
+        return false;
+    // ctrl_hum só tem efeito após a escrita seguinte em ctrl_meas
+    if (!_bus->writeReg(_address, REG_CTRL_HUM, config.osrsH & 0x07))
+        return false;
+
+    uint8_t mode = config.normalMode ? MODE_NORMAL : MODE_FORCED;
+    return _bus->writeReg(_address, REG_CTRL_MEAS, ((config.osrsT & 0x07) << 5) | ((config.osrsP & 0x07) << 2) | mode);
+}
+
+void BME280Burst::triggerForced()
+{
+    _bus->writeReg(_address, REG_CTRL_MEAS, ((_config.osrsT & 0x07) << 5) | ((_config.osrsP & 0x07) << 2) | MODE_FORCED);
+}
+
+void BME280Burst::startMeasurement()
+{
+    if (!_config.normalMode)
+        triggerForced();
+}
+
+bool BME280Burst::readRaw(BME280Raw &raw)
+{
+    uint8_t data[BME280_DATA_LEN];
+    if (!_bus->readRegs(_address, BME280_DATA_REG, data, sizeof(data)))
+        return false;
+    bme280ParseRaw(data, raw);
+    return true;
+}
+
+bool BME280Burst::read(BME280Reading &out, bool triggerNext)
+{
+    BME280Raw raw;
+    bool ok = readRaw(raw);
+
+    // Modo forçado: já dispara a próxima conversão, lida no próximo ciclo
+    if (triggerNext && !_config.normalMode)
+        triggerForced();
+
+    if (!ok || raw.adcT == ADC_SKIPPED_20BIT)
+        return false;
+
+    bme280Compensate(_calib, raw, out);
+
+    // Grandezas com oversampling desligado não são medidas
+    if (raw.adcP == ADC_SKIPPED_20BIT)
+        out.pres = NAN;
+    if (raw.adcH == ADC_SKIPPED_16BIT)
+        out.hum = NAN;
+    return true;
+}
@@ -0,0 +1,85 @@
+#ifndef BME280BURST_H
+#define BME280BURST_H
+
+#include "Hal.h"
+#include "BME280Compensation.h"
+
+/**
+ * @brief Configuração de aquisição do BME280
+ */
+struct BME280Config
+{
+    // Oversampling: 0 = desligado, 1..5 = x1, x2, x4, x8, x16
+    uint8_t osrsT;
+    uint8_t osrsP;
+    uint8_t osrsH;
+    // Filtro IIR: 0 = desligado, 1..4 = coeficiente 2, 4, 8, 16
+    uint8_t filter;
+    // Intervalo entre medições no modo normal: 0..7 (0.5 ms a 20 ms, ver datasheet)
+    uint8_t standby;
+    // true = modo normal (contínuo), false = modo forçado (uma medição por leitura)
+    bool normalMode;
+};
+
+/**
+ * @brief Configuração recomendada pelo datasheet para monitoramento de clima:
+ * modo forçado, x1 em tudo, sem filtro.
+ */
+const BME280Config BME280_WEATHER_CONFIG = {1, 1, 1, 0, 0, false};
+
+/**
+ * @brief Driver BME280 com leitura em rajada única
+ *
+ * read() faz uma única transação I2C (0xF7..0xFE, 8 bytes) e compensa as
+ * três grandezas juntas, reaproveitando o t_fine. No modo forçado, a
+ * leitura devolve a medição anterior e já dispara a próxima, então nunca
+ * espera pela conversão.
+ */
+class BME280Burst
+{
+private:
+    HalI2C *_bus;
+    uint8_t _address;
+    BME280Config _config;
+    BME280Calib _calib;
+
+    void triggerForced();
+
+public:
+    BME280Burst(HalI2C &bus = Hal::i2c());
+
+    /**
+     * @brief Detecta o sensor, lê a calibração e aplica a configuração
+     * @param address Endereço I2C (0x76 ou 0x77)
+     * @return false se o sensor não respondeu ou não é um BME280
+     */
+    bool begin(uint8_t address, const BME280Config &config = BME280_WEATHER_CONFIG);
+
+    /**
+     * @brief Troca oversampling/filtro/modo em tempo de execução
+     */
+    bool configure(const BME280Config &config);
+
+    /**
+     * @brief Dispara uma conversão no modo forçado (sem efeito no modo normal)
+     *
+     * Para quem lê em intervalos variáveis: dispare, espere a conversão
+     * (~10 ms com x1) e leia com read(out, false), assim o valor não fica
+     * com a idade de um período inteiro.
+     */
+    void startMeasurement();
+
+    /**
+     * @brief Lê e compensa temperatura, pressão e umidade (uma rajada I2C)
+     * @param triggerNext No modo forçado, já dispara a próxima conversão
+     * @return false se a leitura falhou ou ainda não há medição válida
+     */
+    bool read(BME280Reading &out, bool triggerNext = true);
+
+    /**
+     * @brief Última rajada bruta (útil para depuração)
+     */
+    bool readRaw(BME280Raw &raw);
+};
+
+#endif
@@ -0,0 +1,100 @@
+#include "BME280Compensation.h"
+
+static uint16_t u16le(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static int16_t s16le(const uint8_t *p)
+{
+    return (int16_t)u16le(p);
+}
+
+void bme280ParseCalib(const uint8_t block1[BME280_CALIB1_LEN], const uint8_t block2[BME280_CALIB2_LEN], BME280Calib &calib)
+{
+    calib.T1 = u16le(&block1[0]);
+    calib.T2 = s16le(&block1[2]);
+    calib.T3 = s16le(&block1[4]);
+    calib.P1 = u16le(&block1[6]);
+    calib.P2 = s16le(&block1[8]);
+    calib.P3 = s16le(&block1[10]);
+    calib.P4 = s16le(&block1[12]);
+    calib.P5 = s16le(&block1[14]);
+    calib.P6 = s16le(&block1[16]);
+    calib.P7 = s16le(&block1[18]);
+    calib.P8 = s16le(&block1[20]);
+    calib.P9 = s16le(&block1[22]);
+    calib.H1 = block1[25]; // 0xA1 (0xA0 não é usado)
+
+    calib.H2 = s16le(&block2[0]);
+    calib.H3 = block2[2];
+    // H4 e H5 são de 12 bits e dividem o registrador 0xE5
+    calib.H4 = (int16_t)(((int8_t)block2[3]) * 16 | (block2[4] & 0x0F));
+    calib.H5 = (int16_t)(((int8_t)block2[5]) * 16 | (block2[4] >> 4));
+    calib.H6 = (int8_t)block2[6];
+}
+
+void bme280ParseRaw(const uint8_t data[BME280_DATA_LEN], BME280Raw &raw)
+{
+    raw.adcP = ((int32_t)data[0] << 12) | ((int32_t)data[1] << 4) | (data[2] >> 4);
+    raw.adcT = ((int32_t)data[3] << 12) | ((int32_t)data[4] << 4) | (data[5] >> 4);
+    raw.adcH = ((int32_t)data[6] << 8) | data[7];
+}
+
+void bme280CompensateInt(const BME280Calib &calib, const BME280Raw &raw,
+                         int32_t &tempCenti, uint32_t &presQ24_8, uint32_t &humQ22_10)
+{
+    // --- Temperatura (gera t_fine, usado pelos outros dois) ---
+    int32_t adcT = raw.adcT;
+    int32_t var1 = ((((adcT >> 3) - ((int32_t)calib.T1 << 1))) * ((int32_t)calib.T2)) >> 11;
+    int32_t var2 = (((((adcT >> 4) - ((int32_t)calib.T1)) * ((adcT >> 4) - ((int32_t)calib.T1))) >> 12) *
+                    ((int32_t)calib.T3)) >>
+                   14;
+    int32_t tFine = var1 + var2;
+    tempCenti = (tFine * 5 + 128) >> 8;
+
+    // --- Pressão (64 bits) ---
+    int64_t p1 = ((int64_t)tFine) - 128000;
+    int64_t p2 = p1 * p1 * (int64_t)calib.P6;
+    p2 = p2 + ((p1 * (int64_t)calib.P5) << 17);
+    p2 = p2 + (((int64_t)calib.P4) << 35);
+    p1 = ((p1 * p1 * (int64_t)calib.P3) >> 8) + ((p1 * (int64_t)calib.P2) << 12);
+    p1 = (((((int64_t)1) << 47) + p1)) * ((int64_t)calib.P1) >> 33;
+    if (p1 == 0)
+    {
+        presQ24_8 = 0; // Evita divisão por zero
+    }
+    else
+    {
+        int64_t p = 1048576 - raw.adcP;
+        p = (((p << 31) - p2) * 3125) / p1;
+        p1 = (((int64_t)calib.P9) * (p >> 13) * (p >> 13)) >> 25;
+        p2 = (((int64_t)calib.P8) * p) >> 19;
+        p = ((p + p1 + p2) >> 8) + (((int64_t)calib.P7) << 4);
+        presQ24_8 = (uint32_t)p;
+    }
+
+    // --- Umidade ---
+    int32_t h = tFine - ((int32_t)76800);
+    h = (((((raw.adcH << 14) - (((int32_t)calib.H4) << 20) - (((int32_t)calib.H5) * h)) + ((int32_t)16384)) >> 15) *
+         (((((((h * ((int32_t)calib.H6)) >> 10) * (((h * ((int32_t)calib.H3)) >> 11) + ((int32_t)32768))) >> 10) +
+            ((int32_t)2097152)) *
+               ((int32_t)calib.H2) +
+           8192) >>
+          14));
+    h = (h - (((((h >> 15) * (h >> 15)) >> 7) * ((int32_t)calib.H1)) >> 4));
+    h = (h < 0) ? 0 : h;
+    h = (h > 419430400) ? 419430400 : h;
+    humQ22_10 = (uint32_t)(h >> 12);
+}
+
+void bme280Compensate(const BME280Calib &calib, const BME280Raw &raw, BME280Reading &out)
+{
+    int32_t t;
+    uint32_t p, h;
+    bme280CompensateInt(calib, raw, t, p, h);
+
+    out.temp = t / 100.0f;
+    out.pres = (p / 256.0f) / 100.0f;
+    out.hum = h / 1024.0f;
+}
@@ -0,0 +1,78 @@
+#ifndef BME280COMPENSATION_H
+#define BME280COMPENSATION_H
+
+#include <stdint.h>
+
+/**
+ * @brief Coeficientes de calibração gravados de fábrica no BME280
+ */
+struct BME280Calib
+{
+    uint16_t T1;
+    int16_t T2, T3;
+    uint16_t P1;
+    int16_t P2, P3, P4, P5, P6, P7, P8, P9;
+    uint8_t H1;
+    int16_t H2;
+    uint8_t H3;
+    int16_t H4, H5;
+    int8_t H6;
+};
+
+/**
+ * @brief Leituras brutas (ADC) de uma única rajada 0xF7..0xFE
+ */
+struct BME280Raw
+{
+    int32_t adcT;
+    int32_t adcP;
+    int32_t adcH;
+};
+
+/**
+ * @brief Valores compensados
+ */
+struct BME280Reading
+{
+    float temp; // C
+    float pres; // hPa
+    float hum;  // %RH
+};
+
+// Endereços e tamanhos dos blocos lidos do sensor
+#define BME280_CALIB1_REG 0x88
+#define BME280_CALIB1_LEN 26 // 0x88..0xA1
+#define BME280_CALIB2_REG 0xE1
+#define BME280_CALIB2_LEN 7 // 0xE1..0xE7
+#define BME280_DATA_REG 0xF7
+#define BME280_DATA_LEN 8 // press[3], temp[3], hum[2]
+
+/**
+ * @brief Decodifica os dois blocos de calibração
+ */
+void bme280ParseCalib(const uint8_t block1[BME280_CALIB1_LEN], const uint8_t block2[BME280_CALIB2_LEN], BME280Calib &calib);
+
+/**
+ * @brief Decodifica a rajada de dados brutos (0xF7..0xFE)
+ */
+void bme280ParseRaw(const uint8_t data[BME280_DATA_LEN], BME280Raw &raw);
+
+/**
+ * @brief Compensa temperatura, pressão e umidade de uma só vez
+ *
+ * Usa as fórmulas inteiras do datasheet (seção 4.2.3). O t_fine é
+ * calculado uma única vez e reaproveitado por pressão e umidade.
+ *
+ * @param tempCenti Temperatura em 0.01 C
+ * @param presQ24_8 Pressão em Pa, formato Q24.8
+ * @param humQ22_10 Umidade em %RH, formato Q22.10
+ */
+void bme280CompensateInt(const BME280Calib &calib, const BME280Raw &raw,
+                         int32_t &tempCenti, uint32_t &presQ24_8, uint32_t &humQ22_10);
+
+/**
+ * @brief Mesma compensação, convertida para C / hPa / %RH
+ */
+void bme280Compensate(const BME280Calib &calib, const BME280Raw &raw, BME280Reading &out);
+
+#endif
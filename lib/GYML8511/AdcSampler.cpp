@@ -0,0 +1,67 @@
+#include "AdcSampler.h"
+
+AdcSampler::AdcSampler(AdcSource &source, uint8_t pin, uint8_t samples, uint32_t intervalUs)
+{
+    _source = &source;
+    _pin = pin;
+    if (samples < 1)
+        samples = 1;
+    if (samples > MAX_SAMPLES)
+        samples = MAX_SAMPLES;
+    _size = samples;
+    _intervalUs = intervalUs;
+
+    _head = 0;
+    _count = 0;
+    _sum = 0;
+    _nextUs = 0;
+    _running = false;
+}
+
+void AdcSampler::start(uint32_t nowUs)
+{
+    _head = 0;
+    _count = 0;
+    _sum = 0;
+    _nextUs = nowUs;
+    _running = true;
+}
+
+void AdcSampler::stop()
+{
+    _running = false;
+}
+
+bool AdcSampler::poll(uint32_t nowUs)
+{
+    if (!_running)
+        return false;
+
+    // Comparação com sinal para sobreviver ao overflow do micros()
+    if ((int32_t)(nowUs - _nextUs) < 0)
+        return false;
+
+    _nextUs = nowUs + _intervalUs;
+    push(_source->read(_pin));
+    return true;
+}
+
+void AdcSampler::push(int raw)
+{
+    // Janela cheia: a amostra mais antiga sai da soma
+    if (_count >= _size)
+        _sum -= _ring[_head];
+    else
+        _count++;
+
+    _ring[_head] = raw;
+    _sum += raw;
+    _head = (_head + 1) % _size;
+}
+
+int AdcSampler::average() const
+{
+    if (_count == 0)
+        return 0;
+    return _sum / _count;
+}
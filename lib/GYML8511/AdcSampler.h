@@ -0,0 +1,77 @@
+#ifndef ADCSAMPLER_H
+#define ADCSAMPLER_H
+
+#include <stdint.h>
+#include "AdcSource.h"
+
+/**
+ * @brief Amostragem ADC não-bloqueante com buffer circular
+ *
+ * Em vez de fazer N leituras seguidas com delay, cada chamada de poll()
+ * coleta no máximo uma amostra quando o intervalo configurado venceu.
+ * A média é mantida por uma soma corrente sobre a janela (média móvel).
+ */
+class AdcSampler
+{
+public:
+    static const uint8_t MAX_SAMPLES = 32;
+
+    /**
+     * @param source Fonte das leituras (real ou simulada)
+     * @param pin Pino ADC a ser amostrado
+     * @param samples Tamanho da janela de média (1 a MAX_SAMPLES)
+     * @param intervalUs Intervalo mínimo entre amostras em microssegundos
+     */
+    AdcSampler(AdcSource &source, uint8_t pin, uint8_t samples = MAX_SAMPLES, uint32_t intervalUs = 500);
+
+    /**
+     * @brief Zera a janela e inicia a coleta
+     * @param nowUs Tempo atual em microssegundos
+     */
+    void start(uint32_t nowUs);
+
+    /**
+     * @brief Interrompe a coleta (a última média continua disponível)
+     */
+    void stop();
+
+    /**
+     * @brief Coleta uma amostra se o intervalo venceu. Nunca bloqueia.
+     * @param nowUs Tempo atual em microssegundos
+     * @return true se uma amostra foi coletada nesta chamada
+     */
+    bool poll(uint32_t nowUs);
+
+    /**
+     * @brief Insere uma leitura já feita por outro componente
+     */
+    void push(int raw);
+
+    /**
+     * @brief Indica se a janela já foi preenchida desde o start()
+     */
+    bool ready() const { return _count >= _size; }
+
+    bool running() const { return _running; }
+
+    /**
+     * @brief Média das amostras na janela (0 se vazia)
+     */
+    int average() const;
+
+private:
+    AdcSource *_source;
+    uint8_t _pin;
+    uint8_t _size;
+    uint32_t _intervalUs;
+
+    int _ring[MAX_SAMPLES];
+    uint8_t _head;
+    uint8_t _count;
+    long _sum;
+
+    uint32_t _nextUs;
+    bool _running;
+};
+
+#endif
@@ -1,59 +1,92 @@
 #include "GYML8511.h"
+#include "SensorCurves.h"
+
+// Quantidade de amostras da média (leitura bloqueante e buffer circular)
+static const int SAMPLES = 32;
 
 GYML8511::GYML8511(uint8_t pinOut, float vRef)
+    : _adc(&Hal::adc()), _sampler(Hal::adc(), pinOut, SAMPLES)
+{
+    _pinOut = pinOut;
+    _cal.setLinear((uint16_t)(vRef * 1000));
+}
+
+GYML8511::GYML8511(AdcSource &source, uint8_t pinOut, float vRef)
+    : _adc(&source), _sampler(source, pinOut, SAMPLES)
 {
     _pinOut = pinOut;
-    _vRef = vRef;
-    _adcResolution = 4095; // 12-bit
+    _cal.setLinear((uint16_t)(vRef * 1000));
 }
 
 void GYML8511::begin()
 {
     // Configura o pino apenas como entrada
-    pinMode(_pinOut, INPUT);
+    Hal::gpio().pinMode(_pinOut, HAL_INPUT);
 
     // Configura atenuação para ler a faixa completa de 0 a ~3.3V
     // Sem isso, o ESP32 satura em ~1.1V
     // analogSetPinAttenuation(_pinOut, ADC_ATTEN_DB_11);
 }
 
-float GYML8511::adcToVoltage(int adcValue)
+int32_t GYML8511::rawToMicroWatts(int adcValue) const
 {
-    return (adcValue * _vRef) / _adcResolution;
+    // Curva do datasheet (0.99 V -> 0, 2.80 V -> 15 mW/cm^2), limitada em 0
+    // abaixo do ponto de escuro (ruído em ambiente escuro)
+    return calInterpolate(GYML8511_UV_CURVE, _cal.rawToMv((uint16_t)adcValue));
 }
 
 float GYML8511::readVoltage()
 {
     long total = 0;
-    // Aumentei ligeiramente as amostras para maior estabilidade
-    const int SAMPLES = 32;
 
     for (int i = 0; i < SAMPLES; i++)
     {
-        total += analogRead(_pinOut);
-        delayMicroseconds(500); // Pequeno delay entre leituras
+        total += _adc->read(_pinOut);
+        Hal::clock().delayUs(500); // Pequeno delay entre leituras
     }
 
     int averageAdc = total / SAMPLES;
-    return adcToVoltage(averageAdc);
+    return _cal.rawToMv((uint16_t)averageAdc) / 1000.0f;
 }
 
 float GYML8511::readUVIntensity()
 {
-    float voltage = readVoltage();
+    int32_t mv = (int32_t)(readVoltage() * 1000.0f + 0.5f);
+    return calInterpolate(GYML8511_UV_CURVE, mv) / 1000.0f;
+}
+
+void GYML8511::startSampling(uint32_t intervalUs)
+{
+    _sampler = AdcSampler(*_adc, _pinOut, SAMPLES, intervalUs);
+    _sampler.start(Hal::clock().micros());
+}
+
+bool GYML8511::poll()
+{
+    return _sampler.poll(Hal::clock().micros());
+}
 
-    // Mapeamento linear conforme datasheet:
-    // 0.99V (output em dark) -> 0 mW/cm^2
-    // 2.80V (output máximo)  -> 15 mW/cm^2
+void GYML8511::pushSample(int raw)
+{
+    _sampler.push(raw);
+}
 
-    // Equação da reta: Y = m * (X - X_min) + Y_min
-    // Onde m = (Y_max - Y_min) / (X_max - X_min)
+bool GYML8511::isReady() const
+{
+    return _sampler.ready();
+}
 
-    float intensity = (voltage - 0.99) * (15.0 / (2.8 - 0.99));
+float GYML8511::getVoltage() const
+{
+    return _cal.rawToMv((uint16_t)_sampler.average()) / 1000.0f;
+}
 
-    // Proteção contra valores negativos (ruído em ambiente escuro)
-    if (intensity < 0.0)
-        return 0.0;
+float GYML8511::getUVIntensity() const
+{
+    return getUVMicroWatts() / 1000.0f;
+}
 
-    return intensity;
-}
\ No newline at end of file
+int32_t GYML8511::getUVMicroWatts() const
+{
+    return rawToMicroWatts(_sampler.average());
+}
@@ -1,42 +1,103 @@
 #ifndef GYML8511_H
 #define GYML8511_H
 
-#include <Arduino.h>
+#include "Hal.h"
+#include "AdcSampler.h"
+#include "AnalogCalibration.h"
 
 class GYML8511
 {
 private:
-    uint8_t _pinOut;    // Pino de leitura analógica
-    float _vRef;        // Tensão de referência do ESP32
-    int _adcResolution; // Resolução do ADC
+    uint8_t _pinOut;      // Pino de leitura analógica
+    AdcCalibration _cal; // Contagens -> mV (tabela; padrão: reta até vRef)
 
-    // Helper: Converte leitura bruta ADC -> Tensão
-    float adcToVoltage(int adcValue);
+    // Fonte ADC e amostragem em segundo plano
+    AdcSource *_adc;
+    AdcSampler _sampler;
+
+    // Helper: Converte leitura bruta ADC -> Intensidade UV (µW/cm^2), só inteiros
+    int32_t rawToMicroWatts(int adcValue) const;
 
 public:
     /**
-     * @brief Construtor da classe GYML8511 simplificada
+     * @brief Construtor da classe GYML8511 simplificada (usa o ADC do Hal)
      * @param pinOut Pino ADC (GPIO) conectado ao OUT do sensor
-     * @param vRef Tensão de referência do sistema (Padrão 3.3V)
+     * @param vRef Fundo de escala da conversão linear usada até setCalibration() (Padrão 3.3V)
      */
     GYML8511(uint8_t pinOut, float vRef = 3.3);
 
+    /**
+     * @brief Construtor com fonte ADC externa (ex: FakeAdcSource)
+     * @param source Fonte das leituras ADC
+     * @param pinOut Pino ADC (GPIO) conectado ao OUT do sensor
+     * @param vRef Fundo de escala da conversão linear usada até setCalibration() (Padrão 3.3V)
+     */
+    GYML8511(AdcSource &source, uint8_t pinOut, float vRef = 3.3);
+
     /**
      * @brief Configura o pino ADC e a atenuação necessária
      */
     void begin();
 
+    /**
+     * @brief Substitui a conversão linear por uma calibração do ADC (eFuse/típica)
+     */
+    void setCalibration(const AdcCalibration &cal) { _cal = cal; }
+
     /**
      * @brief Lê a tensão média (multisampling)
+     * @note Bloqueia por ~16ms. Prefira startSampling()/poll() no loop principal.
      * @return Tensão em Volts
      */
     float readVoltage();
 
     /**
      * @brief Calcula a intensidade UV baseada na tensão lida
+     * @note Bloqueante, usa readVoltage()
      * @return Intensidade em mW/cm^2
      */
     float readUVIntensity();
+
+    /**
+     * @brief Inicia a amostragem não-bloqueante em buffer circular
+     * @param intervalUs Intervalo entre amostras em microssegundos
+     */
+    void startSampling(uint32_t intervalUs = 500);
+
+    /**
+     * @brief Coleta no máximo uma amostra. Deve ser chamado a cada volta do loop.
+     * @return true se uma amostra foi coletada
+     */
+    bool poll();
+
+    /**
+     * @brief Insere no buffer uma leitura feita por outro componente
+     * @note Usado quando o pino é lido pelo serviço de aquisição (AnalogAcquisition)
+     */
+    void pushSample(int raw);
+
+    /**
+     * @brief Indica se o buffer já tem amostras suficientes para a média
+     */
+    bool isReady() const;
+
+    /**
+     * @brief Tensão média do buffer, sem bloquear
+     * @return Tensão em Volts
+     */
+    float getVoltage() const;
+
+    /**
+     * @brief Intensidade UV a partir do buffer, sem bloquear
+     * @return Intensidade em mW/cm^2
+     */
+    float getUVIntensity() const;
+
+    /**
+     * @brief Intensidade UV a partir do buffer em ponto fixo
+     * @return Intensidade em µW/cm^2 (0.001 mW/cm^2)
+     */
+    int32_t getUVMicroWatts() const;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,26 @@
+#ifndef ADCSOURCE_H
+#define ADCSOURCE_H
+
+#include <stdint.h>
+
+/**
+ * @brief Fonte de leituras ADC desacoplada do hardware
+ *
+ * Permite trocar o analogRead() real por uma fonte simulada,
+ * de forma que a média do sensor possa ser testada fora do ESP32.
+ * Implementações: ArduinoAdcSource (HalEsp32.h) e FakeAdcSource (HalFake.h).
+ */
+class AdcSource
+{
+public:
+    virtual ~AdcSource() {}
+
+    /**
+     * @brief Lê o valor bruto do ADC
+     * @param pin Pino (GPIO) a ser lido
+     * @return Valor bruto (0 a 4095 no ESP32)
+     */
+    virtual int read(uint8_t pin) = 0;
+};
+
+#endif
@@ -0,0 +1,61 @@
+#include "Hal.h"
+
+#ifdef ARDUINO
+#include "HalEsp32.h"
+
+static ArduinoAdcSource defaultAdc;
+static Esp32Clock defaultClock;
+static Esp32Gpio defaultGpio;
+static Esp32I2C defaultI2C;
+#ifdef HAL_HAS_ESP32_SERVO
+static Esp32ServoPort defaultServos[Hal::MAX_SERVOS];
+#else
+#include "HalFake.h"
+static FakeServo defaultServos[Hal::MAX_SERVOS]; // Env sem ESP32Servo: servos inertes
+#endif
+
+#else
+#include "HalFake.h"
+
+static FakeAdcSource defaultAdc;
+static FakeClock defaultClock;
+static FakeGpio defaultGpio;
+static FakeI2C defaultI2C;
+static FakeServo defaultServos[Hal::MAX_SERVOS];
+#endif
+
+static HalClock *currentClock = &defaultClock;
+static HalGpio *currentGpio = &defaultGpio;
+static AdcSource *currentAdc = &defaultAdc;
+static HalI2C *currentI2C = &defaultI2C;
+static HalServo *currentServos[Hal::MAX_SERVOS] = {&defaultServos[0], &defaultServos[1], &defaultServos[2], &defaultServos[3]};
+
+HalClock &Hal::clock() { return *currentClock; }
+HalGpio &Hal::gpio() { return *currentGpio; }
+AdcSource &Hal::adc() { return *currentAdc; }
+HalI2C &Hal::i2c() { return *currentI2C; }
+
+HalServo &Hal::servo(uint8_t index)
+{
+    if (index >= MAX_SERVOS)
+        index = MAX_SERVOS - 1;
+    return *currentServos[index];
+}
+
+void Hal::install(HalClock *clock, HalGpio *gpio, AdcSource *adc, HalI2C *i2c)
+{
+    if (clock)
+        currentClock = clock;
+    if (gpio)
+        currentGpio = gpio;
+    if (adc)
+        currentAdc = adc;
+    if (i2c)
+        currentI2C = i2c;
+}
+
+void Hal::installServo(uint8_t index, HalServo *servo)
+{
+    if (index < MAX_SERVOS && servo)
+        currentServos[index] = servo;
+}
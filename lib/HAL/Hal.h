@@ -0,0 +1,128 @@
+#ifndef HAL_H
+#define HAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "AdcSource.h"
+
+// Modos de pino (mesmos valores do core Arduino-ESP32)
+#define HAL_INPUT 0x01
+#define HAL_OUTPUT 0x03
+
+/**
+ * @brief Tempo: relógio, atrasos e contador de ciclos
+ */
+class HalClock
+{
+public:
+    virtual ~HalClock() {}
+    virtual uint32_t millis() = 0;
+    virtual uint32_t micros() = 0;
+    virtual void delayMs(uint32_t ms) = 0;
+    virtual void delayUs(uint32_t us) = 0;
+
+    /**
+     * @brief Contador de ciclos da CPU (para medir trechos curtos)
+     */
+    virtual uint32_t cycles() = 0;
+
+    /**
+     * @brief Frequência do contador de ciclos em MHz
+     */
+    virtual uint32_t cyclesPerUs() = 0;
+};
+
+/**
+ * @brief GPIO digital e PWM simples (buzzer)
+ */
+class HalGpio
+{
+public:
+    virtual ~HalGpio() {}
+    virtual void pinMode(uint8_t pin, uint8_t mode) = 0;
+    virtual void write(uint8_t pin, bool high) = 0;
+    virtual void tone(uint8_t pin, uint32_t frequency) = 0;
+    virtual void noTone(uint8_t pin) = 0;
+};
+
+/**
+ * @brief Saída de servo (PWM 50 Hz)
+ */
+class HalServo
+{
+public:
+    virtual ~HalServo() {}
+    virtual bool attach(uint8_t pin, uint16_t minUs, uint16_t maxUs) = 0;
+    virtual void detach() = 0;
+    virtual bool attached() = 0;
+    virtual void write(int angle) = 0;
+};
+
+/**
+ * @brief Barramento I2C (mestre)
+ */
+class HalI2C
+{
+public:
+    virtual ~HalI2C() {}
+
+    /**
+     * @brief Transmite 'len' bytes para o dispositivo
+     * @param stop false mantém o barramento (repeated start)
+     * @return true se o dispositivo confirmou (ACK)
+     */
+    virtual bool write(uint8_t address, const uint8_t *data, size_t len, bool stop = true) = 0;
+
+    /**
+     * @brief Lê 'len' bytes do dispositivo
+     * @return true se todos os bytes foram recebidos
+     */
+    virtual bool read(uint8_t address, uint8_t *data, size_t len) = 0;
+
+    /**
+     * @brief Escreve o endereço do registrador e lê 'len' bytes a partir dele
+     */
+    bool readRegs(uint8_t address, uint8_t reg, uint8_t *data, size_t len)
+    {
+        return write(address, &reg, 1, false) && read(address, data, len);
+    }
+
+    /**
+     * @brief Escreve um registrador de 8 bits
+     */
+    bool writeReg(uint8_t address, uint8_t reg, uint8_t value)
+    {
+        uint8_t buf[2] = {reg, value};
+        return write(address, buf, 2);
+    }
+};
+
+/**
+ * @brief Ponto de acesso ao backend de hardware ativo
+ *
+ * No ESP32 o padrão é o backend real (HalEsp32.h); no host, o simulado
+ * (HalFake.h). install() permite trocar qualquer parte (ex: testes).
+ */
+class Hal
+{
+public:
+    static const uint8_t MAX_SERVOS = 4;
+
+    static HalClock &clock();
+    static HalGpio &gpio();
+    static AdcSource &adc();
+    static HalI2C &i2c();
+
+    /**
+     * @brief Servo do conjunto fixo do backend (0 a MAX_SERVOS-1)
+     */
+    static HalServo &servo(uint8_t index);
+
+    /**
+     * @brief Substitui partes do backend (nullptr mantém a atual)
+     */
+    static void install(HalClock *clock, HalGpio *gpio, AdcSource *adc, HalI2C *i2c);
+    static void installServo(uint8_t index, HalServo *servo);
+};
+
+#endif
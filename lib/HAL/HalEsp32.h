@@ -0,0 +1,88 @@
+#ifndef HALESP32_H
+#define HALESP32_H
+
+#include "Hal.h"
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <Wire.h>
+
+/**
+ * @brief Fonte ADC real, usa analogRead()
+ */
+class ArduinoAdcSource : public AdcSource
+{
+public:
+    int read(uint8_t pin) override { return analogRead(pin); }
+};
+
+class Esp32Clock : public HalClock
+{
+public:
+    uint32_t millis() override { return ::millis(); }
+    uint32_t micros() override { return ::micros(); }
+    void delayMs(uint32_t ms) override { ::delay(ms); }
+    void delayUs(uint32_t us) override { ::delayMicroseconds(us); }
+    uint32_t cycles() override { return ESP.getCycleCount(); }
+    uint32_t cyclesPerUs() override { return ESP.getCpuFreqMHz(); }
+};
+
+class Esp32Gpio : public HalGpio
+{
+public:
+    void pinMode(uint8_t pin, uint8_t mode) override { ::pinMode(pin, mode); }
+    void write(uint8_t pin, bool high) override { ::digitalWrite(pin, high ? HIGH : LOW); }
+    void tone(uint8_t pin, uint32_t frequency) override { ::tone(pin, frequency); }
+    void noTone(uint8_t pin) override { ::noTone(pin); }
+};
+
+class Esp32I2C : public HalI2C
+{
+private:
+    TwoWire *_wire;
+
+public:
+    Esp32I2C(TwoWire &wire = Wire) : _wire(&wire) {}
+
+    bool write(uint8_t address, const uint8_t *data, size_t len, bool stop = true) override
+    {
+        _wire->beginTransmission(address);
+        _wire->write(data, len);
+        return _wire->endTransmission(stop) == 0;
+    }
+
+    bool read(uint8_t address, uint8_t *data, size_t len) override
+    {
+        if (_wire->requestFrom(address, (uint8_t)len) != len)
+            return false;
+        for (size_t i = 0; i < len; i++)
+            data[i] = _wire->read();
+        return true;
+    }
+};
+
+// O backend de servo só existe quando a ESP32Servo está nas dependências do env
+#if __has_include(<ESP32Servo.h>)
+#include <ESP32Servo.h>
+#define HAL_HAS_ESP32_SERVO 1
+
+class Esp32ServoPort : public HalServo
+{
+private:
+    Servo _servo;
+
+public:
+    bool attach(uint8_t pin, uint16_t minUs, uint16_t maxUs) override
+    {
+        _servo.setPeriodHertz(50);
+        return _servo.attach(pin, minUs, maxUs) != 0;
+    }
+    void detach() override { _servo.detach(); }
+    bool attached() override { return _servo.attached(); }
+    void write(int angle) override { _servo.write(angle); }
+};
+#endif
+
+#endif // ARDUINO
+
+#endif
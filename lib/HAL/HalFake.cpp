@@ -0,0 +1,169 @@
+#include "HalFake.h"
+
+#ifndef ARDUINO
+#include <chrono>
+#include <thread>
+#endif
+
+// --- FakeAdcSource ---
+
+FakeAdcSource::FakeAdcSource()
+{
+    for (uint8_t i = 0; i < MAX_PINS; i++)
+    {
+        _values[i] = 0;
+        _seq[i] = nullptr;
+        _seqLen[i] = 0;
+        _seqPos[i] = 0;
+    }
+    _reads = 0;
+}
+
+void FakeAdcSource::setValue(uint8_t pin, int value)
+{
+    if (pin >= MAX_PINS)
+        return;
+    _values[pin] = value;
+    _seq[pin] = nullptr;
+}
+
+void FakeAdcSource::setSequence(uint8_t pin, const int *values, uint16_t length)
+{
+    if (pin >= MAX_PINS)
+        return;
+    _seq[pin] = values;
+    _seqLen[pin] = length;
+    _seqPos[pin] = 0;
+}
+
+int FakeAdcSource::read(uint8_t pin)
+{
+    _reads++;
+    if (pin >= MAX_PINS)
+        return 0;
+
+    if (_seq[pin] != nullptr && _seqLen[pin] > 0)
+    {
+        int value = _seq[pin][_seqPos[pin]];
+        _seqPos[pin] = (_seqPos[pin] + 1) % _seqLen[pin];
+        return value;
+    }
+    return _values[pin];
+}
+
+// --- HostClock ---
+
+#ifndef ARDUINO
+static uint64_t hostNowNs()
+{
+    using namespace std::chrono;
+    static const steady_clock::time_point start = steady_clock::now();
+    return duration_cast<nanoseconds>(steady_clock::now() - start).count();
+}
+
+uint32_t HostClock::millis() { return (uint32_t)(hostNowNs() / 1000000); }
+uint32_t HostClock::micros() { return (uint32_t)(hostNowNs() / 1000); }
+void HostClock::delayMs(uint32_t ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+void HostClock::delayUs(uint32_t us) { std::this_thread::sleep_for(std::chrono::microseconds(us)); }
+uint32_t HostClock::cycles() { return (uint32_t)hostNowNs(); }
+#endif
+
+// --- FakeGpio ---
+
+FakeGpio::FakeGpio()
+{
+    for (uint8_t i = 0; i < MAX_PINS; i++)
+    {
+        _mode[i] = 0;
+        _level[i] = false;
+        _tone[i] = 0;
+    }
+    _writes = 0;
+}
+
+void FakeGpio::pinMode(uint8_t pin, uint8_t mode)
+{
+    if (pin < MAX_PINS)
+        _mode[pin] = mode;
+}
+
+void FakeGpio::write(uint8_t pin, bool high)
+{
+    _writes++;
+    if (pin < MAX_PINS)
+        _level[pin] = high;
+}
+
+void FakeGpio::tone(uint8_t pin, uint32_t frequency)
+{
+    if (pin < MAX_PINS)
+        _tone[pin] = frequency;
+}
+
+void FakeGpio::noTone(uint8_t pin)
+{
+    if (pin < MAX_PINS)
+        _tone[pin] = 0;
+}
+
+// --- FakeI2CDevice ---
+
+void FakeI2CDevice::onWrite(const uint8_t *data, size_t len)
+{
+    if (len == 0)
+        return;
+    _pointer = data[0];
+    for (size_t i = 1; i < len; i++)
+        regs[_pointer++] = data[i];
+}
+
+void FakeI2CDevice::onRead(uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+        data[i] = regs[_pointer++];
+}
+
+// --- FakeI2C ---
+
+FakeI2C::FakeI2C()
+{
+    _count = 0;
+    _bytes = 0;
+    _transactions = 0;
+}
+
+void FakeI2C::attachDevice(FakeI2CDevice *device)
+{
+    if (_count < MAX_DEVICES)
+        _devices[_count++] = device;
+}
+
+FakeI2CDevice *FakeI2C::find(uint8_t address)
+{
+    for (uint8_t i = 0; i < _count; i++)
+        if (_devices[i]->address() == address)
+            return _devices[i];
+    return nullptr;
+}
+
+bool FakeI2C::write(uint8_t address, const uint8_t *data, size_t len, bool)
+{
+    _transactions++;
+    _bytes += len + 1; // + byte de endereço
+    FakeI2CDevice *dev = find(address);
+    if (dev == nullptr)
+        return false;
+    dev->onWrite(data, len);
+    return true;
+}
+
+bool FakeI2C::read(uint8_t address, uint8_t *data, size_t len)
+{
+    _transactions++;
+    _bytes += len + 1;
+    FakeI2CDevice *dev = find(address);
+    if (dev == nullptr)
+        return false;
+    dev->onRead(data, len);
+    return true;
+}
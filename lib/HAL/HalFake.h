@@ -0,0 +1,193 @@
+#ifndef HALFAKE_H
+#define HALFAKE_H
+
+#include "Hal.h"
+
+/**
+ * @brief Fonte ADC simulada para testes no host (Linux)
+ *
+ * Cada pino devolve o valor configurado em setValue(). Se uma sequência
+ * for fornecida, as leituras percorrem a sequência de forma circular.
+ */
+class FakeAdcSource : public AdcSource
+{
+public:
+    static const uint8_t MAX_PINS = 40;
+
+    FakeAdcSource();
+
+    void setValue(uint8_t pin, int value);
+    void setSequence(uint8_t pin, const int *values, uint16_t length);
+
+    int read(uint8_t pin) override;
+
+    /**
+     * @brief Quantidade total de leituras feitas (todas as portas)
+     */
+    uint32_t readCount() const { return _reads; }
+
+private:
+    int _values[MAX_PINS];
+    const int *_seq[MAX_PINS];
+    uint16_t _seqLen[MAX_PINS];
+    uint16_t _seqPos[MAX_PINS];
+    uint32_t _reads;
+};
+
+/**
+ * @brief Relógio simulado: só anda quando mandado (advance/delay)
+ */
+class FakeClock : public HalClock
+{
+public:
+    FakeClock() : _us(0) {}
+
+    uint32_t millis() override { return (uint32_t)(_us / 1000); }
+    uint32_t micros() override { return (uint32_t)_us; }
+    void delayMs(uint32_t ms) override { _us += (uint64_t)ms * 1000; }
+    void delayUs(uint32_t us) override { _us += us; }
+    uint32_t cycles() override { return (uint32_t)(_us * 240); }
+    uint32_t cyclesPerUs() override { return 240; }
+
+    void advanceUs(uint64_t us) { _us += us; }
+    void advanceMs(uint64_t ms) { _us += ms * 1000; }
+    void set(uint64_t us) { _us = us; }
+    uint64_t nowUs() const { return _us; }
+
+private:
+    uint64_t _us;
+};
+
+/**
+ * @brief Relógio real do host (steady_clock), para medições de desempenho
+ */
+class HostClock : public HalClock
+{
+public:
+    uint32_t millis() override;
+    uint32_t micros() override;
+    void delayMs(uint32_t ms) override;
+    void delayUs(uint32_t us) override;
+    uint32_t cycles() override;
+    uint32_t cyclesPerUs() override { return 1000; } // ns
+};
+
+/**
+ * @brief GPIO simulado: guarda o último estado de cada pino
+ */
+class FakeGpio : public HalGpio
+{
+public:
+    static const uint8_t MAX_PINS = 40;
+
+    FakeGpio();
+
+    void pinMode(uint8_t pin, uint8_t mode) override;
+    void write(uint8_t pin, bool high) override;
+    void tone(uint8_t pin, uint32_t frequency) override;
+    void noTone(uint8_t pin) override;
+
+    bool level(uint8_t pin) const { return pin < MAX_PINS && _level[pin]; }
+    uint32_t toneFrequency(uint8_t pin) const { return pin < MAX_PINS ? _tone[pin] : 0; }
+    uint32_t writeCount() const { return _writes; }
+
+private:
+    uint8_t _mode[MAX_PINS];
+    bool _level[MAX_PINS];
+    uint32_t _tone[MAX_PINS];
+    uint32_t _writes;
+};
+
+/**
+ * @brief Servo simulado: guarda ângulo, estado e contagem de escritas
+ */
+class FakeServo : public HalServo
+{
+public:
+    FakeServo() : _pin(0), _attached(false), _angle(0), _writes(0) {}
+
+    bool attach(uint8_t pin, uint16_t, uint16_t) override
+    {
+        _pin = pin;
+        _attached = true;
+        return true;
+    }
+    void detach() override { _attached = false; }
+    bool attached() override { return _attached; }
+    void write(int angle) override
+    {
+        _angle = angle;
+        _writes++;
+    }
+
+    int angle() const { return _angle; }
+    uint32_t writeCount() const { return _writes; }
+
+private:
+    uint8_t _pin;
+    bool _attached;
+    int _angle;
+    uint32_t _writes;
+};
+
+/**
+ * @brief Dispositivo simulado no barramento I2C
+ *
+ * Implementa um mapa de registradores de 8 bits com ponteiro
+ * autoincrementado (como BME280 e a maioria dos sensores).
+ */
+class FakeI2CDevice
+{
+public:
+    FakeI2CDevice(uint8_t address) : _address(address), _pointer(0)
+    {
+        for (int i = 0; i < 256; i++)
+            regs[i] = 0;
+    }
+
+    uint8_t address() const { return _address; }
+
+    /**
+     * @brief Recebe uma transmissão (1º byte = registrador, demais = dados)
+     * Pode ser sobrescrito para dispositivos com protocolo próprio (ex: SSD1306).
+     */
+    virtual void onWrite(const uint8_t *data, size_t len);
+    virtual void onRead(uint8_t *data, size_t len);
+    virtual ~FakeI2CDevice() {}
+
+    uint8_t regs[256];
+
+protected:
+    uint8_t _address;
+    uint8_t _pointer;
+};
+
+/**
+ * @brief Barramento I2C simulado: encaminha para os dispositivos cadastrados
+ */
+class FakeI2C : public HalI2C
+{
+public:
+    static const uint8_t MAX_DEVICES = 4;
+
+    FakeI2C();
+
+    void attachDevice(FakeI2CDevice *device);
+
+    bool write(uint8_t address, const uint8_t *data, size_t len, bool stop = true) override;
+    bool read(uint8_t address, uint8_t *data, size_t len) override;
+
+    uint32_t bytesTransferred() const { return _bytes; }
+    uint32_t transactions() const { return _transactions; }
+    void resetCounters() { _bytes = _transactions = 0; }
+
+private:
+    FakeI2CDevice *_devices[MAX_DEVICES];
+    uint8_t _count;
+    uint32_t _bytes;
+    uint32_t _transactions;
+
+    FakeI2CDevice *find(uint8_t address);
+};
+
+#endif
@@ -0,0 +1,88 @@
+#include "HealthJsonStream.h"
+#include <string.h>
+#include "JsonWriter.h"
+
+HealthJsonStream::HealthJsonStream(const HealthSnapshot &snapshot)
+{
+    _snap = snapshot;
+    _next = 0;
+    _headerDone = false;
+    _done = false;
+}
+
+size_t HealthJsonStream::fill(uint8_t *buffer, size_t maxLen)
+{
+    size_t len = 0;
+    char item[320];
+
+    while (!_done)
+    {
+        JsonWriter w(item, sizeof(item));
+
+        if (!_headerDone)
+        {
+            w.beginObject();
+            w.key("warn");
+            w.beginArray();
+            for (uint8_t bit = HEALTH_WARN_FREE_HEAP; bit <= HEALTH_WARN_STACK; bit <<= 1)
+                if (_snap.warnings & bit)
+                    w.string(HealthMonitor::warningName(bit));
+            w.endArray();
+            w.field("events", _snap.warnEvents);
+            w.field("trend", _snap.freeHeapTrendPerHour);
+            w.key("limits");
+            w.beginObject();
+            w.field("free", _snap.thresholds.minFreeHeap);
+            w.field("block", _snap.thresholds.minLargestBlock);
+            w.field("stack", (uint32_t)_snap.thresholds.minStackFree);
+            w.endObject();
+            w.key("tasks");
+            w.beginArray();
+            for (uint8_t i = 0; i < _snap.taskCount; i++)
+                w.string(_snap.taskNames[i]);
+            w.endArray();
+            w.raw(",\"history\":[");
+        }
+        else if (_next < _snap.count)
+        {
+            uint16_t first = (_snap.head + HEALTH_HISTORY - _snap.count) % HEALTH_HISTORY;
+            const HealthReading &r = _snap.ring[(first + _next) % HEALTH_HISTORY];
+            if (_next > 0)
+                w.raw(",");
+            w.beginObject();
+            w.field("t", r.uptimeSec);
+            w.field("free", r.freeHeap);
+            w.field("block", r.largestBlock);
+            w.field("min", r.minFreeHeap);
+            w.field("frag", (uint32_t)HealthMonitor::fragmentation(r));
+            w.key("stack");
+            w.beginArray();
+            for (uint8_t i = 0; i < _snap.taskCount; i++)
+                w.uinteger(r.stackFree[i]);
+            w.endArray();
+            w.endObject();
+        }
+        else
+        {
+            w.raw("]}");
+        }
+
+        // Cada item vai inteiro ou fica para o próximo pedaço
+        if (len + w.length() > maxLen)
+            break;
+        memcpy(buffer + len, item, w.length());
+        len += w.length();
+
+        if (!_headerDone)
+            _headerDone = true;
+        else if (_next < _snap.count)
+            _next++;
+        else
+            _done = true;
+    }
+
+    // Nem o próximo item coube (janela TCP apertada): 0 encerraria a resposta
+    if (len == 0 && !_done)
+        return RESPONSE_TRY_AGAIN;
+    return len;
+}
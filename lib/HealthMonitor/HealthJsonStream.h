@@ -0,0 +1,40 @@
+#ifndef HEALTHJSONSTREAM_H
+#define HEALTHJSONSTREAM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "HealthMonitor.h"
+#include "JsonWriter.h" // RESPONSE_TRY_AGAIN
+
+/**
+ * @brief Gera o JSON de /health em pedaços, a partir de uma cópia do anel
+ *
+ * Mesmo contrato do HistoryJsonStream: cada fill() escreve itens inteiros
+ * até maxLen bytes. Formato (histórico da leitura mais antiga à mais nova):
+ * {"warn":["largest_block"],"events":1,"trend":-1200,
+ *  "limits":{"free":24576,"block":8192,"stack":512},"tasks":["tracker",...],
+ *  "history":[{"t":60,"free":151000,"block":110580,"min":148200,"frag":26,
+ *              "stack":[2100,1800,...]},...]}
+ * onde "trend" é a inclinação do heap livre em bytes/h e "stack" a menor
+ * folga de pilha de cada tarefa, na ordem de "tasks".
+ */
+class HealthJsonStream
+{
+public:
+    HealthJsonStream(const HealthSnapshot &snapshot);
+
+    /**
+     * @brief Escreve o próximo pedaço
+     * @return Bytes escritos; 0 quando terminou; RESPONSE_TRY_AGAIN se o
+     * próximo item não cabe em maxLen (a resposta continua)
+     */
+    size_t fill(uint8_t *buffer, size_t maxLen);
+
+private:
+    HealthSnapshot _snap;
+    uint16_t _next; // Próxima leitura do anel (0 = mais antiga)
+    bool _headerDone;
+    bool _done;
+};
+
+#endif
@@ -0,0 +1,155 @@
+#include "HealthMonitor.h"
+#include <string.h>
+
+HealthMonitor::HealthMonitor(const char *const *taskNames, uint8_t taskCount, const HealthThresholds &thresholds)
+{
+    memset(&_snap, 0, sizeof(_snap));
+    if (taskCount > HEALTH_MAX_TASKS)
+        taskCount = HEALTH_MAX_TASKS;
+    _snap.taskCount = taskCount;
+    for (uint8_t i = 0; i < taskCount; i++)
+        _snap.taskNames[i] = taskNames[i];
+    _snap.thresholds = thresholds;
+}
+
+const HealthReading &HealthMonitor::latest() const
+{
+    return _snap.ring[(_snap.head + HEALTH_HISTORY - 1) % HEALTH_HISTORY];
+}
+
+uint8_t HealthMonitor::fragmentation(const HealthReading &reading)
+{
+    if (reading.freeHeap == 0 || reading.largestBlock >= reading.freeHeap)
+        return 0;
+    return (uint8_t)(100 - (uint64_t)reading.largestBlock * 100 / reading.freeHeap);
+}
+
+uint8_t HealthMonitor::evaluate(const HealthReading &reading)
+{
+    const HealthThresholds &t = _snap.thresholds;
+    uint8_t warnings = 0;
+
+    // Aviso ligado só desliga 12,5% acima do limite: o heap oscila com cada
+    // conexão e o aviso não deve piscar em cima do limiar
+    uint32_t freeLimit = t.minFreeHeap;
+    uint32_t blockLimit = t.minLargestBlock;
+    if (_snap.warnings & HEALTH_WARN_FREE_HEAP)
+        freeLimit += freeLimit / 8;
+    if (_snap.warnings & HEALTH_WARN_LARGEST_BLOCK)
+        blockLimit += blockLimit / 8;
+    if (reading.freeHeap < freeLimit)
+        warnings |= HEALTH_WARN_FREE_HEAP;
+    if (reading.largestBlock < blockLimit)
+        warnings |= HEALTH_WARN_LARGEST_BLOCK;
+
+    _snap.stackWarned = 0;
+    for (uint8_t i = 0; i < _snap.taskCount; i++)
+        if (reading.stackFree[i] < t.minStackFree)
+            _snap.stackWarned |= 1 << i;
+    if (_snap.stackWarned)
+        warnings |= HEALTH_WARN_STACK;
+    return warnings;
+}
+
+void HealthMonitor::accumulateHour(const HealthReading &reading)
+{
+    uint32_t hour = reading.uptimeSec / 3600;
+    if (_snap.hourReadings > 0 && hour != _snap.hourIndex)
+    {
+        // Fecha a hora anterior no anel de médias
+        _snap.hourIndexes[_snap.hourHead] = _snap.hourIndex;
+        _snap.hourMeans[_snap.hourHead] = _snap.hourSum / _snap.hourReadings;
+        _snap.hourHead = (_snap.hourHead + 1) % HEALTH_TREND_HOURS;
+        if (_snap.hourCount < HEALTH_TREND_HOURS)
+            _snap.hourCount++;
+        _snap.hourReadings = 0;
+        _snap.hourSum = 0;
+    }
+    _snap.hourIndex = hour;
+    _snap.hourSum += reading.freeHeap;
+    _snap.hourReadings++;
+}
+
+int32_t HealthMonitor::hourlyTrend() const
+{
+    // Mínimos quadrados das médias horárias contra a hora (relativas à mais antiga)
+    uint16_t first = (_snap.hourHead + HEALTH_TREND_HOURS - _snap.hourCount) % HEALTH_TREND_HOURS;
+    uint32_t h0 = _snap.hourIndexes[first];
+    double m0 = _snap.hourMeans[first];
+    double sx = 0, sy = 0, sxx = 0, sxy = 0;
+    for (uint16_t k = 0; k < _snap.hourCount; k++)
+    {
+        uint16_t i = (first + k) % HEALTH_TREND_HOURS;
+        double x = (double)(_snap.hourIndexes[i] - h0);
+        double y = (double)_snap.hourMeans[i] - m0;
+        sx += x;
+        sy += y;
+        sxx += x * x;
+        sxy += x * y;
+    }
+    double n = _snap.hourCount;
+    double den = n * sxx - sx * sx;
+    if (den <= 0)
+        return 0;
+    return (int32_t)((n * sxy - sx * sy) / den);
+}
+
+int32_t HealthMonitor::trendPerHour() const
+{
+    if (_snap.hourCount >= 3)
+        return hourlyTrend();
+
+    // Primeiras horas: mínimos quadrados do anel (relativos à leitura mais antiga)
+    if (_snap.count < 3)
+        return 0;
+    uint16_t first = (_snap.head + HEALTH_HISTORY - _snap.count) % HEALTH_HISTORY;
+    const HealthReading &r0 = _snap.ring[first];
+    double sx = 0, sy = 0, sxx = 0, sxy = 0;
+    for (uint16_t k = 0; k < _snap.count; k++)
+    {
+        const HealthReading &r = _snap.ring[(first + k) % HEALTH_HISTORY];
+        double x = (double)(r.uptimeSec - r0.uptimeSec);
+        double y = (double)r.freeHeap - (double)r0.freeHeap;
+        sx += x;
+        sy += y;
+        sxx += x * x;
+        sxy += x * y;
+    }
+    double n = _snap.count;
+    double den = n * sxx - sx * sx;
+    if (den <= 0)
+        return 0;
+    return (int32_t)((n * sxy - sx * sy) / den * 3600.0);
+}
+
+bool HealthMonitor::record(const HealthReading &reading)
+{
+    _snap.ring[_snap.head] = reading;
+    _snap.head = (_snap.head + 1) % HEALTH_HISTORY;
+    if (_snap.count < HEALTH_HISTORY)
+        _snap.count++;
+    accumulateHour(reading);
+    _snap.freeHeapTrendPerHour = trendPerHour();
+
+    uint8_t previous = _snap.warnings;
+    _snap.warnings = evaluate(reading);
+    bool raised = (_snap.warnings & ~previous) != 0;
+    if (raised)
+        _snap.warnEvents++;
+    return raised;
+}
+
+const char *HealthMonitor::warningName(uint8_t bit)
+{
+    switch (bit)
+    {
+    case HEALTH_WARN_FREE_HEAP:
+        return "free_heap";
+    case HEALTH_WARN_LARGEST_BLOCK:
+        return "largest_block";
+    case HEALTH_WARN_STACK:
+        return "stack";
+    default:
+        return "?";
+    }
+}
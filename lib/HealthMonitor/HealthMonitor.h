@@ -0,0 +1,117 @@
+#ifndef HEALTHMONITOR_H
+#define HEALTHMONITOR_H
+
+#include <stdint.h>
+
+#define HEALTH_MAX_TASKS 8
+#define HEALTH_HISTORY 60 // Amostras guardadas (1 h com uma por minuto)
+#define HEALTH_TREND_HOURS 24 // Médias horárias do heap livre usadas na tendência
+
+/**
+ * @brief Uma leitura de memória do sistema
+ */
+struct HealthReading
+{
+    uint32_t uptimeSec;
+    uint32_t freeHeap;     // Heap livre agora (bytes)
+    uint32_t largestBlock; // Maior bloco contíguo livre: o maior malloc que ainda funciona
+    uint32_t minFreeHeap;  // Menor heap livre desde o boot
+    uint16_t stackFree[HEALTH_MAX_TASKS]; // Menor folga de pilha já vista por tarefa (bytes)
+};
+
+/**
+ * @brief Limites de alerta (abaixo deles o aviso liga)
+ */
+struct HealthThresholds
+{
+    uint32_t minFreeHeap;
+    uint32_t minLargestBlock; // Acima da maior alocação do firmware, com folga
+    uint16_t minStackFree;
+};
+
+// 24 KB livres, bloco de 8 KB (AsyncTCP/WebSocket alocam até ~6 KB), 512 B de pilha
+const HealthThresholds HEALTH_DEFAULT_THRESHOLDS = {24576, 8192, 512};
+
+// Bits de HealthSnapshot::warnings
+#define HEALTH_WARN_FREE_HEAP 0x01
+#define HEALTH_WARN_LARGEST_BLOCK 0x02
+#define HEALTH_WARN_STACK 0x04
+
+/**
+ * @brief Anel de leituras e estado dos avisos (trivialmente copiável, para SeqLock)
+ */
+struct HealthSnapshot
+{
+    uint16_t count; // Leituras no anel
+    uint16_t head;  // Próxima posição a escrever
+    uint8_t taskCount;
+    uint8_t warnings;    // Bits HEALTH_WARN_* da última leitura
+    uint8_t stackWarned; // Tarefas abaixo de minStackFree (bit por tarefa)
+    uint8_t reserved;
+    uint32_t warnEvents;         // Vezes que algum aviso ligou
+    int32_t freeHeapTrendPerHour; // Inclinação do heap livre (bytes/h; negativo = vazando)
+    const char *taskNames[HEALTH_MAX_TASKS];
+    HealthThresholds thresholds;
+    HealthReading ring[HEALTH_HISTORY];
+
+    // Médias por hora de uptime, para a tendência: numa hora só, o vaivém
+    // das conexões (KB) encobre um vazamento de centenas de bytes por hora
+    uint16_t hourCount; // Horas fechadas no anel
+    uint16_t hourHead;
+    uint32_t hourIndex;    // Hora de uptime em acumulação
+    uint32_t hourSum;      // Soma do heap livre nessa hora
+    uint32_t hourReadings; // Leituras nessa hora
+    uint32_t hourIndexes[HEALTH_TREND_HOURS];
+    uint32_t hourMeans[HEALTH_TREND_HOURS];
+};
+
+/**
+ * @brief Histórico de saúde do heap e das pilhas, com avisos antecipados
+ *
+ * Recebe leituras periódicas (quem lê o hardware é o chamador) e guarda as
+ * últimas HEALTH_HISTORY num anel. Fragmentação aparece como maior bloco
+ * livre caindo enquanto o heap livre fica estável; vazamento, como heap
+ * livre com inclinação negativa, ajustada sobre as médias horárias das
+ * últimas HEALTH_TREND_HOURS (nas 3 primeiras horas, sobre o anel). Os
+ * avisos olham o maior bloco, e não só o total livre: é ele que faz um
+ * malloc falhar primeiro. A antecedência do aviso é a folga entre
+ * minLargestBlock e a maior alocação do firmware.
+ *
+ * Sem alocação; um único escritor.
+ */
+class HealthMonitor
+{
+public:
+    /**
+     * @param taskNames Nome de cada tarefa na ordem de HealthReading::stackFree (strings estáticas)
+     */
+    HealthMonitor(const char *const *taskNames, uint8_t taskCount,
+                  const HealthThresholds &thresholds = HEALTH_DEFAULT_THRESHOLDS);
+
+    /**
+     * @brief Guarda uma leitura e reavalia os avisos
+     * @return true se algum aviso ligou agora (não estava ligado na leitura anterior)
+     */
+    bool record(const HealthReading &reading);
+
+    uint8_t warnings() const { return _snap.warnings; }
+    const HealthReading &latest() const;
+    const HealthSnapshot &snapshot() const { return _snap; }
+
+    /**
+     * @brief Fragmentação em %: 100 - maior bloco / livre (0 = todo o livre é contíguo)
+     */
+    static uint8_t fragmentation(const HealthReading &reading);
+
+    static const char *warningName(uint8_t bit);
+
+private:
+    HealthSnapshot _snap;
+
+    uint8_t evaluate(const HealthReading &reading);
+    void accumulateHour(const HealthReading &reading);
+    int32_t trendPerHour() const;
+    int32_t hourlyTrend() const;
+};
+
+#endif
@@ -0,0 +1,123 @@
+#include "HistoryJsonStream.h"
+#include <string.h>
+#include "JsonWriter.h"
+
+static const char CHANNEL_KEYS[HIST_CHANNELS] = {'t', 'h', 'p', 'u', 'l'};
+static const char RES_KEYS[HIST_RES_COUNT] = {'s', 'm', 'h'};
+
+HistoryJsonStream::HistoryJsonStream(const HistoryStore &store, HistoryChannel ch, HistoryResolution res, uint32_t fromSec, uint32_t nowSec)
+{
+    _store = &store;
+    _ch = ch;
+    _res = res;
+    _nowSec = nowSec;
+    _first = true;
+    _state = HEADER;
+
+    uint32_t first, last;
+    _empty = !store.range(res, first, last);
+    if (!_empty)
+    {
+        uint32_t fromSlot = fromSec / HistoryStore::stepSec(res);
+        _next = (fromSlot > first) ? fromSlot : first;
+        _last = last;
+        _empty = _next > _last;
+    }
+    if (_empty)
+    {
+        _next = 0;
+        _last = 0;
+    }
+}
+
+bool HistoryJsonStream::parseChannel(const char *text, HistoryChannel &ch)
+{
+    for (int c = 0; c < HIST_CHANNELS; c++)
+    {
+        if (text[0] == CHANNEL_KEYS[c] && text[1] == '\0')
+        {
+            ch = (HistoryChannel)c;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool HistoryJsonStream::parseResolution(const char *text, HistoryResolution &res)
+{
+    for (int r = 0; r < HIST_RES_COUNT; r++)
+    {
+        if (text[0] == RES_KEYS[r] && text[1] == '\0')
+        {
+            res = (HistoryResolution)r;
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t HistoryJsonStream::fill(uint8_t *buffer, size_t maxLen)
+{
+    size_t len = 0;
+    char item[96];
+
+    while (_state != DONE)
+    {
+        JsonWriter w(item, sizeof(item));
+
+        if (_state == HEADER)
+        {
+            char key[2] = {CHANNEL_KEYS[_ch], '\0'};
+            w.beginObject();
+            w.key("ch");
+            w.string(key);
+            w.field("step", HistoryStore::stepSec(_res));
+            w.field("t0", _next * HistoryStore::stepSec(_res));
+            w.field("now", _nowSec);
+            w.key("v");
+            w.raw("[");
+        }
+        else if (_state == VALUES)
+        {
+            if (!_first)
+                w.raw(",");
+            float value;
+            if (_store->get(_ch, _res, _next, value))
+                w.fixed(value, HistoryStore::decimals(_ch));
+            else
+                w.raw("null");
+        }
+        else // FOOTER
+        {
+            w.raw("]}");
+        }
+
+        // Cada item vai inteiro ou fica para o próximo pedaço
+        if (len + w.length() > maxLen)
+            break;
+        memcpy(buffer + len, item, w.length());
+        len += w.length();
+
+        if (_state == HEADER)
+        {
+            _state = _empty ? FOOTER : VALUES;
+        }
+        else if (_state == VALUES)
+        {
+            _first = false;
+            if (_next == _last)
+                _state = FOOTER;
+            else
+                _next++;
+        }
+        else
+        {
+            _state = DONE;
+        }
+    }
+
+    // Nem o cabeçalho coube (janela TCP apertada): 0 encerraria a resposta
+    if (len == 0 && _state != DONE)
+        return RESPONSE_TRY_AGAIN;
+    return len;
+}
@@ -0,0 +1,70 @@
+#ifndef HISTORYJSONSTREAM_H
+#define HISTORYJSONSTREAM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "HistoryStore.h"
+#include "JsonWriter.h" // RESPONSE_TRY_AGAIN
+
+/**
+ * @brief Gera o JSON de /history em pedaços, direto do HistoryStore
+ *
+ * Feito para o callback de resposta chunked do AsyncWebServer: cada
+ * chamada de fill() escreve no máximo maxLen bytes e a memória usada
+ * é constante, independente do tamanho do histórico.
+ *
+ * Formato: {"ch":"t","step":60,"t0":123,"now":456,"v":[1.23,null,...]}
+ * onde t0 é o tempo (s de uptime) do primeiro valor e cada valor seguinte
+ * avança 'step' segundos.
+ */
+class HistoryJsonStream
+{
+public:
+    /**
+     * @param store Histórico de origem
+     * @param ch Canal desejado
+     * @param res Resolução desejada
+     * @param fromSec Primeiro instante desejado (s de uptime)
+     * @param nowSec Tempo atual (s de uptime), informado no cabeçalho
+     */
+    HistoryJsonStream(const HistoryStore &store, HistoryChannel ch, HistoryResolution res, uint32_t fromSec, uint32_t nowSec);
+
+    /**
+     * @brief Escreve o próximo pedaço
+     * @return Bytes escritos; 0 quando terminou; RESPONSE_TRY_AGAIN se o
+     * próximo item não cabe em maxLen (a resposta continua)
+     */
+    size_t fill(uint8_t *buffer, size_t maxLen);
+
+    /**
+     * @brief Converte a letra da chave JSON (t, h, p, u, l) em canal
+     * @return false se a letra não for conhecida
+     */
+    static bool parseChannel(const char *text, HistoryChannel &ch);
+
+    /**
+     * @brief Converte "s", "m" ou "h" em resolução
+     */
+    static bool parseResolution(const char *text, HistoryResolution &res);
+
+private:
+    enum State
+    {
+        HEADER,
+        VALUES,
+        FOOTER,
+        DONE
+    };
+
+    const HistoryStore *_store;
+    HistoryChannel _ch;
+    HistoryResolution _res;
+    uint32_t _nowSec;
+    uint32_t _next;
+    uint32_t _last;
+    bool _empty;
+    bool _first;
+    State _state;
+};
+
+#endif
@@ -0,0 +1,196 @@
+#include "HistoryStore.h"
+
+// Escala de quantização por canal (valor = q * escala)
+static const float SCALE[HIST_CHANNELS] = {
+    0.01f,  // Temperatura: 0.01 C
+    0.01f,  // Umidade: 0.01 %
+    0.1f,   // Pressão: 0.1 hPa
+    0.001f, // UV: 0.001 mW/cm^2
+    1.0f,   // Luminosidade
+};
+static const uint8_t DECIMALS[HIST_CHANNELS] = {2, 2, 1, 3, 0};
+
+static const uint32_t STEP[HIST_RES_COUNT] = {1, 60, 3600};
+static const uint16_t CAPACITY[HIST_RES_COUNT] = {600, 360, 168};
+
+HistoryStore::HistoryStore()
+{
+    std::atomic<int16_t>(*data[HIST_RES_COUNT])[HIST_CHANNELS] = {_secData, _minData, _hourData};
+    _version.store(0, std::memory_order_relaxed);
+
+    for (int r = 0; r < HIST_RES_COUNT; r++)
+    {
+        Ring &ring = _rings[r];
+        ring.data = data[r];
+        ring.capacity = CAPACITY[r];
+        ring.step = STEP[r];
+        ring.newestSlot.store(0, std::memory_order_relaxed);
+        ring.hasData.store(false, std::memory_order_relaxed);
+        ring.accSlot = 0;
+        for (int c = 0; c < HIST_CHANNELS; c++)
+        {
+            ring.accSum[c] = 0;
+            ring.accCount[c] = 0;
+        }
+        for (uint16_t i = 0; i < ring.capacity; i++)
+            clearRow(ring.data[i]);
+    }
+}
+
+uint32_t HistoryStore::stepSec(HistoryResolution res)
+{
+    return STEP[res];
+}
+
+uint16_t HistoryStore::capacity(HistoryResolution res)
+{
+    return CAPACITY[res];
+}
+
+uint8_t HistoryStore::decimals(HistoryChannel ch)
+{
+    return DECIMALS[ch];
+}
+
+int16_t HistoryStore::quantize(HistoryChannel ch, float value)
+{
+    if (value != value) // NaN
+        return MISSING;
+
+    float q = value / SCALE[ch];
+    q += (q >= 0) ? 0.5f : -0.5f;
+    if (q > 32767.0f)
+        return 32767;
+    if (q < -32767.0f)
+        return -32767;
+    return (int16_t)q;
+}
+
+float HistoryStore::dequantize(HistoryChannel ch, int16_t q)
+{
+    return q * SCALE[ch];
+}
+
+void HistoryStore::clearRow(std::atomic<int16_t> *row)
+{
+    for (int c = 0; c < HIST_CHANNELS; c++)
+        row[c].store(MISSING, std::memory_order_relaxed);
+}
+
+void HistoryStore::advance(Ring &ring, uint32_t slot)
+{
+    bool hasData = ring.hasData.load(std::memory_order_relaxed);
+    uint32_t newest = ring.newestSlot.load(std::memory_order_relaxed);
+    if (!hasData || slot - newest >= ring.capacity)
+    {
+        // Primeiro dado ou lacuna maior que a janela: limpa tudo
+        for (uint16_t i = 0; i < ring.capacity; i++)
+            clearRow(ring.data[i]);
+    }
+    else
+    {
+        // Slots pulados ficam marcados como ausentes
+        for (uint32_t s = newest + 1; s <= slot; s++)
+            clearRow(ring.data[s % ring.capacity]);
+    }
+    ring.newestSlot.store(slot, std::memory_order_relaxed);
+    ring.hasData.store(true, std::memory_order_relaxed);
+}
+
+void HistoryStore::add(uint32_t nowSec, const float values[HIST_CHANNELS])
+{
+    // Versão ímpar durante a escrita: quem ler agora descarta e repete
+    uint32_t version = _version.load(std::memory_order_relaxed);
+    _version.store(version + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (int r = 0; r < HIST_RES_COUNT; r++)
+    {
+        Ring &ring = _rings[r];
+        uint32_t slot = nowSec / ring.step;
+        bool hasData = ring.hasData.load(std::memory_order_relaxed);
+        uint32_t newest = ring.newestSlot.load(std::memory_order_relaxed);
+
+        // Tempo voltou: ignora (não reescreve o passado)
+        if (hasData && slot < newest)
+            continue;
+
+        if (!hasData || slot != newest)
+        {
+            advance(ring, slot);
+            ring.accSlot = slot;
+            for (int c = 0; c < HIST_CHANNELS; c++)
+            {
+                ring.accSum[c] = 0;
+                ring.accCount[c] = 0;
+            }
+        }
+
+        std::atomic<int16_t> *row = ring.data[slot % ring.capacity];
+        for (int c = 0; c < HIST_CHANNELS; c++)
+        {
+            float v = values[c];
+            if (v != v)
+                continue;
+
+            ring.accSum[c] += v;
+            ring.accCount[c]++;
+            row[c].store(quantize((HistoryChannel)c, ring.accSum[c] / ring.accCount[c]), std::memory_order_relaxed);
+        }
+    }
+
+    _version.store(version + 2, std::memory_order_release);
+}
+
+bool HistoryStore::rangeOnce(const Ring &ring, uint32_t &firstSlot, uint32_t &lastSlot) const
+{
+    if (!ring.hasData.load(std::memory_order_relaxed))
+        return false;
+
+    lastSlot = ring.newestSlot.load(std::memory_order_relaxed);
+    firstSlot = (lastSlot + 1 >= ring.capacity) ? lastSlot + 1 - ring.capacity : 0;
+    return true;
+}
+
+bool HistoryStore::range(HistoryResolution res, uint32_t &firstSlot, uint32_t &lastSlot) const
+{
+    for (uint16_t attempt = 0; attempt < READ_ATTEMPTS; attempt++)
+    {
+        uint32_t before = _version.load(std::memory_order_acquire);
+        if (before & 1)
+            continue;
+        bool ok = rangeOnce(_rings[res], firstSlot, lastSlot);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (_version.load(std::memory_order_relaxed) == before)
+            return ok;
+    }
+    return false;
+}
+
+bool HistoryStore::get(HistoryChannel ch, HistoryResolution res, uint32_t slot, float &value) const
+{
+    const Ring &ring = _rings[res];
+    for (uint16_t attempt = 0; attempt < READ_ATTEMPTS; attempt++)
+    {
+        uint32_t before = _version.load(std::memory_order_acquire);
+        if (before & 1)
+            continue;
+
+        // Janela e valor conferidos na mesma versão: o slot ainda é o pedido
+        uint32_t first, last;
+        int16_t q = MISSING;
+        if (rangeOnce(ring, first, last) && slot >= first && slot <= last)
+            q = ring.data[slot % ring.capacity][ch].load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (_version.load(std::memory_order_relaxed) != before)
+            continue;
+        if (q == MISSING)
+            return false;
+
+        value = dequantize(ch, q);
+        return true;
+    }
+    return false;
+}
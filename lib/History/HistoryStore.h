@@ -0,0 +1,124 @@
+#ifndef HISTORYSTORE_H
+#define HISTORYSTORE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+// Canais gravados (mesma ordem das chaves do JSON: t, h, p, u, l)
+enum HistoryChannel
+{
+    HIST_TEMP = 0,
+    HIST_HUM,
+    HIST_PRES,
+    HIST_UV,
+    HIST_LUMENS,
+    HIST_CHANNELS
+};
+
+// Resoluções disponíveis
+enum HistoryResolution
+{
+    HIST_RES_SECOND = 0,
+    HIST_RES_MINUTE,
+    HIST_RES_HOUR,
+    HIST_RES_COUNT
+};
+
+/**
+ * @brief Histórico em memória fixa, em várias resoluções (1 s, 1 min, 1 h)
+ *
+ * Cada valor é quantizado em int16 com escala por canal (ex: 0.01 C).
+ * Os anéis são indexados pelo próprio tempo (slot = tempo / passo) e
+ * minutos e horas guardam a média parcial do período corrente.
+ *
+ * Um escritor (add()) e leitores em outras tarefas: cada add() muda um
+ * contador de versão (ímpar durante a escrita), como no SeqLock. get() e
+ * range() só aceitam o que leram se a versão não mudou no meio, senão
+ * repetem; um slot reaproveitado pela volta do anel durante a leitura
+ * nunca é entregue como se fosse do instante pedido. Valores e índices
+ * ficam em atômicos relaxados (mesmo código de máquina que int16/uint32
+ * no ESP32), o que mantém o acesso concorrente bem definido.
+ *
+ * Memória: HIST_CHANNELS * 2 bytes * (600 + 360 + 168) ~= 11 KB
+ */
+class HistoryStore
+{
+public:
+    static const int16_t MISSING = INT16_MIN;
+
+    HistoryStore();
+
+    /**
+     * @brief Registra uma leitura de todos os canais
+     * @param nowSec Tempo em segundos (uptime)
+     * @param values Valores na ordem de HistoryChannel (NaN = ausente)
+     */
+    void add(uint32_t nowSec, const float values[HIST_CHANNELS]);
+
+    /**
+     * @brief Passo da resolução em segundos (1, 60, 3600)
+     */
+    static uint32_t stepSec(HistoryResolution res);
+
+    /**
+     * @brief Quantidade de slots guardados na resolução
+     */
+    static uint16_t capacity(HistoryResolution res);
+
+    /**
+     * @brief Casas decimais significativas do canal (para exportação)
+     */
+    static uint8_t decimals(HistoryChannel ch);
+
+    /**
+     * @brief Intervalo de slots disponíveis [first, last]
+     * @return false se ainda não há dados nessa resolução
+     */
+    bool range(HistoryResolution res, uint32_t &firstSlot, uint32_t &lastSlot) const;
+
+    /**
+     * @brief Valor de um slot
+     * @return false se ausente, fora da janela guardada, ou se o escritor
+     * não saiu do meio de um add() depois de algumas tentativas
+     */
+    bool get(HistoryChannel ch, HistoryResolution res, uint32_t slot, float &value) const;
+
+    /**
+     * @brief Quantidade de add() concluídos
+     */
+    uint32_t version() const { return _version.load(std::memory_order_acquire) / 2; }
+
+private:
+    // Tentativas de leitura antes de desistir: cobrem com folga um add()
+    // comum (poucos us) no outro core, sem travar se o escritor foi preemptado
+    static const uint16_t READ_ATTEMPTS = 1000;
+
+    struct Ring
+    {
+        std::atomic<int16_t> (*data)[HIST_CHANNELS];
+        uint16_t capacity;
+        uint32_t step;
+        std::atomic<uint32_t> newestSlot;
+        std::atomic<bool> hasData;
+
+        // Acumulador da média do slot corrente
+        uint32_t accSlot;
+        float accSum[HIST_CHANNELS];
+        uint16_t accCount[HIST_CHANNELS];
+    };
+
+    std::atomic<int16_t> _secData[600][HIST_CHANNELS];
+    std::atomic<int16_t> _minData[360][HIST_CHANNELS];
+    std::atomic<int16_t> _hourData[168][HIST_CHANNELS];
+    Ring _rings[HIST_RES_COUNT];
+    std::atomic<uint32_t> _version; // Ímpar: add() em andamento
+
+    static int16_t quantize(HistoryChannel ch, float value);
+    static float dequantize(HistoryChannel ch, int16_t q);
+    void advance(Ring &ring, uint32_t slot);
+    static void clearRow(std::atomic<int16_t> *row);
+    bool rangeOnce(const Ring &ring, uint32_t &firstSlot, uint32_t &lastSlot) const;
+};
+
+#endif
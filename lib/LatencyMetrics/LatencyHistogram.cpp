@@ -0,0 +1,54 @@
+#include "LatencyHistogram.h"
+
+void LatencyHistogram::reset()
+{
+    for (uint8_t i = 0; i < BUCKETS; i++)
+        _buckets[i] = 0;
+    _count = 0;
+    _sumUs = 0;
+    _maxUs = 0;
+}
+
+void LatencyHistogram::record(uint32_t us)
+{
+    // Menor i com us <= 2^i (teto do log2)
+    uint8_t i = (us <= 1) ? 0 : (uint8_t)(32 - __builtin_clz(us - 1));
+    if (i < BUCKETS)
+        _buckets[i] = _buckets[i] + 1;
+
+    _count = _count + 1;
+    _sumUs = _sumUs + us;
+    if (us > _maxUs)
+        _maxUs = us;
+}
+
+uint32_t LatencyHistogram::percentileUs(uint16_t perMille) const
+{
+    uint32_t total = _count;
+    if (total == 0)
+        return 0;
+
+    // Posição da amostra desejada (1..total)
+    uint32_t target = (uint32_t)(((uint64_t)total * perMille + 999) / 1000);
+    if (target == 0)
+        target = 1;
+
+    uint32_t cumulative = 0;
+    for (uint8_t i = 0; i < BUCKETS; i++)
+    {
+        uint32_t n = _buckets[i];
+        if (n == 0 || cumulative + n < target)
+        {
+            cumulative += n;
+            continue;
+        }
+
+        uint32_t lower = (i == 0) ? 0 : bucketUpperUs(i - 1);
+        uint32_t upper = bucketUpperUs(i);
+        uint32_t estimate = lower + (uint32_t)((uint64_t)(upper - lower) * (target - cumulative) / n);
+        return (estimate < _maxUs) ? estimate : _maxUs;
+    }
+
+    // Amostra alvo acima do último balde
+    return _maxUs;
+}
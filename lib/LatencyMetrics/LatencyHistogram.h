@@ -0,0 +1,71 @@
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <stdint.h>
+#include "Hal.h"
+
+/**
+ * @brief Histograma de latências em microssegundos com baldes fixos em potência de 2
+ *
+ * O balde i conta as amostras <= 2^i us (1 us a ~8.4 s); acima disso a
+ * amostra entra só no total (+Inf). record() é O(1), sem alocação e sem
+ * trava: cada histograma deve ter um único escritor (a própria tarefa ou o
+ * handler); leitores em outro core podem ver um contador atrasado em uma
+ * amostra, o que é aceitável para métricas.
+ */
+class LatencyHistogram
+{
+public:
+    static const uint8_t BUCKETS = 24;
+
+    LatencyHistogram() { reset(); }
+
+    void record(uint32_t us);
+    void reset();
+
+    uint32_t count() const { return _count; }
+    uint64_t sumUs() const { return _sumUs; }
+    uint32_t maxUs() const { return _maxUs; }
+    uint32_t bucket(uint8_t i) const { return _buckets[i]; }
+
+    /**
+     * @brief Limite superior do balde i em microssegundos
+     */
+    static uint32_t bucketUpperUs(uint8_t i) { return 1UL << i; }
+
+    /**
+     * @brief Percentil estimado (interpolação linear dentro do balde)
+     * @param perMille Percentil em milésimos (500 = p50, 990 = p99)
+     * @return Microssegundos (0 se vazio), nunca acima do máximo observado
+     */
+    uint32_t percentileUs(uint16_t perMille) const;
+
+private:
+    volatile uint32_t _buckets[BUCKETS];
+    volatile uint32_t _count;
+    volatile uint64_t _sumUs;
+    volatile uint32_t _maxUs;
+};
+
+/**
+ * @brief Mede o trecho até o fim do escopo pelo contador de ciclos do Hal
+ *
+ * Uso: { LatencyProbe probe(hist); ...trabalho... }
+ * O trecho deve começar e terminar no mesmo core (contador por core).
+ */
+class LatencyProbe
+{
+public:
+    explicit LatencyProbe(LatencyHistogram &hist) : _hist(&hist), _start(Hal::clock().cycles()) {}
+    ~LatencyProbe()
+    {
+        HalClock &clock = Hal::clock();
+        _hist->record((clock.cycles() - _start) / clock.cyclesPerUs());
+    }
+
+private:
+    LatencyHistogram *_hist;
+    uint32_t _start;
+};
+
+#endif
@@ -0,0 +1,39 @@
+#include "MetricsRegistry.h"
+
+int MetricsRegistry::addFamily(const char *name, const char *help, const char *label, MetricKind kind)
+{
+    if (_familyCount >= METRICS_MAX_FAMILIES)
+        return -1;
+    MetricFamily &f = _families[_familyCount];
+    f.name = name;
+    f.help = help;
+    f.label = label;
+    f.kind = kind;
+    return _familyCount++;
+}
+
+bool MetricsRegistry::addHistogram(int family, const char *labelValue, const LatencyHistogram &hist)
+{
+    if (family < 0 || family >= _familyCount || _seriesCount >= METRICS_MAX_SERIES ||
+        _families[family].kind != METRIC_HISTOGRAM)
+        return false;
+    MetricSeries &s = _series[_seriesCount++];
+    s.family = (uint8_t)family;
+    s.labelValue = labelValue;
+    s.hist = &hist;
+    s.counter = nullptr;
+    return true;
+}
+
+bool MetricsRegistry::addCounter(int family, const char *labelValue, const volatile uint32_t &counter)
+{
+    if (family < 0 || family >= _familyCount || _seriesCount >= METRICS_MAX_SERIES ||
+        _families[family].kind != METRIC_COUNTER)
+        return false;
+    MetricSeries &s = _series[_seriesCount++];
+    s.family = (uint8_t)family;
+    s.labelValue = labelValue;
+    s.hist = nullptr;
+    s.counter = &counter;
+    return true;
+}
@@ -0,0 +1,72 @@
+#ifndef METRICSREGISTRY_H
+#define METRICSREGISTRY_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "LatencyHistogram.h"
+
+/**
+ * @brief Tabela estática das métricas expostas em /metrics
+ *
+ * Cada família tem nome, descrição e um rótulo (ex: task, route); cada série
+ * é um valor do rótulo ligado a um histograma ou a um contador existente.
+ * O registro só guarda ponteiros: quem mede continua dono dos dados.
+ */
+#define METRICS_MAX_FAMILIES 8
+#define METRICS_MAX_SERIES 32
+
+enum MetricKind
+{
+    METRIC_HISTOGRAM, // Latência: <nome>_seconds (histograma) e <nome>_quantile_seconds (p50/p99/max)
+    METRIC_COUNTER    // Contador: <nome>_total
+};
+
+struct MetricFamily
+{
+    const char *name;
+    const char *help;
+    const char *label;
+    MetricKind kind;
+};
+
+struct MetricSeries
+{
+    uint8_t family;
+    const char *labelValue;
+    const LatencyHistogram *hist;
+    const volatile uint32_t *counter;
+};
+
+class MetricsRegistry
+{
+public:
+    MetricsRegistry() : _familyCount(0), _seriesCount(0) {}
+
+    /**
+     * @return Índice da família, ou -1 se a tabela estiver cheia
+     */
+    int addFamily(const char *name, const char *help, const char *label, MetricKind kind);
+
+    /**
+     * @return false se a tabela estiver cheia ou a família não for de histograma
+     */
+    bool addHistogram(int family, const char *labelValue, const LatencyHistogram &hist);
+
+    /**
+     * @return false se a tabela estiver cheia ou a família não for de contador
+     */
+    bool addCounter(int family, const char *labelValue, const volatile uint32_t &counter);
+
+    uint8_t familyCount() const { return _familyCount; }
+    uint8_t seriesCount() const { return _seriesCount; }
+    const MetricFamily &family(uint8_t i) const { return _families[i]; }
+    const MetricSeries &series(uint8_t i) const { return _series[i]; }
+
+private:
+    MetricFamily _families[METRICS_MAX_FAMILIES];
+    MetricSeries _series[METRICS_MAX_SERIES];
+    uint8_t _familyCount;
+    uint8_t _seriesCount;
+};
+
+#endif
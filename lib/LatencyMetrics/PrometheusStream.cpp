@@ -0,0 +1,186 @@
+#include "PrometheusStream.h"
+#include <stdio.h>
+#include <string.h>
+
+// Quantis expostos por histograma (em milésimos; 1000 = máximo)
+static const uint16_t QUANTILES[] = {500, 990, 1000};
+static const char *const QUANTILE_LABELS[] = {"0.5", "0.99", "1"};
+static const uint8_t QUANTILE_COUNT = sizeof(QUANTILES) / sizeof(QUANTILES[0]);
+
+PrometheusStream::PrometheusStream(const MetricsRegistry &registry)
+{
+    _registry = &registry;
+    _series = 0;
+    _line = 0;
+    _cumulative = 0;
+    _done = false;
+    enterFamily(0);
+}
+
+void PrometheusStream::enterFamily(uint8_t family)
+{
+    // Famílias sem séries não aparecem
+    for (_family = family; _family < _registry->familyCount(); _family++)
+    {
+        if (findSeries(0))
+        {
+            _phase = HEADER;
+            return;
+        }
+    }
+    _done = true;
+}
+
+bool PrometheusStream::findSeries(uint8_t from)
+{
+    for (uint8_t i = from; i < _registry->seriesCount(); i++)
+    {
+        const MetricSeries &s = _registry->series(i);
+        if (s.family != _family)
+            continue;
+
+        // Cópia do histograma: a série inteira sai do mesmo instante
+        _series = i;
+        _line = 0;
+        _cumulative = 0;
+        if (s.hist != nullptr)
+            _snapshot = *s.hist;
+        return true;
+    }
+    return false;
+}
+
+uint8_t PrometheusStream::linesPerSeries() const
+{
+    if (_phase == QUANTILE_SERIES)
+        return QUANTILE_COUNT;
+    if (_registry->family(_family).kind == METRIC_COUNTER)
+        return 1;
+    return LatencyHistogram::BUCKETS + 3; // Baldes, +Inf, _sum, _count
+}
+
+size_t PrometheusStream::fill(uint8_t *buffer, size_t maxLen)
+{
+    size_t len = 0;
+    char line[192];
+
+    while (!_done)
+    {
+        size_t n = formatLine(line, sizeof(line));
+
+        // Cada linha vai inteira ou fica para o próximo pedaço
+        if (len + n > maxLen)
+            break;
+        memcpy(buffer + len, line, n);
+        len += n;
+        advance();
+    }
+
+    // Nem a próxima linha coube (janela TCP apertada): 0 encerraria a resposta
+    if (len == 0 && !_done)
+        return RESPONSE_TRY_AGAIN;
+    return len;
+}
+
+void PrometheusStream::advance()
+{
+    bool histogram = _registry->family(_family).kind == METRIC_HISTOGRAM;
+
+    switch (_phase)
+    {
+    case HEADER:
+        _phase = SERIES;
+        findSeries(0);
+        break;
+
+    case SERIES:
+        if (histogram && _line < LatencyHistogram::BUCKETS)
+            _cumulative += _snapshot.bucket(_line);
+        if (++_line < linesPerSeries())
+            break;
+        if (findSeries(_series + 1))
+            break;
+        if (histogram)
+            _phase = QUANTILE_HEADER;
+        else
+            enterFamily(_family + 1);
+        break;
+
+    case QUANTILE_HEADER:
+        _phase = QUANTILE_SERIES;
+        findSeries(0);
+        break;
+
+    case QUANTILE_SERIES:
+        if (++_line < linesPerSeries())
+            break;
+        if (!findSeries(_series + 1))
+            enterFamily(_family + 1);
+        break;
+    }
+}
+
+size_t PrometheusStream::formatLine(char *line, size_t size)
+{
+    const MetricFamily &f = _registry->family(_family);
+    const MetricSeries &s = _registry->series(_series);
+    int n = 0;
+
+    switch (_phase)
+    {
+    case HEADER:
+        if (f.kind == METRIC_COUNTER)
+            n = snprintf(line, size, "# HELP %s_total %s\n# TYPE %s_total counter\n", f.name, f.help, f.name);
+        else
+            n = snprintf(line, size, "# HELP %s_seconds %s\n# TYPE %s_seconds histogram\n", f.name, f.help, f.name);
+        break;
+
+    case SERIES:
+        if (f.kind == METRIC_COUNTER)
+        {
+            n = snprintf(line, size, "%s_total{%s=\"%s\"} %lu\n", f.name, f.label, s.labelValue,
+                         (unsigned long)*s.counter);
+        }
+        else if (_line < LatencyHistogram::BUCKETS)
+        {
+            uint32_t le = LatencyHistogram::bucketUpperUs(_line);
+            n = snprintf(line, size, "%s_seconds_bucket{%s=\"%s\",le=\"%lu.%06lu\"} %lu\n", f.name, f.label,
+                         s.labelValue, (unsigned long)(le / 1000000), (unsigned long)(le % 1000000),
+                         (unsigned long)(_cumulative + _snapshot.bucket(_line)));
+        }
+        else if (_line == LatencyHistogram::BUCKETS)
+        {
+            n = snprintf(line, size, "%s_seconds_bucket{%s=\"%s\",le=\"+Inf\"} %lu\n", f.name, f.label,
+                         s.labelValue, (unsigned long)_snapshot.count());
+        }
+        else if (_line == LatencyHistogram::BUCKETS + 1)
+        {
+            uint64_t sum = _snapshot.sumUs();
+            n = snprintf(line, size, "%s_seconds_sum{%s=\"%s\"} %lu.%06lu\n", f.name, f.label, s.labelValue,
+                         (unsigned long)(sum / 1000000), (unsigned long)(sum % 1000000));
+        }
+        else
+        {
+            n = snprintf(line, size, "%s_seconds_count{%s=\"%s\"} %lu\n", f.name, f.label, s.labelValue,
+                         (unsigned long)_snapshot.count());
+        }
+        break;
+
+    case QUANTILE_HEADER:
+        n = snprintf(line, size, "# HELP %s_quantile_seconds %s (p50, p99 e máximo)\n# TYPE %s_quantile_seconds gauge\n",
+                     f.name, f.help, f.name);
+        break;
+
+    case QUANTILE_SERIES:
+    {
+        uint32_t us = _snapshot.percentileUs(QUANTILES[_line]);
+        n = snprintf(line, size, "%s_quantile_seconds{%s=\"%s\",quantile=\"%s\"} %lu.%06lu\n", f.name, f.label,
+                     s.labelValue, QUANTILE_LABELS[_line], (unsigned long)(us / 1000000), (unsigned long)(us % 1000000));
+        break;
+    }
+    }
+
+    if (n < 0)
+        return 0;
+    return ((size_t)n < size) ? (size_t)n : size - 1;
+}
@@ -0,0 +1,59 @@
+#ifndef PROMETHEUSSTREAM_H
+#define PROMETHEUSSTREAM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "MetricsRegistry.h"
+#include "JsonWriter.h" // RESPONSE_TRY_AGAIN
+
+/**
+ * @brief Gera /metrics (formato texto do Prometheus) em pedaços
+ *
+ * Mesmo esquema do HistoryJsonStream: feito para a resposta chunked do
+ * AsyncWebServer, memória constante e cada linha vai inteira ou fica para o
+ * próximo pedaço. Cada histograma é copiado ao começar sua série, então
+ * baldes, _sum e _count de uma série são sempre coerentes entre si.
+ *
+ * Para cada família de histograma F:
+ *   F_seconds_bucket{label="x",le="0.000001"} ... +Inf, F_seconds_sum, F_seconds_count
+ *   F_quantile_seconds{label="x",quantile="0.5"|"0.99"|"1"}   (1 = máximo)
+ * Para cada família de contador C: C_total{label="x"}
+ */
+class PrometheusStream
+{
+public:
+    explicit PrometheusStream(const MetricsRegistry &registry);
+
+    /**
+     * @brief Escreve o próximo pedaço
+     * @return Bytes escritos; 0 quando terminou; RESPONSE_TRY_AGAIN se o
+     * próximo item não cabe em maxLen (a resposta continua)
+     */
+    size_t fill(uint8_t *buffer, size_t maxLen);
+
+private:
+    enum Phase
+    {
+        HEADER,       // # HELP / # TYPE da família
+        SERIES,       // Linhas de cada série
+        QUANTILE_HEADER,
+        QUANTILE_SERIES
+    };
+
+    size_t formatLine(char *line, size_t size);
+    void advance();
+    void enterFamily(uint8_t family);
+    bool findSeries(uint8_t from);
+    uint8_t linesPerSeries() const;
+
+    const MetricsRegistry *_registry;
+    uint8_t _family;
+    uint8_t _series;
+    uint8_t _line;
+    Phase _phase;
+    bool _done;
+    LatencyHistogram _snapshot;
+    uint32_t _cumulative;
+};
+
+#endif
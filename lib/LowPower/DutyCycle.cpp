@@ -0,0 +1,76 @@
+#include "DutyCycle.h"
+#include <string.h>
+
+#define BATCH_MAGIC 0x53544231UL // "STB1"
+
+DutyCycle::DutyCycle(SampleBatch &batch, const DutyCycleConfig &config)
+{
+    _batch = &batch;
+    setConfig(config);
+}
+
+void DutyCycle::setConfig(const DutyCycleConfig &config)
+{
+    _config = config;
+    if (_config.batchSize < 1)
+        _config.batchSize = 1;
+    if (_config.batchSize > BATCH_CAPACITY)
+        _config.batchSize = BATCH_CAPACITY;
+}
+
+bool DutyCycle::restore()
+{
+    bool valid = (_batch->magic == BATCH_MAGIC && _batch->count <= BATCH_CAPACITY);
+    if (!valid)
+    {
+        memset(_batch, 0, sizeof(SampleBatch));
+        _batch->magic = BATCH_MAGIC;
+    }
+    _batch->wakeCount++;
+    return valid;
+}
+
+DutyAction DutyCycle::onSample(const BatchRecord &record)
+{
+    if (_batch->count < BATCH_CAPACITY)
+        _batch->records[_batch->count++] = record;
+    else
+        _batch->dropped++;
+
+    // Alarme só liga o WiFi na borda de subida; um alarme longo não drena a bateria
+    bool alarm = (record.flags & BATCH_FLAG_ALARM) != 0;
+    bool newAlarm = alarm && !_batch->alarmLatched;
+    _batch->alarmLatched = alarm;
+
+    if (newAlarm || _batch->count >= _config.batchSize)
+        return DUTY_UPLOAD;
+    return DUTY_SLEEP;
+}
+
+bool DutyCycle::uploadFinished(uint32_t awakeMs, uint32_t lastClientMs) const
+{
+    if (awakeMs < _config.uploadMinMs)
+        return false;
+    if (awakeMs >= _config.uploadMaxMs)
+        return true;
+    // Fica acordado enquanto alguém estiver usando a página
+    return lastClientMs == 0 || awakeMs - lastClientMs >= _config.clientIdleMs;
+}
+
+uint32_t DutyCycle::sleepMs(uint32_t awakeMs, bool uploaded)
+{
+    if (uploaded)
+    {
+        _batch->count = 0;
+        _batch->dropped = 0;
+        _batch->uploadCount++;
+    }
+
+    // Mantém o período entre despertares descontando o tempo acordado
+    uint32_t sleep = _config.sampleIntervalMs > awakeMs ? _config.sampleIntervalMs - awakeMs : 0;
+    if (sleep < _config.minSleepMs)
+        sleep = _config.minSleepMs;
+
+    _batch->stationMs += awakeMs + sleep;
+    return sleep;
+}
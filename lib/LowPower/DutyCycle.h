@@ -0,0 +1,90 @@
+#ifndef DUTYCYCLE_H
+#define DUTYCYCLE_H
+
+#include <stdint.h>
+#include "SampleBatch.h"
+
+/**
+ * @brief Parâmetros do modo de baixo consumo
+ */
+struct DutyCycleConfig
+{
+    uint32_t sampleIntervalMs; // Período entre despertares
+    uint16_t batchSize;        // Amostras no lote antes de ligar WiFi/display (<= BATCH_CAPACITY)
+    uint32_t uploadMinMs;      // Tempo mínimo acordado numa janela de envio
+    uint32_t uploadMaxMs;      // Limite da janela mesmo com clientes ativos
+    uint32_t clientIdleMs;     // Sem requisições há esse tempo = ninguém conectado
+    uint32_t minSleepMs;       // Sono mínimo, mesmo que o ciclo tenha atrasado
+};
+
+// Uma amostra por minuto, WiFi uma vez por hora (ou num alarme novo)
+const DutyCycleConfig DUTY_DEFAULT_CONFIG = {60000, 60, 30000, 300000, 10000, 1000};
+
+/**
+ * @brief Próximo passo depois de uma amostra
+ */
+enum DutyAction
+{
+    DUTY_SLEEP = 0, // Volta a dormir até o próximo despertar
+    DUTY_UPLOAD     // Liga WiFi/display e serve o lote
+};
+
+/**
+ * @brief Máquina de estados do modo de baixo consumo
+ *
+ * Ciclo: desperta pelo timer -> amostra -> onSample() decide entre dormir
+ * de novo ou abrir uma janela de envio (lote cheio ou alarme novo). Na
+ * janela, uploadFinished() diz quando fechar; sleepMs() calcula o sono e
+ * avança o relógio da estação. Não conhece hardware: recebe tempos em ms
+ * desde o boot (millis()), então roda igual no host com um relógio simulado.
+ */
+class DutyCycle
+{
+public:
+    DutyCycle(SampleBatch &batch, const DutyCycleConfig &config = DUTY_DEFAULT_CONFIG);
+
+    void setConfig(const DutyCycleConfig &config);
+    const DutyCycleConfig &config() const { return _config; }
+
+    /**
+     * @brief Valida o lote da memória RTC e conta o despertar
+     * @return false na partida a frio (lote zerado)
+     */
+    bool restore();
+
+    /**
+     * @brief Relógio da estação em segundos (contínuo entre sonos)
+     * @param awakeMs Tempo desde o boot atual
+     */
+    uint32_t stationSec(uint32_t awakeMs) const { return (_batch->stationMs + awakeMs) / 1000; }
+
+    /**
+     * @brief Guarda a amostra no lote e decide o próximo passo
+     * @param record Amostra compactada
+     * @return DUTY_UPLOAD com o lote cheio ou num alarme que ainda não foi avisado
+     */
+    DutyAction onSample(const BatchRecord &record);
+
+    /**
+     * @brief Indica se a janela de envio acabou
+     * @param awakeMs Tempo desde o boot atual
+     * @param lastClientMs millis() da última requisição (0 = nenhuma)
+     */
+    bool uploadFinished(uint32_t awakeMs, uint32_t lastClientMs) const;
+
+    /**
+     * @brief Prepara o sono: esvazia o lote se foi enviado e avança o relógio
+     * @param awakeMs Tempo acordado neste boot
+     * @param uploaded true ao sair de uma janela de envio
+     * @return Duração do sono em ms
+     */
+    uint32_t sleepMs(uint32_t awakeMs, bool uploaded);
+
+    const SampleBatch &batch() const { return *_batch; }
+
+private:
+    SampleBatch *_batch;
+    DutyCycleConfig _config;
+};
+
+#endif
@@ -0,0 +1,40 @@
+#include "SampleBatch.h"
+#include <string.h>
+
+// Arredonda e satura no intervalo do campo
+static int32_t scaled(float value, float scale, int32_t lo, int32_t hi)
+{
+    if (value != value) // NaN
+        return 0;
+    float q = value * scale;
+    q += (q >= 0) ? 0.5f : -0.5f;
+    if (q > hi)
+        return hi;
+    if (q < lo)
+        return lo;
+    return (int32_t)q;
+}
+
+void batchRecordFromSample(const StationSample &sample, uint32_t stationSec, BatchRecord &out)
+{
+    memset(&out, 0, sizeof(out));
+    out.stationSec = stationSec;
+    out.temp = scaled(sample.temp, 100.0f, -32768, 32767);
+    out.hum = scaled(sample.hum, 100.0f, 0, 65535);
+    out.pres = scaled(sample.pres, 10.0f, 0, 65535);
+    out.uv = scaled(sample.uv, 1000.0f, 0, 65535);
+    out.lumens = sample.lumens < 0 ? 0 : (sample.lumens > 65535 ? 65535 : sample.lumens);
+    out.flags = (sample.bmeOk ? BATCH_FLAG_BME_OK : 0) | (sample.alarm ? BATCH_FLAG_ALARM : 0);
+}
+
+void batchRecordToSample(const BatchRecord &record, StationSample &out)
+{
+    memset(&out, 0, sizeof(out));
+    out.temp = record.temp / 100.0f;
+    out.hum = record.hum / 100.0f;
+    out.pres = record.pres / 10.0f;
+    out.uv = record.uv / 1000.0f;
+    out.lumens = record.lumens;
+    out.bmeOk = (record.flags & BATCH_FLAG_BME_OK) ? 1 : 0;
+    out.alarm = (record.flags & BATCH_FLAG_ALARM) ? 1 : 0;
+}
@@ -0,0 +1,59 @@
+#ifndef SAMPLEBATCH_H
+#define SAMPLEBATCH_H
+
+#include <stdint.h>
+#include "StationSample.h"
+
+// Registros guardados na memória RTC (16 bytes cada, ~1.9 KB dos 8 KB)
+#define BATCH_CAPACITY 120
+
+// Bits de BatchRecord::flags
+#define BATCH_FLAG_BME_OK 0x01
+#define BATCH_FLAG_ALARM 0x02
+
+/**
+ * @brief Uma amostra compacta, em inteiros com escala fixa
+ */
+struct BatchRecord
+{
+    uint32_t stationSec; // Tempo da estação (ver SampleBatch::stationMs)
+    int16_t temp;        // 0.01 C
+    uint16_t hum;        // 0.01 %
+    uint16_t pres;       // 0.1 hPa
+    uint16_t uv;         // µW/cm^2
+    uint16_t lumens;     // Lux
+    uint8_t flags;
+    uint8_t reserved;
+};
+
+/**
+ * @brief Lote de amostras que sobrevive ao light/deep sleep
+ *
+ * Fica em RTC_DATA_ATTR no firmware. O magic distingue um lote válido de
+ * lixo após perda de energia; stationMs é o relógio da estação, que soma o
+ * tempo acordado e o tempo dormindo (millis() recomeça a cada despertar).
+ */
+struct SampleBatch
+{
+    uint32_t magic;
+    uint32_t stationMs;
+    uint32_t wakeCount;
+    uint32_t uploadCount;
+    uint16_t count;
+    uint16_t dropped;     // Amostras perdidas com o lote cheio
+    uint8_t alarmLatched; // Alarme já avisado (só um novo alarme liga o WiFi)
+    uint8_t reserved[3];
+    BatchRecord records[BATCH_CAPACITY];
+};
+
+/**
+ * @brief Compacta uma amostra para o lote
+ */
+void batchRecordFromSample(const StationSample &sample, uint32_t stationSec, BatchRecord &out);
+
+/**
+ * @brief Reconstrói a amostra de um registro (seq e timestampMs ficam zerados)
+ */
+void batchRecordToSample(const BatchRecord &record, StationSample &out);
+
+#endif
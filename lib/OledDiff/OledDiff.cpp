@@ -0,0 +1,30 @@
+#include "OledDiff.h"
+
+uint8_t computeDirtySpans(const uint8_t *prev, const uint8_t *cur, uint8_t width, uint8_t pages, DirtySpan *out)
+{
+    uint8_t count = 0;
+
+    for (uint8_t page = 0; page < pages; page++)
+    {
+        const uint8_t *a = prev + page * width;
+        const uint8_t *b = cur + page * width;
+
+        // Procura a primeira diferença a partir da esquerda...
+        int start = 0;
+        while (start < width && a[start] == b[start])
+            start++;
+        if (start == width)
+            continue;
+
+        // ...e a última a partir da direita
+        int end = width - 1;
+        while (end > start && a[end] == b[end])
+            end--;
+
+        out[count].page = page;
+        out[count].colStart = start;
+        out[count].colEnd = end;
+        count++;
+    }
+    return count;
+}
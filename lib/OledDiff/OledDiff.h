@@ -0,0 +1,31 @@
+#ifndef OLEDDIFF_H
+#define OLEDDIFF_H
+
+#include <stdint.h>
+
+/**
+ * @brief Trecho alterado de uma página do SSD1306 (8 linhas de pixels)
+ */
+struct DirtySpan
+{
+    uint8_t page;     // Página (0 a pages-1)
+    uint8_t colStart; // Primeira coluna alterada
+    uint8_t colEnd;   // Última coluna alterada (inclusive)
+};
+
+/**
+ * @brief Compara dois framebuffers no layout do SSD1306 (página a página)
+ *
+ * Para cada página com diferença, gera um único trecho cobrindo da
+ * primeira à última coluna alterada.
+ *
+ * @param prev Quadro enviado anteriormente
+ * @param cur Quadro novo
+ * @param width Largura em pixels (colunas)
+ * @param pages Quantidade de páginas (altura / 8)
+ * @param out Destino com espaço para 'pages' trechos
+ * @return Quantidade de trechos gerados (0 = quadros idênticos)
+ */
+uint8_t computeDirtySpans(const uint8_t *prev, const uint8_t *cur, uint8_t width, uint8_t pages, DirtySpan *out);
+
+#endif
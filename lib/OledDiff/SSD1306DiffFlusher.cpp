@@ -0,0 +1,114 @@
+#include "SSD1306DiffFlusher.h"
+#include <string.h>
+
+// Mesmo tamanho de bloco do Adafruit_SSD1306 (buffer do Wire em AVR/ESP)
+static const uint8_t I2C_CHUNK = 32;
+
+// Bytes que um display() completo do Adafruit transmite:
+// comandos de janela + 1024 bytes de dados + byte de controle a cada bloco
+static const uint32_t FULL_FRAME_BYTES = 7 + SSD1306DiffFlusher::WIDTH * SSD1306DiffFlusher::PAGES +
+                                         (SSD1306DiffFlusher::WIDTH * SSD1306DiffFlusher::PAGES + I2C_CHUNK - 2) / (I2C_CHUNK - 1);
+
+SSD1306DiffFlusher::SSD1306DiffFlusher(HalI2C &bus, uint8_t address)
+{
+    _bus = &bus;
+    _address = address;
+    _valid = false;
+    _totalBytes = 0;
+
+    _windowStart = 0;
+    _winBytes = _winBusyUs = _winFull = _winFlushes = 0;
+    _bytesPerSec = _busyUsPerSec = _fullPerSec = _flushesPerSec = 0;
+}
+
+uint32_t SSD1306DiffFlusher::sendSpan(const uint8_t *frame, const DirtySpan &span)
+{
+    uint32_t bytes = 0;
+
+    // Janela de escrita: colunas [start, end] da página
+    const uint8_t window[] = {
+        0x00, // Co = 0, D/C = 0: sequência de comandos
+        0x21, // COLUMNADDR
+        span.colStart,
+        span.colEnd,
+        0x22, // PAGEADDR
+        span.page,
+        span.page,
+    };
+    _bus->write(_address, window, sizeof(window));
+    bytes += sizeof(window);
+
+    // Dados em blocos, cada um com seu byte de controle
+    const uint8_t *data = frame + span.page * WIDTH + span.colStart;
+    uint16_t remaining = span.colEnd - span.colStart + 1;
+    uint8_t chunk[I2C_CHUNK];
+    chunk[0] = 0x40; // D/C = 1: dados
+    while (remaining > 0)
+    {
+        uint8_t n = (remaining > I2C_CHUNK - 1) ? I2C_CHUNK - 1 : remaining;
+        memcpy(chunk + 1, data, n);
+        _bus->write(_address, chunk, n + 1);
+
+        data += n;
+        remaining -= n;
+        bytes += n + 1;
+    }
+    return bytes;
+}
+
+uint32_t SSD1306DiffFlusher::flush(const uint8_t *frame)
+{
+    HalClock &clock = Hal::clock();
+    uint32_t start = clock.micros();
+
+    DirtySpan spans[PAGES];
+    uint8_t count;
+    if (_valid)
+    {
+        count = computeDirtySpans(_shadow, frame, WIDTH, PAGES, spans);
+    }
+    else
+    {
+        // Sem quadro de referência: todas as páginas inteiras
+        for (uint8_t p = 0; p < PAGES; p++)
+        {
+            spans[p].page = p;
+            spans[p].colStart = 0;
+            spans[p].colEnd = WIDTH - 1;
+        }
+        count = PAGES;
+    }
+
+    uint32_t bytes = 0;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        bytes += sendSpan(frame, spans[i]);
+        memcpy(_shadow + spans[i].page * WIDTH + spans[i].colStart,
+               frame + spans[i].page * WIDTH + spans[i].colStart,
+               spans[i].colEnd - spans[i].colStart + 1);
+    }
+    _valid = true;
+
+    _totalBytes += bytes;
+    updateWindow(bytes, clock.micros() - start);
+    return bytes;
+}
+
+void SSD1306DiffFlusher::updateWindow(uint32_t bytes, uint32_t busyUs)
+{
+    uint32_t now = Hal::clock().millis();
+    if (now - _windowStart >= 1000)
+    {
+        _bytesPerSec = _winBytes;
+        _busyUsPerSec = _winBusyUs;
+        _fullPerSec = _winFull;
+        _flushesPerSec = _winFlushes;
+        _winBytes = _winBusyUs = _winFull = _winFlushes = 0;
+        _windowStart = now;
+    }
+
+    _winBytes += bytes;
+    _winBusyUs += busyUs;
+    _winFull += FULL_FRAME_BYTES;
+    _winFlushes++;
+}
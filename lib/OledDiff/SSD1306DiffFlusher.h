@@ -0,0 +1,61 @@
+#ifndef SSD1306DIFFFLUSHER_H
+#define SSD1306DIFFFLUSHER_H
+
+#include "Hal.h"
+#include "OledDiff.h"
+
+/**
+ * @brief Envia ao SSD1306 apenas as regiões alteradas do framebuffer
+ *
+ * Guarda uma cópia do último quadro enviado. A cada flush() compara
+ * página a página e envia somente o intervalo de colunas alterado de cada
+ * página. Quadro idêntico = nenhum byte no I2C.
+ *
+ * Substitui o display.display() do Adafruit_SSD1306 (que sempre envia 1 KB).
+ * Requer o modo de endereçamento horizontal, que o Adafruit configura no begin().
+ */
+class SSD1306DiffFlusher
+{
+public:
+    static const uint8_t WIDTH = 128;
+    static const uint8_t PAGES = 8; // 64 linhas / 8
+
+    SSD1306DiffFlusher(HalI2C &bus, uint8_t address = 0x3C);
+
+    /**
+     * @brief Envia as diferenças entre o quadro novo e o último enviado
+     * @param frame Framebuffer (display.getBuffer()), 128 x 64 / 8 bytes
+     * @return Bytes transmitidos no I2C
+     */
+    uint32_t flush(const uint8_t *frame);
+
+    /**
+     * @brief Força o próximo flush() a enviar o quadro inteiro
+     */
+    void invalidate() { _valid = false; }
+
+    // --- Estatísticas (janela de 1 segundo) ---
+    uint32_t bytesPerSec() const { return _bytesPerSec; }       // Bytes I2C enviados
+    uint32_t busyUsPerSec() const { return _busyUsPerSec; }     // Tempo gasto no I2C
+    uint32_t fullBytesPerSec() const { return _fullPerSec; }    // Equivalente com display()
+    uint32_t flushesPerSec() const { return _flushesPerSec; }
+    uint32_t totalBytes() const { return _totalBytes; }
+
+private:
+    HalI2C *_bus;
+    uint8_t _address;
+    uint8_t _shadow[WIDTH * PAGES];
+    bool _valid;
+
+    uint32_t _totalBytes;
+
+    // Acumuladores da janela corrente
+    uint32_t _windowStart;
+    uint32_t _winBytes, _winBusyUs, _winFull, _winFlushes;
+    uint32_t _bytesPerSec, _busyUsPerSec, _fullPerSec, _flushesPerSec;
+
+    uint32_t sendSpan(const uint8_t *frame, const DirtySpan &span);
+    void updateWindow(uint32_t bytes, uint32_t busyUs);
+};
+
+#endif
@@ -0,0 +1,191 @@
+#include "LogExportStream.h"
+#include <math.h>
+#include <string.h>
+#include "JsonWriter.h"
+
+static const char CSV_HEADER[] = "seq,time,station_s,temp_c,hum_pct,pres_hpa,uv_mw_cm2,lux,bme_ok,alarm\n";
+
+// Inteiro com escala fixa (ex: 2341 com 2 casas -> "23.41"), sem passar por float
+static size_t formatScaled(int32_t value, uint8_t decimals, char *out)
+{
+    static const uint32_t POW10[] = {1, 10, 100, 1000};
+    size_t n = 0;
+    uint32_t units = value < 0 ? (uint32_t)(-(int64_t)value) : (uint32_t)value;
+    if (value < 0)
+        out[n++] = '-';
+    n += formatUnsigned(units / POW10[decimals], out + n);
+    if (decimals > 0)
+    {
+        out[n++] = '.';
+        for (uint8_t d = decimals; d > 0; d--)
+            out[n++] = '0' + (units / POW10[d - 1]) % 10;
+    }
+    return n;
+}
+
+LogExportStream::LogExportStream(SampleLog &log, uint32_t fromUnix, uint32_t toUnix, LogExportFormat format)
+{
+    _log = &log;
+    _from = fromUnix;
+    _to = toUnix;
+    _format = format;
+    _nextSeq = fromUnix > 0 ? log.seekTime(fromUnix) : log.firstSeq();
+    _endSeq = log.nextSeq();
+    _headerDone = (format != LOG_EXPORT_CSV);
+    _done = false;
+    _count = 0;
+    _pos = 0;
+    _exported = 0;
+    _skipped = 0;
+}
+
+bool LogExportStream::parseFormat(const char *text, LogExportFormat &format)
+{
+    if (strcmp(text, "csv") == 0)
+        format = LOG_EXPORT_CSV;
+    else if (strcmp(text, "ndjson") == 0)
+        format = LOG_EXPORT_NDJSON;
+    else
+        return false;
+    return true;
+}
+
+const char *LogExportStream::contentType(LogExportFormat format)
+{
+    return format == LOG_EXPORT_CSV ? "text/csv" : "application/x-ndjson";
+}
+
+bool LogExportStream::refill()
+{
+    _count = 0;
+    _pos = 0;
+    while (_count == 0 && _nextSeq < _endSeq)
+    {
+        uint16_t max = LOG_EXPORT_READ_BATCH;
+        if (_endSeq - _nextSeq < max)
+            max = _endSeq - _nextSeq;
+        _count = _log->read(_nextSeq, _records, max);
+        if (_count == 0)
+        {
+            // CRC inválido (ou leitura falhou): pula o registro
+            _skipped++;
+            _nextSeq++;
+        }
+        else
+        {
+            // read() avança até o primeiro registro guardado se a rotação apagou o começo
+            _nextSeq = _records[_count - 1].seq + 1;
+        }
+    }
+    return _count > 0;
+}
+
+size_t LogExportStream::formatRecord(const LogRecord &record, char *out, size_t size) const
+{
+    const BatchRecord &s = record.sample;
+    bool bme = (s.flags & BATCH_FLAG_BME_OK) != 0;
+    bool alarm = (s.flags & BATCH_FLAG_ALARM) != 0;
+
+    if (_format == LOG_EXPORT_NDJSON)
+    {
+        JsonWriter w(out, size);
+        w.beginObject();
+        w.field("seq", record.seq);
+        w.key("time");
+        if (record.unixTime)
+            w.uinteger(record.unixTime);
+        else
+            w.fixed(NAN, 0); // null
+        w.field("st", s.stationSec);
+        w.field("t", bme ? s.temp / 100.0f : NAN, 2);
+        w.field("h", bme ? s.hum / 100.0f : NAN, 2);
+        w.field("p", bme ? s.pres / 10.0f : NAN, 1);
+        w.field("u", s.uv / 1000.0f, 3);
+        w.field("l", (uint32_t)s.lumens);
+        w.field("ok", bme);
+        w.field("alarm", alarm);
+        w.endObject();
+        w.raw("\n");
+        return w.overflow() ? 0 : w.length();
+    }
+
+    // CSV: a linha mais longa tem ~75 caracteres
+    if (size < 96)
+        return 0;
+    size_t n = formatUnsigned(record.seq, out);
+    out[n++] = ',';
+    if (record.unixTime)
+        n += formatUnsigned(record.unixTime, out + n);
+    out[n++] = ',';
+    n += formatUnsigned(s.stationSec, out + n);
+    out[n++] = ',';
+    if (bme)
+        n += formatScaled(s.temp, 2, out + n);
+    out[n++] = ',';
+    if (bme)
+        n += formatScaled(s.hum, 2, out + n);
+    out[n++] = ',';
+    if (bme)
+        n += formatScaled(s.pres, 1, out + n);
+    out[n++] = ',';
+    n += formatScaled(s.uv, 3, out + n);
+    out[n++] = ',';
+    n += formatUnsigned(s.lumens, out + n);
+    out[n++] = ',';
+    out[n++] = bme ? '1' : '0';
+    out[n++] = ',';
+    out[n++] = alarm ? '1' : '0';
+    out[n++] = '\n';
+    return n;
+}
+
+size_t LogExportStream::fill(uint8_t *buffer, size_t maxLen)
+{
+    size_t len = 0;
+    char line[160];
+
+    if (!_headerDone)
+    {
+        if (maxLen < sizeof(CSV_HEADER) - 1)
+            return RESPONSE_TRY_AGAIN;
+        memcpy(buffer, CSV_HEADER, sizeof(CSV_HEADER) - 1);
+        len = sizeof(CSV_HEADER) - 1;
+        _headerDone = true;
+    }
+
+    while (!_done)
+    {
+        if (_pos >= _count && !refill())
+        {
+            _done = true;
+            break;
+        }
+
+        const LogRecord &record = _records[_pos];
+        if (record.unixTime != 0 && record.unixTime > _to)
+        {
+            // O log está em ordem de tempo: nada depois disso entra
+            _done = true;
+            break;
+        }
+        if (record.unixTime < _from)
+        {
+            _pos++;
+            continue;
+        }
+
+        // Cada linha vai inteira ou fica para o próximo pedaço
+        size_t n = formatRecord(record, line, sizeof(line));
+        if (len + n > maxLen)
+            break;
+        memcpy(buffer + len, line, n);
+        len += n;
+        _pos++;
+        _exported++;
+    }
+
+    // Nem a próxima linha coube (janela TCP apertada): 0 encerraria a resposta
+    if (len == 0 && !_done)
+        return RESPONSE_TRY_AGAIN;
+    return len;
+}
@@ -0,0 +1,88 @@
+#ifndef LOGEXPORTSTREAM_H
+#define LOGEXPORTSTREAM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "SampleLog.h"
+#include "JsonWriter.h" // RESPONSE_TRY_AGAIN
+
+// Registros lidos da flash por vez (448 bytes)
+#define LOG_EXPORT_READ_BATCH 16
+
+enum LogExportFormat
+{
+    LOG_EXPORT_CSV = 0,
+    LOG_EXPORT_NDJSON
+};
+
+/**
+ * @brief Exporta um intervalo do SampleLog em CSV ou NDJSON, em pedaços
+ *
+ * Mesmo contrato do HistoryJsonStream: cada fill() escreve linhas inteiras
+ * até maxLen bytes, lendo os registros direto do log em blocos de
+ * LOG_EXPORT_READ_BATCH. A memória usada é só o próprio objeto, qualquer
+ * que seja o intervalo pedido.
+ *
+ * O fim do intervalo é o nextSeq() da criação: amostras novas não alongam
+ * a exportação. Registros com CRC inválido são pulados e contados; se a
+ * rotação apagar o começo no meio do caminho, a leitura segue do primeiro
+ * registro ainda guardado.
+ *
+ * CSV:    seq,time,station_s,temp_c,hum_pct,pres_hpa,uv_mw_cm2,lux,bme_ok,alarm
+ * NDJSON: {"seq":1,"time":1700000000,"st":60,"t":23.41,"h":61.20,"p":1013.2,
+ *          "u":0.123,"l":456,"ok":true,"alarm":false}
+ * "time" é a hora UTC (vazio/null se o relógio não estava acertado); sem
+ * BME280 os campos de clima saem vazios/null.
+ *
+ * fill() lê o log: quem compartilha o SampleLog trava em volta da chamada.
+ */
+class LogExportStream
+{
+public:
+    /**
+     * @param log Log de origem
+     * @param fromUnix Primeira hora UTC desejada (0 = desde o começo, inclui registros sem hora)
+     * @param toUnix Última hora UTC desejada
+     */
+    LogExportStream(SampleLog &log, uint32_t fromUnix, uint32_t toUnix, LogExportFormat format);
+
+    /**
+     * @brief Escreve o próximo pedaço
+     * @return Bytes escritos; 0 quando terminou; RESPONSE_TRY_AGAIN se o
+     * próximo item não cabe em maxLen (a resposta continua)
+     */
+    size_t fill(uint8_t *buffer, size_t maxLen);
+
+    /**
+     * @brief Converte "csv" ou "ndjson" em formato
+     */
+    static bool parseFormat(const char *text, LogExportFormat &format);
+
+    static const char *contentType(LogExportFormat format);
+
+    // Contadores desde a criação
+    uint32_t exported() const { return _exported; }
+    uint32_t skipped() const { return _skipped; }
+
+private:
+    SampleLog *_log;
+    uint32_t _from;
+    uint32_t _to;
+    LogExportFormat _format;
+    uint32_t _nextSeq; // Próximo registro a ler
+    uint32_t _endSeq;
+    bool _headerDone;
+    bool _done;
+
+    LogRecord _records[LOG_EXPORT_READ_BATCH];
+    uint16_t _count; // Registros em _records
+    uint16_t _pos;   // Próximo registro de _records a escrever
+
+    uint32_t _exported;
+    uint32_t _skipped;
+
+    bool refill();
+    size_t formatRecord(const LogRecord &record, char *out, size_t size) const;
+};
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef LOGSTORAGE_H
+#define LOGSTORAGE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Chamado para cada arquivo de um diretório (só o nome, sem o caminho)
+typedef void (*LogListFn)(const char *name, void *ctx);
+
+/**
+ * @brief Sistema de arquivos mínimo usado pelo SampleLog
+ *
+ * Operações por caminho, sem manter arquivos abertos: cada chamada abre,
+ * faz o trabalho e fecha (o fechamento grava os metadados no LittleFS).
+ * No ESP32 é o LittleFsLogStorage; no host, RamLogStorage ou FileLogStorage.
+ */
+class LogStorage
+{
+public:
+    virtual ~LogStorage() {}
+
+    /**
+     * @brief Acrescenta bytes ao fim do arquivo (cria se não existir)
+     * @return false se nem todos os bytes foram gravados
+     */
+    virtual bool append(const char *path, const void *data, size_t len) = 0;
+
+    /**
+     * @brief Lê exatamente len bytes a partir de offset
+     */
+    virtual bool readAt(const char *path, uint32_t offset, void *data, size_t len) = 0;
+
+    /**
+     * @brief Tamanho do arquivo em bytes, ou -1 se não existe
+     */
+    virtual int32_t fileSize(const char *path) = 0;
+
+    virtual bool remove(const char *path) = 0;
+
+    /**
+     * @brief Garante que o diretório existe
+     */
+    virtual bool makeDir(const char *path) = 0;
+
+    /**
+     * @brief Lista os arquivos de um diretório
+     * @return Quantidade de arquivos listados
+     */
+    virtual uint16_t list(const char *dir, LogListFn fn, void *ctx) = 0;
+};
+
+#endif
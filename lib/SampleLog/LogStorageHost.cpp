@@ -0,0 +1,131 @@
+#include "LogStorageHost.h"
+
+#ifndef ARDUINO
+#include <dirent.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+// --- RamLogStorage ---
+
+bool RamLogStorage::append(const char *path, const void *data, size_t len)
+{
+    _appends++;
+    std::vector<uint8_t> &file = _files[path];
+    const uint8_t *bytes = (const uint8_t *)data;
+
+    if (_cut >= 0)
+    {
+        size_t partial = (size_t)_cut < len ? (size_t)_cut : len;
+        file.insert(file.end(), bytes, bytes + partial);
+        _cut = -1;
+        return false;
+    }
+    file.insert(file.end(), bytes, bytes + len);
+    return true;
+}
+
+bool RamLogStorage::readAt(const char *path, uint32_t offset, void *data, size_t len)
+{
+    _reads++;
+    auto it = _files.find(path);
+    if (it == _files.end() || offset + len > it->second.size())
+        return false;
+    memcpy(data, it->second.data() + offset, len);
+    return true;
+}
+
+int32_t RamLogStorage::fileSize(const char *path)
+{
+    auto it = _files.find(path);
+    return it == _files.end() ? -1 : (int32_t)it->second.size();
+}
+
+bool RamLogStorage::remove(const char *path)
+{
+    return _files.erase(path) > 0;
+}
+
+uint16_t RamLogStorage::list(const char *dir, LogListFn fn, void *ctx)
+{
+    _lists++;
+    std::string prefix = std::string(dir) + "/";
+    uint16_t count = 0;
+    for (auto &entry : _files)
+    {
+        const std::string &name = entry.first;
+        if (name.compare(0, prefix.size(), prefix) == 0 && name.find('/', prefix.size()) == std::string::npos)
+        {
+            fn(name.c_str() + prefix.size(), ctx);
+            count++;
+        }
+    }
+    return count;
+}
+
+void RamLogStorage::corrupt(const char *path, uint32_t offset)
+{
+    auto it = _files.find(path);
+    if (it != _files.end() && offset < it->second.size())
+        it->second[offset] ^= 0x01;
+}
+
+// --- FileLogStorage ---
+
+bool FileLogStorage::append(const char *path, const void *data, size_t len)
+{
+    FILE *f = fopen(full(path).c_str(), "ab");
+    if (!f)
+        return false;
+    size_t written = fwrite(data, 1, len, f);
+    return (fclose(f) == 0) && written == len;
+}
+
+bool FileLogStorage::readAt(const char *path, uint32_t offset, void *data, size_t len)
+{
+    FILE *f = fopen(full(path).c_str(), "rb");
+    if (!f)
+        return false;
+    bool ok = fseek(f, offset, SEEK_SET) == 0 && fread(data, 1, len, f) == len;
+    fclose(f);
+    return ok;
+}
+
+int32_t FileLogStorage::fileSize(const char *path)
+{
+    struct stat st;
+    if (stat(full(path).c_str(), &st) != 0)
+        return -1;
+    return (int32_t)st.st_size;
+}
+
+bool FileLogStorage::remove(const char *path)
+{
+    return ::remove(full(path).c_str()) == 0;
+}
+
+bool FileLogStorage::makeDir(const char *path)
+{
+    // Cria a raiz e o diretório pedido (um nível abaixo dela)
+    mkdir(_root.c_str(), 0755);
+    return mkdir(full(path).c_str(), 0755) == 0 || errno == EEXIST;
+}
+
+uint16_t FileLogStorage::list(const char *dir, LogListFn fn, void *ctx)
+{
+    DIR *d = opendir(full(dir).c_str());
+    if (!d)
+        return 0;
+    uint16_t count = 0;
+    for (struct dirent *e = readdir(d); e; e = readdir(d))
+    {
+        if (e->d_name[0] == '.')
+            continue;
+        fn(e->d_name, ctx);
+        count++;
+    }
+    closedir(d);
+    return count;
+}
+#endif
@@ -0,0 +1,75 @@
+#ifndef LOGSTORAGEHOST_H
+#define LOGSTORAGEHOST_H
+
+#include "LogStorage.h"
+
+#ifndef ARDUINO
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief LogStorage em memória para o host, com queda de energia simulada
+ *
+ * cutNextAppend(n) faz a próxima escrita gravar só n bytes e falhar, como
+ * uma queda de energia no meio da escrita (o pior caso; no LittleFS real a
+ * escrita some inteira).
+ */
+class RamLogStorage : public LogStorage
+{
+public:
+    RamLogStorage() : _cut(-1), _appends(0), _reads(0), _lists(0) {}
+
+    bool append(const char *path, const void *data, size_t len) override;
+    bool readAt(const char *path, uint32_t offset, void *data, size_t len) override;
+    int32_t fileSize(const char *path) override;
+    bool remove(const char *path) override;
+    bool makeDir(const char *) override { return true; }
+    uint16_t list(const char *dir, LogListFn fn, void *ctx) override;
+
+    void cutNextAppend(size_t bytes) { _cut = (long)bytes; }
+
+    /**
+     * @brief Corrompe um byte de um arquivo (bit flip)
+     */
+    void corrupt(const char *path, uint32_t offset);
+
+    uint32_t appends() const { return _appends; }
+    uint32_t reads() const { return _reads; }
+    uint32_t lists() const { return _lists; }
+
+private:
+    std::map<std::string, std::vector<uint8_t>> _files;
+    long _cut;
+    uint32_t _appends;
+    uint32_t _reads;
+    uint32_t _lists;
+};
+
+/**
+ * @brief LogStorage em arquivos de verdade no host, sob um diretório raiz
+ *
+ * Cada operação abre e fecha o arquivo, como no LittleFsLogStorage.
+ */
+class FileLogStorage : public LogStorage
+{
+public:
+    /**
+     * @param root Diretório do host que faz o papel da raiz do LittleFS
+     */
+    FileLogStorage(const char *root) : _root(root) {}
+
+    bool append(const char *path, const void *data, size_t len) override;
+    bool readAt(const char *path, uint32_t offset, void *data, size_t len) override;
+    int32_t fileSize(const char *path) override;
+    bool remove(const char *path) override;
+    bool makeDir(const char *path) override;
+    uint16_t list(const char *dir, LogListFn fn, void *ctx) override;
+
+private:
+    std::string _root;
+    std::string full(const char *path) const { return _root + path; }
+};
+#endif
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef LOGSTORAGELITTLEFS_H
+#define LOGSTORAGELITTLEFS_H
+
+#include <string.h>
+#include "LogStorage.h"
+
+#ifdef ARDUINO
+#include <LittleFS.h>
+
+/**
+ * @brief LogStorage sobre o LittleFS do ESP32 (LittleFS.begin() antes de usar)
+ *
+ * O LittleFS é copy-on-write: uma escrita interrompida por queda de energia
+ * some inteira no próximo boot, e os metadados continuam consistentes.
+ */
+class LittleFsLogStorage : public LogStorage
+{
+public:
+    bool append(const char *path, const void *data, size_t len) override
+    {
+        File f = LittleFS.open(path, FILE_APPEND);
+        if (!f)
+            return false;
+        size_t written = f.write((const uint8_t *)data, len);
+        f.close();
+        return written == len;
+    }
+
+    bool readAt(const char *path, uint32_t offset, void *data, size_t len) override
+    {
+        File f = LittleFS.open(path, FILE_READ);
+        if (!f)
+            return false;
+        bool ok = f.seek(offset) && f.read((uint8_t *)data, len) == len;
+        f.close();
+        return ok;
+    }
+
+    int32_t fileSize(const char *path) override
+    {
+        File f = LittleFS.open(path, FILE_READ);
+        if (!f)
+            return -1;
+        int32_t size = f.size();
+        f.close();
+        return size;
+    }
+
+    bool remove(const char *path) override { return LittleFS.remove(path); }
+
+    bool makeDir(const char *path) override { return LittleFS.exists(path) || LittleFS.mkdir(path); }
+
+    uint16_t list(const char *dir, LogListFn fn, void *ctx) override
+    {
+        File d = LittleFS.open(dir);
+        if (!d || !d.isDirectory())
+            return 0;
+        uint16_t count = 0;
+        for (File f = d.openNextFile(); f; f = d.openNextFile())
+        {
+            // Conforme a versão do core, name() pode trazer o caminho
+            const char *name = f.name();
+            const char *slash = strrchr(name, '/');
+            fn(slash ? slash + 1 : name, ctx);
+            count++;
+        }
+        return count;
+    }
+};
+#endif
+
+#endif
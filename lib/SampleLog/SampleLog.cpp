@@ -0,0 +1,311 @@
+#include "SampleLog.h"
+#include <stdio.h>
+#include <string.h>
+
+static const size_t REC = sizeof(LogRecord);
+static const size_t CRC_LEN = offsetof(LogRecord, crc);
+
+SampleLog::SampleLog(LogStorage &storage, const char *dir, const SampleLogConfig &config)
+{
+    _storage = &storage;
+    _dir = dir;
+    _config = config;
+    if (_config.batchRecords < 1)
+        _config.batchRecords = 1;
+    if (_config.batchRecords > SAMPLE_LOG_MAX_BATCH)
+        _config.batchRecords = SAMPLE_LOG_MAX_BATCH;
+    if (_config.segmentRecords < 1)
+        _config.segmentRecords = 1;
+    if (_config.maxSegments < 2)
+        _config.maxSegments = 2;
+    if (_config.maxSegments > SAMPLE_LOG_MAX_SEGMENTS)
+        _config.maxSegments = SAMPLE_LOG_MAX_SEGMENTS;
+
+    _segCount = 0;
+    _tailRecords = 0;
+    _tailClosed = false;
+    _persistedSeq = 0;
+    _pending = 0;
+    _batchStartMs = 0;
+    _flushes = 0;
+    _bytesWritten = 0;
+    _dropped = 0;
+    _recoveredTorn = 0;
+    _recoveryReads = 0;
+}
+
+uint32_t SampleLog::crc32(const void *data, size_t len)
+{
+    // CRC-32 (IEEE) bit a bit: 28 bytes por registro não justificam uma tabela de 1 KB
+    const uint8_t *p = (const uint8_t *)data;
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < len; i++)
+    {
+        crc ^= p[i];
+        for (int b = 0; b < 8; b++)
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+    }
+    return ~crc;
+}
+
+void SampleLog::segmentPath(uint32_t start, char *path) const
+{
+    snprintf(path, SAMPLE_LOG_PATH_MAX, "%s/%08lx", _dir, (unsigned long)start);
+}
+
+bool SampleLog::validRecord(const LogRecord &record, uint32_t seq) const
+{
+    return record.seq == seq && record.crc == crc32(&record, CRC_LEN);
+}
+
+void SampleLog::onListEntry(const char *name, void *ctx)
+{
+    SampleLog *log = (SampleLog *)ctx;
+
+    // Só nomes de segmento: exatamente 8 dígitos hex
+    uint32_t start = 0;
+    for (int i = 0; i < 8; i++)
+    {
+        char c = name[i];
+        uint32_t digit;
+        if (c >= '0' && c <= '9')
+            digit = c - '0';
+        else if (c >= 'a' && c <= 'f')
+            digit = c - 'a' + 10;
+        else
+            return;
+        start = (start << 4) | digit;
+    }
+    if (name[8] != '\0')
+        return;
+    log->insertSegment(start);
+}
+
+void SampleLog::insertSegment(uint32_t start)
+{
+    // Tabela cheia: fica com os mais novos
+    if (_segCount >= SAMPLE_LOG_MAX_SEGMENTS)
+    {
+        char path[SAMPLE_LOG_PATH_MAX];
+        if (start < _segStart[0])
+        {
+            segmentPath(start, path);
+            _storage->remove(path);
+            return;
+        }
+        dropOldestSegment();
+    }
+
+    // Inserção ordenada (a listagem do diretório não tem ordem garantida)
+    uint8_t i = _segCount;
+    while (i > 0 && _segStart[i - 1] > start)
+    {
+        _segStart[i] = _segStart[i - 1];
+        i--;
+    }
+    _segStart[i] = start;
+    _segCount++;
+}
+
+void SampleLog::dropOldestSegment()
+{
+    if (_segCount == 0)
+        return;
+    char path[SAMPLE_LOG_PATH_MAX];
+    segmentPath(_segStart[0], path);
+    _storage->remove(path);
+    memmove(_segStart, _segStart + 1, (_segCount - 1) * sizeof(_segStart[0]));
+    _segCount--;
+}
+
+bool SampleLog::begin()
+{
+    _segCount = 0;
+    _tailRecords = 0;
+    _tailClosed = false;
+    _persistedSeq = 0;
+    _pending = 0;
+    _recoveredTorn = 0;
+    _recoveryReads = 0;
+
+    if (!_storage->makeDir(_dir))
+        return false;
+    _storage->list(_dir, onListEntry, this);
+    while (_segCount > _config.maxSegments)
+        dropOldestSegment();
+
+    // Só o segmento mais novo pode ter um final incompleto
+    char path[SAMPLE_LOG_PATH_MAX];
+    while (_segCount > 0)
+    {
+        uint32_t start = _segStart[_segCount - 1];
+        segmentPath(start, path);
+        int32_t size = _storage->fileSize(path);
+        uint32_t records = size > 0 ? size / REC : 0;
+        bool torn = size > 0 && (size % REC) != 0;
+        if (torn)
+            _recoveredTorn++;
+
+        // Do fim para o começo até o primeiro registro válido (normalmente o último)
+        uint32_t valid = records;
+        while (valid > 0)
+        {
+            LogRecord record;
+            _recoveryReads++;
+            if (_storage->readAt(path, (valid - 1) * REC, &record, REC) && validRecord(record, start + valid - 1))
+                break;
+            valid--;
+            _recoveredTorn++;
+            torn = true;
+        }
+
+        if (valid == 0)
+        {
+            // Nada aproveitável: o segmento some e o anterior vira o mais novo
+            _storage->remove(path);
+            _segCount--;
+            continue;
+        }
+
+        _tailRecords = valid;
+        _tailClosed = torn;
+        _persistedSeq = start + valid;
+        return true;
+    }
+    return true;
+}
+
+bool SampleLog::openSegment(uint32_t start)
+{
+    char path[SAMPLE_LOG_PATH_MAX];
+
+    // Mesmo início do segmento atual = ele não tem nada válido; recomeça o arquivo
+    if (_segCount > 0 && _segStart[_segCount - 1] == start)
+    {
+        segmentPath(start, path);
+        _storage->remove(path);
+        _segCount--;
+    }
+    if (_segCount >= _config.maxSegments)
+        dropOldestSegment();
+
+    _segStart[_segCount++] = start;
+    _tailRecords = 0;
+    _tailClosed = false;
+    return true;
+}
+
+bool SampleLog::append(uint32_t unixTime, const BatchRecord &sample, uint32_t nowMs)
+{
+    // Lote cheio porque a flash vem falhando: descarta a amostra nova
+    if (_pending >= SAMPLE_LOG_MAX_BATCH && !flush())
+    {
+        _dropped++;
+        return false;
+    }
+
+    if (_pending == 0)
+        _batchStartMs = nowMs;
+
+    LogRecord &record = _batch[_pending];
+    record.seq = nextSeq();
+    record.unixTime = unixTime;
+    record.sample = sample;
+    record.crc = crc32(&record, CRC_LEN);
+    _pending++;
+
+    if (_pending >= _config.batchRecords || nowMs - _batchStartMs >= _config.maxBatchAgeMs)
+        return flush();
+    return true;
+}
+
+bool SampleLog::flush()
+{
+    char path[SAMPLE_LOG_PATH_MAX];
+    uint16_t done = 0;
+
+    while (done < _pending)
+    {
+        if (_segCount == 0 || _tailClosed || _tailRecords >= _config.segmentRecords)
+            openSegment(_persistedSeq);
+
+        uint32_t room = _config.segmentRecords - _tailRecords;
+        uint16_t n = _pending - done;
+        if (n > room)
+            n = room;
+
+        segmentPath(_segStart[_segCount - 1], path);
+        if (!_storage->append(path, &_batch[done], n * REC))
+        {
+            // Pode ter gravado uma parte: nada mais é acrescentado a esse arquivo
+            _tailClosed = true;
+            break;
+        }
+        _tailRecords += n;
+        _persistedSeq += n;
+        _bytesWritten += n * REC;
+        done += n;
+    }
+
+    if (done > 0)
+    {
+        memmove(_batch, _batch + done, (_pending - done) * REC);
+        _pending -= done;
+        _flushes++;
+    }
+    return _pending == 0;
+}
+
+uint32_t SampleLog::seekTime(uint32_t unixTime)
+{
+    char path[SAMPLE_LOG_PATH_MAX];
+    LogRecord record;
+    for (int i = (int)_segCount - 1; i >= 0; i--)
+    {
+        segmentPath(_segStart[i], path);
+        if (_storage->readAt(path, 0, &record, REC) && validRecord(record, _segStart[i]) &&
+            record.unixTime != 0 && record.unixTime <= unixTime)
+            return _segStart[i];
+    }
+    return firstSeq();
+}
+
+uint16_t SampleLog::read(uint32_t seq, LogRecord *out, uint16_t max)
+{
+    char path[SAMPLE_LOG_PATH_MAX];
+    uint16_t n = 0;
+    if (seq < firstSeq())
+        seq = firstSeq();
+
+    // Parte já gravada: leituras contíguas dentro de cada segmento
+    while (n < max && seq < _persistedSeq)
+    {
+        uint8_t i = _segCount - 1;
+        while (i > 0 && _segStart[i] > seq)
+            i--;
+        uint32_t end = (i + 1 < _segCount) ? _segStart[i + 1] : _persistedSeq;
+
+        uint32_t chunk = end - seq;
+        if (chunk > (uint32_t)(max - n))
+            chunk = max - n;
+
+        segmentPath(_segStart[i], path);
+        if (!_storage->readAt(path, (seq - _segStart[i]) * REC, &out[n], chunk * REC))
+            return n;
+        for (uint32_t k = 0; k < chunk; k++)
+        {
+            if (!validRecord(out[n], seq))
+                return n;
+            n++;
+            seq++;
+        }
+    }
+
+    // Lote ainda em RAM
+    while (n < max && seq >= _persistedSeq && seq < nextSeq())
+    {
+        out[n++] = _batch[seq - _persistedSeq];
+        seq++;
+    }
+    return n;
+}
@@ -0,0 +1,149 @@
+#ifndef SAMPLELOG_H
+#define SAMPLELOG_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "LogStorage.h"
+#include "SampleBatch.h"
+
+#define SAMPLE_LOG_MAX_BATCH 64
+#define SAMPLE_LOG_MAX_SEGMENTS 32
+#define SAMPLE_LOG_PATH_MAX 48 // Diretório + '/' + 8 dígitos hex
+
+/**
+ * @brief Registro do log em flash (28 bytes)
+ */
+struct LogRecord
+{
+    uint32_t seq;      // Número sequencial, contínuo entre segmentos
+    uint32_t unixTime; // Hora UTC da amostra (0 = relógio não acertado)
+    BatchRecord sample;
+    uint32_t crc; // CRC-32 dos campos acima
+};
+
+/**
+ * @brief Tamanho dos lotes e dos segmentos do log
+ */
+struct SampleLogConfig
+{
+    uint16_t batchRecords;  // Registros por escrita (<= SAMPLE_LOG_MAX_BATCH)
+    uint32_t maxBatchAgeMs; // Grava mesmo com o lote incompleto depois desse tempo
+    uint32_t segmentRecords; // Registros por arquivo de segmento
+    uint8_t maxSegments;     // Segmentos guardados; o mais antigo é apagado (<= SAMPLE_LOG_MAX_SEGMENTS)
+};
+
+// 32 registros por escrita; 16 segmentos de 2048 registros = ~900 KB
+const SampleLogConfig SAMPLE_LOG_DEFAULT_CONFIG = {32, 300000, 2048, 16};
+
+/**
+ * @brief Log binário append-only de amostras, em segmentos rotativos
+ *
+ * Cada segmento é um arquivo "<dir>/<seq inicial em hex>" com registros de
+ * tamanho fixo, então o registro n de um segmento está em n * sizeof(LogRecord)
+ * e o fim de um segmento é o início do seguinte. As amostras ficam num lote
+ * em RAM e vão para a flash numa única escrita (lote cheio ou velho demais):
+ * uma escrita a cada batchRecords amostras em vez de uma por amostra.
+ *
+ * Recuperação no boot sem varrer o log: lista o diretório (no máximo
+ * maxSegments nomes), pega o tamanho do segmento mais novo e valida o CRC do
+ * último registro. Um final rasgado (queda de energia no meio da escrita) é
+ * descartado: os registros válidos ficam e as próximas escritas começam um
+ * segmento novo, sem nunca reescrever o que já estava na flash.
+ *
+ * Uma instância não é thread-safe; quem compartilha entre tarefas trava.
+ */
+class SampleLog
+{
+public:
+    SampleLog(LogStorage &storage, const char *dir, const SampleLogConfig &config = SAMPLE_LOG_DEFAULT_CONFIG);
+
+    /**
+     * @brief Recupera a posição de escrita a partir do que está na flash
+     * @return false se o diretório não pôde ser criado
+     */
+    bool begin();
+
+    /**
+     * @brief Acrescenta uma amostra ao lote; grava o lote quando cheio ou velho
+     * @param unixTime Hora UTC (0 = desconhecida)
+     * @param nowMs Tempo atual em milissegundos (idade do lote)
+     * @return false se a gravação do lote falhou (o lote fica para a próxima)
+     */
+    bool append(uint32_t unixTime, const BatchRecord &sample, uint32_t nowMs);
+
+    /**
+     * @brief Grava o lote pendente agora
+     */
+    bool flush();
+
+    /**
+     * @brief Lê registros consecutivos a partir de seq (flash e lote pendente)
+     * @return Quantidade lida; para antes no fim do log ou numa falha de CRC
+     */
+    uint16_t read(uint32_t seq, LogRecord *out, uint16_t max);
+
+    /**
+     * @brief Onde começar a procurar amostras a partir de uma hora UTC
+     *
+     * Lê só o primeiro registro de cada segmento (no máximo maxSegments
+     * leituras) e devolve o início do segmento mais novo que começa antes de
+     * unixTime. Registros sem hora não servem de referência.
+     */
+    uint32_t seekTime(uint32_t unixTime);
+
+    /**
+     * @brief Primeiro seq disponível (o segmento mais antigo ainda guardado)
+     */
+    uint32_t firstSeq() const { return _segCount ? _segStart[0] : _persistedSeq; }
+
+    /**
+     * @brief Próximo seq a ser atribuído (inclui o lote pendente)
+     */
+    uint32_t nextSeq() const { return _persistedSeq + _pending; }
+
+    uint32_t persistedSeq() const { return _persistedSeq; }
+    uint16_t pending() const { return _pending; }
+    uint8_t segments() const { return _segCount; }
+
+    // Contadores desde o begin()
+    uint32_t flushes() const { return _flushes; }
+    uint32_t bytesWritten() const { return _bytesWritten; }
+    uint32_t dropped() const { return _dropped; }
+    // Registros descartados na recuperação (final rasgado ou CRC inválido)
+    uint32_t recoveredTorn() const { return _recoveredTorn; }
+    // Leituras de registro feitas pela recuperação
+    uint32_t recoveryReads() const { return _recoveryReads; }
+
+    static uint32_t crc32(const void *data, size_t len);
+
+private:
+    LogStorage *_storage;
+    const char *_dir;
+    SampleLogConfig _config;
+
+    // Início de cada segmento guardado, do mais antigo ao mais novo
+    uint32_t _segStart[SAMPLE_LOG_MAX_SEGMENTS];
+    uint8_t _segCount;
+    uint32_t _tailRecords; // Registros válidos no segmento mais novo
+    bool _tailClosed;      // Final rasgado: a próxima escrita abre um segmento novo
+
+    uint32_t _persistedSeq; // Próximo seq a ir para a flash
+    LogRecord _batch[SAMPLE_LOG_MAX_BATCH];
+    uint16_t _pending;
+    uint32_t _batchStartMs;
+
+    uint32_t _flushes;
+    uint32_t _bytesWritten;
+    uint32_t _dropped;
+    uint32_t _recoveredTorn;
+    uint32_t _recoveryReads;
+
+    void segmentPath(uint32_t start, char *path) const;
+    void insertSegment(uint32_t start);
+    void dropOldestSegment();
+    bool openSegment(uint32_t start);
+    bool validRecord(const LogRecord &record, uint32_t seq) const;
+    static void onListEntry(const char *name, void *ctx);
+};
+
+#endif
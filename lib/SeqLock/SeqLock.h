@@ -0,0 +1,108 @@
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <type_traits>
+
+/**
+ * @brief Canal de troca de dados sem trava (seqlock) entre tarefas/cores
+ *
+ * Um único escritor publica cópias completas de T; qualquer número de
+ * leitores copia o último valor. O escritor nunca espera.
+ *
+ * São usados dois slots (double-buffer): o escritor sempre grava no slot
+ * que NÃO contém o último valor publicado, então o leitor pode copiar
+ * mesmo com uma escrita em andamento. A cópia só é descartada se o
+ * escritor completar uma publicação inteira e começar a seguinte durante
+ * a leitura, e o leitor nunca enxerga um registro misturado.
+ *
+ * O conteúdo é guardado em palavras atômicas de 32 bits, o que mantém o
+ * acesso concorrente bem definido tanto no ESP32 quanto no host.
+ *
+ * @tparam T Tipo trivialmente copiável (struct simples)
+ */
+template <typename T>
+class SeqLock
+{
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock exige tipo trivialmente copiavel");
+
+public:
+    SeqLock() : _seq(0)
+    {
+        for (size_t s = 0; s < 2; s++)
+            for (size_t i = 0; i < WORDS; i++)
+                _words[s][i].store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Publica um novo valor. Apenas UM escritor por instância.
+     */
+    void write(const T &value)
+    {
+        uint32_t buf[WORDS] = {0};
+        memcpy(buf, &value, sizeof(T));
+
+        // seq / 2 = valores já publicados; o último está no slot (n - 1) & 1
+        uint32_t seq = _seq.load(std::memory_order_relaxed);
+        size_t slot = (seq / 2) & 1;
+        _seq.store(seq + 1, std::memory_order_relaxed); // ímpar: escrita em andamento
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (size_t i = 0; i < WORDS; i++)
+            _words[slot][i].store(buf[i], std::memory_order_relaxed);
+
+        _seq.store(seq + 2, std::memory_order_release); // par: valor estável
+    }
+
+    /**
+     * @brief Tenta copiar o último valor publicado uma única vez (tempo limitado)
+     * @return false apenas se o escritor sobrescreveu o slot durante a cópia
+     */
+    bool tryRead(T &out) const
+    {
+        uint32_t before = _seq.load(std::memory_order_acquire);
+        uint32_t published = before / 2;
+        size_t slot = (published - 1) & 1;
+
+        uint32_t buf[WORDS];
+        for (size_t i = 0; i < WORDS; i++)
+            buf[i] = _words[slot][i].load(std::memory_order_relaxed);
+
+        // O slot lido só é reescrito quando o contador chega a 2 * published + 3
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (_seq.load(std::memory_order_relaxed) - (published * 2) > 2)
+            return false;
+
+        memcpy(&out, buf, sizeof(T));
+        return true;
+    }
+
+    /**
+     * @brief Copia o último valor publicado
+     * @note Só repete se o escritor publicar duas vezes durante uma única
+     * cópia, o que não acontece com escritores periódicos (ms) e cópias de poucos us.
+     */
+    T read() const
+    {
+        T value;
+        while (!tryRead(value))
+        {
+        }
+        return value;
+    }
+
+    /**
+     * @brief Quantidade de valores publicados até agora
+     */
+    uint32_t version() const { return _seq.load(std::memory_order_acquire) / 2; }
+
+private:
+    static const size_t WORDS = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+    std::atomic<uint32_t> _seq;
+    std::atomic<uint32_t> _words[2][WORDS];
+};
+
+#endif
@@ -0,0 +1,129 @@
+#include "ServoActuator.h"
+
+#include <math.h>
+
+ServoActuator::ServoActuator(HalServo &port)
+{
+    _port = &port;
+    _motion = SERVO_DEFAULT_MOTION;
+    _pin = 0;
+    _minUs = 500;
+    _maxUs = 2400;
+
+    _target = 90;
+    _pos = 90;
+    _speed = 0;
+    _written = 90;
+    _attached = false;
+
+    _lastUpdateMs = 0;
+    _lastMoveMs = 0;
+    _startMs = 0;
+    _attachedSinceMs = 0;
+    _activeMs = 0;
+    _writes = 0;
+    _attaches = 0;
+}
+
+void ServoActuator::begin(uint8_t pin, uint16_t minUs, uint16_t maxUs, int initialAngle)
+{
+    uint32_t now = Hal::clock().millis();
+    _pin = pin;
+    _minUs = minUs;
+    _maxUs = maxUs;
+
+    _target = initialAngle;
+    _pos = initialAngle;
+    _speed = 0;
+    _startMs = now;
+    _lastUpdateMs = now;
+    _lastMoveMs = now;
+
+    // Posição inicial é desconhecida: sempre escreve uma vez
+    attach(now);
+    _written = initialAngle;
+    _port->write(_written);
+    _writes++;
+}
+
+void ServoActuator::attach(uint32_t nowMs)
+{
+    _port->attach(_pin, _minUs, _maxUs);
+    _attached = true;
+    _attachedSinceMs = nowMs;
+    _attaches++;
+}
+
+void ServoActuator::detach(uint32_t nowMs)
+{
+    _port->detach();
+    _attached = false;
+    _activeMs += nowMs - _attachedSinceMs;
+}
+
+void ServoActuator::update(uint32_t nowMs)
+{
+    float dt = (nowMs - _lastUpdateMs) / 1000.0f;
+    _lastUpdateMs = nowMs;
+
+    float remaining = _target - _pos;
+    if (remaining == 0 && _speed == 0)
+    {
+        // Parado: solta o PWM depois do tempo de acomodação
+        if (_attached && _motion.detachOnIdle && nowMs - _lastMoveMs >= _motion.settleMs)
+            detach(nowMs);
+        return;
+    }
+
+    // 1. Velocidade desejada: a máxima, limitada pela distância de frenagem
+    float dir = (remaining > 0) ? 1.0f : -1.0f;
+    float brake = sqrtf(2.0f * _motion.maxAccel * fabsf(remaining));
+    float wanted = dir * ((brake < _motion.maxSpeed) ? brake : _motion.maxSpeed);
+
+    // 2. Aceleração limitada em direção à velocidade desejada
+    float dv = _motion.maxAccel * dt;
+    if (wanted > _speed + dv)
+        _speed += dv;
+    else if (wanted < _speed - dv)
+        _speed -= dv;
+    else
+        _speed = wanted;
+
+    // 3. Integra sem passar do alvo (vindo no sentido dele)
+    float step = _speed * dt;
+    bool towardTarget = (step > 0) == (remaining > 0);
+    if (remaining == 0 || (towardTarget && fabsf(step) >= fabsf(remaining)))
+    {
+        _pos = _target;
+        _speed = 0;
+    }
+    else
+    {
+        _pos += step;
+    }
+
+    // 4. Escreve só quando o ângulo inteiro muda
+    int angle = (int)lroundf(_pos);
+    if (angle != _written)
+    {
+        if (!_attached)
+            attach(nowMs);
+        _port->write(angle);
+        _written = angle;
+        _writes++;
+    }
+    _lastMoveMs = nowMs;
+}
+
+uint32_t ServoActuator::activeMs(uint32_t nowMs) const
+{
+    return _attached ? _activeMs + (nowMs - _attachedSinceMs) : _activeMs;
+}
+
+uint32_t ServoActuator::writesPerHour(uint32_t nowMs) const
+{
+    uint32_t elapsed = nowMs - _startMs;
+    if (elapsed == 0)
+        return 0;
+    return (uint32_t)((uint64_t)_writes * 3600000ULL / elapsed);
+}
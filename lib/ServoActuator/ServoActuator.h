@@ -0,0 +1,95 @@
+#ifndef SERVOACTUATOR_H
+#define SERVOACTUATOR_H
+
+#include <stdint.h>
+#include "Hal.h"
+
+/**
+ * @brief Limites de movimento e política de repouso de um servo
+ */
+struct ServoMotion
+{
+    float maxSpeed;     // Velocidade máxima em graus/s
+    float maxAccel;     // Aceleração (e desaceleração) máxima em graus/s²
+    uint32_t settleMs;  // Tempo parado antes de soltar o PWM
+    bool detachOnIdle;  // false: mantém torque (ex: vento forte)
+};
+
+// Rápido o bastante para o controle P do tracker (90 graus/s) e suave nas partidas
+const ServoMotion SERVO_DEFAULT_MOTION = {120.0f, 600.0f, 1000, true};
+
+/**
+ * @brief Acionamento de um servo com trajetória limitada e repouso
+ *
+ * O alvo vem do controle (setTarget); update() avança uma trajetória com
+ * velocidade e aceleração limitadas (perfil trapezoidal), escreve no servo
+ * só quando o ângulo inteiro muda e, depois de settleMs parado, solta o PWM.
+ * Um novo alvo religa o servo antes do primeiro movimento.
+ */
+class ServoActuator
+{
+public:
+    ServoActuator(HalServo &port);
+
+    /**
+     * @brief Liga o servo e vai direto para o ângulo inicial
+     */
+    void begin(uint8_t pin, uint16_t minUs, uint16_t maxUs, int initialAngle);
+
+    void setMotion(const ServoMotion &motion) { _motion = motion; }
+
+    /**
+     * @brief Novo alvo em graus (a trajetória é gerada em update())
+     */
+    void setTarget(int angle) { _target = angle; }
+
+    /**
+     * @brief Avança a trajetória até o instante atual
+     * @param nowMs Tempo atual em milissegundos
+     */
+    void update(uint32_t nowMs);
+
+    int position() const { return _written; }
+    int target() const { return _target; }
+    bool attached() const { return _attached; }
+
+    // Contadores desde o begin()
+    uint32_t writeCount() const { return _writes; }
+    uint32_t attachCount() const { return _attaches; }
+
+    /**
+     * @brief Tempo total com PWM ativo em milissegundos
+     * @param nowMs Tempo atual (inclui o trecho ativo em andamento)
+     */
+    uint32_t activeMs(uint32_t nowMs) const;
+
+    /**
+     * @brief Escritas por hora desde o begin()
+     */
+    uint32_t writesPerHour(uint32_t nowMs) const;
+
+private:
+    void attach(uint32_t nowMs);
+    void detach(uint32_t nowMs);
+
+    HalServo *_port;
+    ServoMotion _motion;
+    uint8_t _pin;
+    uint16_t _minUs, _maxUs;
+
+    int _target;
+    float _pos;      // Posição da trajetória (graus)
+    float _speed;    // Velocidade atual com sinal (graus/s)
+    int _written;    // Último ângulo enviado ao servo
+    bool _attached;
+
+    uint32_t _lastUpdateMs;
+    uint32_t _lastMoveMs;
+    uint32_t _startMs;
+    uint32_t _attachedSinceMs;
+    uint32_t _activeMs;
+    uint32_t _writes;
+    uint32_t _attaches;
+};
+
+#endif
@@ -0,0 +1,63 @@
+#include "SolarEphemeris.h"
+
+#include <math.h>
+
+#define DEG_TO_RAD_F 0.017453292519943f
+#define RAD_TO_DEG_F 57.29577951308232f
+
+// 2000-01-01 12:00 UTC (J2000.0) em tempo Unix
+#define J2000_UNIX 946728000L
+
+/**
+ * @brief Reduz um ângulo ao intervalo [0, 360)
+ */
+static float wrap360(float deg)
+{
+    deg = fmodf(deg, 360.0f);
+    if (deg < 0)
+        deg += 360.0f;
+    return deg;
+}
+
+void solarPosition(uint32_t unixTime, float latitude, float longitude, SolarPosition &out)
+{
+    // 1. Dias desde J2000: parte inteira e fração separadas (precisão do float)
+    int32_t seconds = (int32_t)(unixTime - (uint32_t)J2000_UNIX);
+    int32_t days = seconds / 86400;
+    int32_t rest = seconds % 86400;
+    if (rest < 0)
+    {
+        rest += 86400;
+        days--;
+    }
+    float frac = rest / 86400.0f;
+    float n = days + frac;
+
+    // 2. Longitude média, anomalia média e longitude eclíptica do sol
+    float meanLong = wrap360(280.460f + 0.9856474f * days + 0.9856474f * frac);
+    float g = wrap360(357.528f + 0.9856003f * days + 0.9856003f * frac) * DEG_TO_RAD_F;
+    float lambda = (meanLong + 1.915f * sinf(g) + 0.020f * sinf(2 * g)) * DEG_TO_RAD_F;
+    float epsilon = (23.439f - 0.0000004f * n) * DEG_TO_RAD_F;
+
+    // 3. Coordenadas equatoriais
+    float sinLambda = sinf(lambda);
+    float rightAscension = atan2f(cosf(epsilon) * sinLambda, cosf(lambda));
+    float declination = asinf(sinf(epsilon) * sinLambda);
+
+    // 4. Tempo sideral de Greenwich (horas) e ângulo horário local
+    float gmst = fmodf(18.697374558f + 0.06570982441908f * days + 24.06570982441908f * frac, 24.0f);
+    float hourAngle = (gmst * 15.0f + longitude) * DEG_TO_RAD_F - rightAscension;
+
+    // 5. Coordenadas horizontais
+    float lat = latitude * DEG_TO_RAD_F;
+    float sinLat = sinf(lat), cosLat = cosf(lat);
+    float cosHa = cosf(hourAngle);
+    float sinEl = sinLat * sinf(declination) + cosLat * cosf(declination) * cosHa;
+    if (sinEl > 1.0f)
+        sinEl = 1.0f;
+    else if (sinEl < -1.0f)
+        sinEl = -1.0f;
+
+    out.elevation = asinf(sinEl) * RAD_TO_DEG_F;
+    out.azimuth = wrap360(atan2f(-sinf(hourAngle), tanf(declination) * cosLat - sinLat * cosHa) * RAD_TO_DEG_F);
+}
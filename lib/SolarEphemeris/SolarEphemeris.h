@@ -0,0 +1,29 @@
+#ifndef SOLAREPHEMERIS_H
+#define SOLAREPHEMERIS_H
+
+#include <stdint.h>
+
+/**
+ * @brief Posição do sol vista de um ponto da Terra
+ */
+struct SolarPosition
+{
+    float azimuth;   // Graus a partir do norte, sentido horário (0 a 360)
+    float elevation; // Graus acima do horizonte (negativo = noite)
+};
+
+/**
+ * @brief Efeméride solar de baixo custo (Astronomical Almanac, baixa precisão)
+ *
+ * Só usa float: o tempo é separado em dias inteiros e fração desde J2000 para
+ * não perder precisão nos ângulos médios. Erro típico abaixo de 0.05 grau
+ * entre 2000 e 2050 (sem refração atmosférica, que só importa perto do horizonte).
+ *
+ * @param unixTime Segundos desde 1970-01-01 00:00 UTC
+ * @param latitude Graus, positivo ao norte
+ * @param longitude Graus, positivo a leste
+ * @param out Azimute e elevação calculados
+ */
+void solarPosition(uint32_t unixTime, float latitude, float longitude, SolarPosition &out);
+
+#endif
@@ -0,0 +1,179 @@
+#include "JsonWriter.h"
+
+static const uint32_t POW10[] = {1, 10, 100, 1000, 10000, 100000, 1000000};
+
+size_t formatUnsigned(uint32_t value, char *out)
+{
+    // Dígitos gerados do fim para o início em buffer temporário
+    char tmp[10];
+    size_t n = 0;
+    do
+    {
+        tmp[n++] = '0' + (value % 10);
+        value /= 10;
+    } while (value != 0);
+
+    for (size_t i = 0; i < n; i++)
+        out[i] = tmp[n - 1 - i];
+    return n;
+}
+
+JsonWriter::JsonWriter(char *buffer, size_t capacity)
+{
+    _buf = buffer;
+    _capacity = capacity;
+    _len = 0;
+    _overflow = (capacity == 0);
+    _needComma = false;
+    if (capacity > 0)
+        _buf[0] = '\0';
+}
+
+void JsonWriter::put(char c)
+{
+    // Reserva sempre um byte para o terminador
+    if (_len + 1 >= _capacity)
+    {
+        _overflow = true;
+        return;
+    }
+    _buf[_len++] = c;
+    _buf[_len] = '\0';
+}
+
+void JsonWriter::separator()
+{
+    if (_needComma)
+        put(',');
+    _needComma = true;
+}
+
+void JsonWriter::beginObject()
+{
+    separator();
+    put('{');
+    _needComma = false;
+}
+
+void JsonWriter::endObject()
+{
+    put('}');
+    _needComma = true;
+}
+
+void JsonWriter::beginArray()
+{
+    separator();
+    put('[');
+    _needComma = false;
+}
+
+void JsonWriter::endArray()
+{
+    put(']');
+    _needComma = true;
+}
+
+void JsonWriter::key(const char *name)
+{
+    separator();
+    put('"');
+    while (*name)
+        put(*name++);
+    put('"');
+    put(':');
+    _needComma = false;
+}
+
+void JsonWriter::raw(const char *text)
+{
+    while (*text)
+        put(*text++);
+}
+
+void JsonWriter::string(const char *text)
+{
+    separator();
+    put('"');
+    while (*text)
+    {
+        char c = *text++;
+        if (c == '"' || c == '\\')
+            put('\\');
+        if ((uint8_t)c < 0x20)
+            c = ' ';
+        put(c);
+    }
+    put('"');
+}
+
+void JsonWriter::uinteger(uint32_t value)
+{
+    separator();
+    char digits[10];
+    size_t n = formatUnsigned(value, digits);
+    for (size_t i = 0; i < n; i++)
+        put(digits[i]);
+}
+
+void JsonWriter::integer(int32_t value)
+{
+    if (value < 0)
+    {
+        separator();
+        put('-');
+        _needComma = false;
+        uinteger((uint32_t)(-(int64_t)value));
+        return;
+    }
+    uinteger((uint32_t)value);
+}
+
+void JsonWriter::boolean(bool value)
+{
+    separator();
+    const char *text = value ? "true" : "false";
+    while (*text)
+        put(*text++);
+}
+
+void JsonWriter::fixed(float value, uint8_t decimals)
+{
+    if (decimals > 6)
+        decimals = 6;
+
+    // NaN ou fora da faixa de 32 bits escalados: JSON não tem representação
+    float scale = (float)POW10[decimals];
+    if (value != value || value > 2.0e9f / scale || value < -2.0e9f / scale)
+    {
+        separator();
+        raw("null");
+        return;
+    }
+
+    // Escala e arredonda uma única vez; a parte inteira e a fração saem do mesmo inteiro
+    bool negative = value < 0;
+    float scaled = (negative ? -value : value) * scale + 0.5f;
+    uint32_t units = (uint32_t)scaled;
+    uint32_t intPart = units / POW10[decimals];
+    uint32_t fracPart = units % POW10[decimals];
+
+    separator();
+    if (negative && units != 0)
+        put('-');
+
+    char digits[10];
+    size_t n = formatUnsigned(intPart, digits);
+    for (size_t i = 0; i < n; i++)
+        put(digits[i]);
+
+    if (decimals > 0)
+    {
+        put('.');
+        // Zeros à esquerda da fração (ex: 0.05)
+        for (uint8_t d = decimals; d > 0; d--)
+        {
+            put('0' + (fracPart / POW10[d - 1]) % 10);
+        }
+    }
+}
@@ -0,0 +1,99 @@
+#ifndef JSONWRITER_H
+#define JSONWRITER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Escritor de JSON sobre um buffer fixo (sem alocação no heap)
+ *
+ * Nunca escreve além de 'capacity'. Se faltar espaço, overflow() fica
+ * verdadeiro e o conteúdo deve ser descartado pelo chamador.
+ * O buffer é sempre terminado em '\0'.
+ */
+class JsonWriter
+{
+private:
+    char *_buf;
+    size_t _capacity;
+    size_t _len;
+    bool _overflow;
+    bool _needComma;
+
+    void put(char c);
+    void separator();
+
+public:
+    JsonWriter(char *buffer, size_t capacity);
+
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+
+    /**
+     * @brief Escreve a chave ("nome":) de um campo de objeto
+     */
+    void key(const char *name);
+
+    /**
+     * @brief Escreve texto sem aspas, escape nem vírgula automática
+     */
+    void raw(const char *text);
+
+    void string(const char *text);
+    void integer(int32_t value);
+    void uinteger(uint32_t value);
+    void boolean(bool value);
+
+    /**
+     * @brief Número com casas decimais fixas, sem printf/float-to-string
+     * @param value Valor a ser escrito (NaN/Inf viram null)
+     * @param decimals Casas decimais (0 a 6)
+     */
+    void fixed(float value, uint8_t decimals);
+
+    // Atalhos campo = valor
+    void field(const char *name, int32_t value)
+    {
+        key(name);
+        integer(value);
+    }
+    void field(const char *name, uint32_t value)
+    {
+        key(name);
+        uinteger(value);
+    }
+    void field(const char *name, bool value)
+    {
+        key(name);
+        boolean(value);
+    }
+    void field(const char *name, float value, uint8_t decimals)
+    {
+        key(name);
+        fixed(value, decimals);
+    }
+
+    size_t length() const { return _len; }
+    bool overflow() const { return _overflow; }
+    const char *c_str() const { return _buf; }
+};
+
+/**
+ * @brief Escreve os dígitos de um inteiro sem sinal (sem '\0')
+ * @return Quantidade de caracteres escritos (máx. 10)
+ */
+size_t formatUnsigned(uint32_t value, char *out);
+
+/**
+ * @brief Retorno dos fill() em pedaços quando nem um item coube em maxLen
+ *
+ * Mesmo valor do RESPONSE_TRY_AGAIN do ESPAsyncWebServer: ele chama o
+ * callback de novo em vez de encerrar a resposta (o que um 0 faria).
+ */
+#ifndef RESPONSE_TRY_AGAIN
+#define RESPONSE_TRY_AGAIN 0xFFFFFFFF
+#endif
+
+#endif
@@ -0,0 +1,88 @@
+#include "StationBinary.h"
+#include <math.h>
+#include <string.h>
+
+static void put16(uint8_t *p, uint16_t v)
+{
+    p[0] = v & 0xFF;
+    p[1] = v >> 8;
+}
+
+static void put32(uint8_t *p, uint32_t v)
+{
+    p[0] = v & 0xFF;
+    p[1] = (v >> 8) & 0xFF;
+    p[2] = (v >> 16) & 0xFF;
+    p[3] = v >> 24;
+}
+
+static uint16_t get16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Arredonda e satura em [lo, hi]; NaN vira 'missing'
+static int32_t scaled(float value, float scale, int32_t lo, int32_t hi, int32_t missing)
+{
+    if (value != value)
+        return missing;
+    float q = value * scale;
+    q += (q >= 0) ? 0.5f : -0.5f;
+    if (q > hi)
+        return hi;
+    if (q < lo)
+        return lo;
+    return (int32_t)q;
+}
+
+size_t stationSampleToBinary(const StationSample &sample, uint8_t *buffer, size_t capacity)
+{
+    if (capacity < STATION_BIN_SIZE)
+        return 0;
+
+    buffer[0] = STATION_BIN_VERSION;
+    buffer[1] = (sample.alarm ? STATION_BIN_ALARM : 0) | (sample.ack ? STATION_BIN_ACK : 0) |
+                (sample.bmeOk ? STATION_BIN_BME_OK : 0);
+    put16(buffer + 2, STATION_BIN_SIZE);
+    put32(buffer + 4, sample.seq);
+    put16(buffer + 8, (uint16_t)(int16_t)scaled(sample.temp, 100.0f, -32767, 32767, -32768));
+    put16(buffer + 10, (uint16_t)scaled(sample.hum, 100.0f, 0, 65534, 65535));
+    // Pressão em Pa cabe folgada em 31 bits; 0xFFFFFFFF fica para "ausente"
+    int32_t pres = scaled(sample.pres, 100.0f, 0, 0x7FFFFFFF, -1);
+    put32(buffer + 12, (uint32_t)pres);
+    put16(buffer + 16, (uint16_t)scaled(sample.uv, 1000.0f, 0, 65534, 65535));
+    put32(buffer + 18, (uint32_t)sample.lumens);
+    return STATION_BIN_SIZE;
+}
+
+bool stationSampleFromBinary(const uint8_t *buffer, size_t len, StationSample &out)
+{
+    if (len < 4 || buffer[0] != STATION_BIN_VERSION)
+        return false;
+    uint16_t size = get16(buffer + 2);
+    if (size < STATION_BIN_SIZE || len < size)
+        return false;
+
+    memset(&out, 0, sizeof(out));
+    uint8_t flags = buffer[1];
+    out.alarm = (flags & STATION_BIN_ALARM) ? 1 : 0;
+    out.ack = (flags & STATION_BIN_ACK) ? 1 : 0;
+    out.bmeOk = (flags & STATION_BIN_BME_OK) ? 1 : 0;
+    out.seq = get32(buffer + 4);
+
+    int16_t temp = (int16_t)get16(buffer + 8);
+    uint16_t hum = get16(buffer + 10);
+    uint32_t pres = get32(buffer + 12);
+    uint16_t uv = get16(buffer + 16);
+    out.temp = temp == -32768 ? NAN : temp / 100.0f;
+    out.hum = hum == 65535 ? NAN : hum / 100.0f;
+    out.pres = pres == 0xFFFFFFFF ? NAN : pres / 100.0f;
+    out.uv = uv == 65535 ? NAN : uv / 1000.0f;
+    out.lumens = (int32_t)get32(buffer + 18);
+    return true;
+}
@@ -0,0 +1,45 @@
+#ifndef STATIONBINARY_H
+#define STATIONBINARY_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "StationSample.h"
+
+#define STATION_BIN_VERSION 1
+#define STATION_BIN_SIZE 22 // Tamanho do quadro da versão 1
+
+// Bits do byte de flags
+#define STATION_BIN_ALARM 0x01
+#define STATION_BIN_ACK 0x02
+#define STATION_BIN_BME_OK 0x04
+
+/**
+ * @brief Serializa um StationSample no quadro binário de /data.bin e /ws
+ *
+ * Little-endian, montado byte a byte (não depende do layout da struct):
+ *
+ *   off  tipo  campo
+ *    0   u8    versão (STATION_BIN_VERSION)
+ *    1   u8    flags (STATION_BIN_ALARM | _ACK | _BME_OK)
+ *    2   u16   tamanho do quadro em bytes
+ *    4   u32   seq
+ *    8   i16   temperatura, 0.01 C      (-32768 = ausente)
+ *   10   u16   umidade, 0.01 %          (65535 = ausente)
+ *   12   u32   pressão, 0.01 hPa (Pa)   (0xFFFFFFFF = ausente)
+ *   16   u16   UV, 0.001 mW/cm^2        (65535 = ausente)
+ *   18   i32   luminosidade
+ *
+ * Versões futuras só acrescentam campos no fim; o leitor usa o tamanho
+ * para pular o que não conhece. Não usa heap, printf nem float-to-string.
+ *
+ * @return Tamanho do quadro, ou 0 se não couber no buffer
+ */
+size_t stationSampleToBinary(const StationSample &sample, uint8_t *buffer, size_t capacity);
+
+/**
+ * @brief Lê um quadro (campos ausentes viram NaN)
+ * @return false se a versão não é conhecida ou o quadro está incompleto
+ */
+bool stationSampleFromBinary(const uint8_t *buffer, size_t len, StationSample &out);
+
+#endif
@@ -0,0 +1,20 @@
+#include "StationJson.h"
+#include "JsonWriter.h"
+
+size_t stationSampleToJson(const StationSample &sample, char *buffer, size_t capacity)
+{
+    JsonWriter json(buffer, capacity);
+
+    json.beginObject();
+    json.field("seq", sample.seq);
+    json.field("t", sample.temp, 2);
+    json.field("h", sample.hum, 2);
+    json.field("p", sample.pres, 2);
+    json.field("u", sample.uv, 2);
+    json.field("l", sample.lumens);
+    json.field("alarm", sample.alarm != 0);
+    json.field("ack", sample.ack != 0);
+    json.endObject();
+
+    return json.overflow() ? 0 : json.length();
+}
@@ -0,0 +1,25 @@
+#ifndef STATIONJSON_H
+#define STATIONJSON_H
+
+#include <stddef.h>
+#include "StationSample.h"
+
+/**
+ * @brief Tamanho de buffer suficiente para stationSampleToJson()
+ */
+#define STATION_JSON_MAX 160
+
+/**
+ * @brief Serializa um StationSample no formato do endpoint /data
+ *
+ * Formato: {"seq":N,"t":..,"h":..,"p":..,"u":..,"l":N,"alarm":b,"ack":b}
+ * Não usa heap nem printf.
+ *
+ * @param sample Registro a ser serializado
+ * @param buffer Destino (terminado em '\\0')
+ * @param capacity Tamanho do destino em bytes
+ * @return Tamanho do JSON, ou 0 se não couber no buffer
+ */
+size_t stationSampleToJson(const StationSample &sample, char *buffer, size_t capacity);
+
+#endif
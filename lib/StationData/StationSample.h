@@ -0,0 +1,29 @@
+#ifndef STATIONSAMPLE_H
+#define STATIONSAMPLE_H
+
+#include <stdint.h>
+
+/**
+ * @brief Registro completo de um ciclo de leitura da estação
+ *
+ * Publicado de uma só vez pelo taskSensorsAndAlarm() (via SeqLock), de forma
+ * que display e WebServer nunca misturem valores de ciclos diferentes.
+ */
+struct StationSample
+{
+    uint32_t seq;         // Número do ciclo de leitura (0 = nenhum ainda)
+    uint32_t timestampMs; // millis() no momento da leitura
+
+    float temp; // Temperatura (C)
+    float hum;  // Umidade relativa (%)
+    float pres; // Pressão (hPa)
+    float uv;   // Intensidade UV (mW/cm^2)
+    int32_t lumens;
+
+    uint8_t alarm; // Algum limiar ultrapassado
+    uint8_t ack;   // Alarme confirmado pelo usuário
+    uint8_t bmeOk; // Leitura do BME280 válida neste ciclo
+    uint8_t reserved;
+};
+
+#endif
@@ -0,0 +1,72 @@
+#include "AxisController.h"
+
+// Constante de tempo do filtro do derivativo (s)
+#define D_FILTER_TAU 0.1f
+
+AxisController::AxisController()
+{
+    _gains = TRACKER_PID_GAINS;
+    reset();
+}
+
+void AxisController::setGains(const PidGains &gains)
+{
+    _gains = gains;
+    reset();
+}
+
+void AxisController::reset()
+{
+    _integral = 0;
+    _prevError = 0;
+    _dFiltered = 0;
+    _hasPrev = false;
+}
+
+float AxisController::update(float error, float dtSec)
+{
+    if (dtSec <= 0)
+        return 0;
+
+    // 1. Zona morta: erro pequeno é tratado como alinhado (sem "caça")
+    if (error > _gains.deadband)
+        error -= _gains.deadband;
+    else if (error < -_gains.deadband)
+        error += _gains.deadband;
+    else
+        error = 0;
+
+    // 2. Derivativo filtrado (sem salto na primeira chamada)
+    float derivative = 0;
+    if (_hasPrev)
+    {
+        float raw = (error - _prevError) / dtSec;
+        float alpha = dtSec / (D_FILTER_TAU + dtSec);
+        _dFiltered += alpha * (raw - _dFiltered);
+        derivative = _dFiltered;
+    }
+    _prevError = error;
+    _hasPrev = true;
+
+    float unclamped = _gains.kp * error + _integral + _gains.kd * derivative;
+
+    // 3. Integração condicional: só acumula se a saída não estiver saturada
+    //    no mesmo sentido do erro
+    bool saturatedHigh = unclamped >= _gains.maxRate && error > 0;
+    bool saturatedLow = unclamped <= -_gains.maxRate && error < 0;
+    if (_gains.ki != 0 && !saturatedHigh && !saturatedLow)
+    {
+        _integral += _gains.ki * error * dtSec;
+        if (_integral > _gains.integralLimit)
+            _integral = _gains.integralLimit;
+        else if (_integral < -_gains.integralLimit)
+            _integral = -_gains.integralLimit;
+    }
+
+    float output = _gains.kp * error + _integral + _gains.kd * derivative;
+    if (output > _gains.maxRate)
+        output = _gains.maxRate;
+    else if (output < -_gains.maxRate)
+        output = -_gains.maxRate;
+    return output;
+}
@@ -0,0 +1,71 @@
+#ifndef AXISCONTROLLER_H
+#define AXISCONTROLLER_H
+
+/**
+ * @brief Ganhos e limites do controlador de um eixo
+ *
+ * O erro é a diferença entre os dois lados de LDRs (contagens ADC) e a saída
+ * é a velocidade do servo em graus/s: como o servo de posição já integra a
+ * velocidade, só o termo P leva o erro a zero; o I remove o atraso ao seguir
+ * o movimento do sol e o D amortece oscilações.
+ */
+struct PidGains
+{
+    float kp;            // (graus/s) por contagem
+    float ki;            // (graus/s) por contagem*s
+    float kd;            // (graus/s) por contagem/s
+    float deadband;      // Erro (contagens) tratado como zero
+    float maxRate;       // Limite da saída em graus/s
+    float integralLimit; // Limite da contribuição do termo I em graus/s
+};
+
+// Somente proporcional com zona morta (sem integrador nem derivativo)
+const PidGains TRACKER_P_GAINS = {0.2f, 0.0f, 0.0f, 25.0f, 90.0f, 0.0f};
+
+// PI com zona morta menor e integrador limitado (kd disponível, mas o ruído
+// dos LDRs o torna contraproducente na simulação)
+const PidGains TRACKER_PID_GAINS = {0.2f, 0.05f, 0.0f, 15.0f, 90.0f, 1.5f};
+
+/**
+ * @brief Controlador PID de um eixo com zona morta e anti-windup
+ *
+ * Anti-windup por integração condicional (o integrador não acumula enquanto
+ * a saída está saturada no mesmo sentido do erro) e por limite absoluto da
+ * contribuição integral. O derivativo é filtrado (passa-baixa de 1ª ordem)
+ * para não amplificar o ruído dos LDRs.
+ */
+class AxisController
+{
+public:
+    AxisController();
+
+    void setGains(const PidGains &gains);
+    const PidGains &gains() const { return _gains; }
+
+    /**
+     * @brief Calcula a velocidade do eixo para o erro atual
+     * @param error Diferença entre os lados (contagens ADC)
+     * @param dtSec Tempo desde a última chamada em segundos
+     * @return Velocidade em graus/s, já limitada a ±maxRate
+     */
+    float update(float error, float dtSec);
+
+    /**
+     * @brief Descarta o integrador (ex: eixo parado no fim de curso)
+     */
+    void clearIntegral() { _integral = 0; }
+
+    /**
+     * @brief Volta ao estado inicial (integrador e derivativo)
+     */
+    void reset();
+
+private:
+    PidGains _gains;
+    float _integral; // Contribuição do termo I em graus/s
+    float _prevError;
+    float _dFiltered;
+    bool _hasPrev;
+};
+
+#endif
@@ -1,6 +1,21 @@
 #include "SunTracker.h"
 
+#include <math.h>
+#include <stdlib.h>
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <stdio.h>
+#endif
+
 SunTracker::SunTracker(uint8_t tl, uint8_t tr, uint8_t bl, uint8_t br, uint8_t servoX, uint8_t servoY)
+    : SunTracker(tl, tr, bl, br, servoX, servoY, Hal::servo(0), Hal::servo(1))
+{
+}
+
+SunTracker::SunTracker(uint8_t tl, uint8_t tr, uint8_t bl, uint8_t br, uint8_t servoX, uint8_t servoY,
+                       HalServo &servoPortX, HalServo &servoPortY)
+    : _servoX(servoPortX), _servoY(servoPortY)
 {
     _pinLdrTopLeft = tl;
     _pinLdrTopRight = tr;
@@ -16,6 +31,23 @@ SunTracker::SunTracker(uint8_t tl, uint8_t tr, uint8_t bl, uint8_t br, uint8_t s
     _limitMin = 0;
     _limitMax = 180;
 
+    _angleX = _posX;
+    _angleY = _posY;
+    _mode = TRACKER_MODE_STEP;
+    _ctlX.setGains(TRACKER_PID_GAINS);
+    _ctlY.setGains(TRACKER_PID_GAINS);
+    _lastUpdateUs = 0;
+    _hasLastUpdate = false;
+
+    _mount = TRACKER_DEFAULT_MOUNT;
+    _sun.azimuth = 0;
+    _sun.elevation = 0;
+    _sunValid = false;
+    _trim = TRACKER_DEFAULT_TRIM;
+    _trimX = 0;
+    _trimY = 0;
+    _lastTrimMs = 0;
+
     // Inicializa variaveis de leitura
     _valTL = 0;
     _valTR = 0;
@@ -25,18 +57,24 @@ SunTracker::SunTracker(uint8_t tl, uint8_t tr, uint8_t bl, uint8_t br, uint8_t s
 
 void SunTracker::begin()
 {
-    _servoX.setPeriodHertz(50);
-    _servoY.setPeriodHertz(50);
-    _servoX.attach(_pinServoX, 500, 2400);
-    _servoY.attach(_pinServoY, 500, 2400);
+    begin(_posX, _posY);
+}
+
+void SunTracker::begin(int startX, int startY)
+{
+    _posX = clampAngle(startX);
+    _posY = clampAngle(startY);
+    _angleX = _posX;
+    _angleY = _posY;
 
-    pinMode(_pinLdrTopLeft, INPUT);
-    pinMode(_pinLdrTopRight, INPUT);
-    pinMode(_pinLdrBotLeft, INPUT);
-    pinMode(_pinLdrBotRight, INPUT);
+    HalGpio &gpio = Hal::gpio();
+    gpio.pinMode(_pinLdrTopLeft, HAL_INPUT);
+    gpio.pinMode(_pinLdrTopRight, HAL_INPUT);
+    gpio.pinMode(_pinLdrBotLeft, HAL_INPUT);
+    gpio.pinMode(_pinLdrBotRight, HAL_INPUT);
 
-    _servoX.write(_posX);
-    _servoY.write(_posY);
+    _servoX.begin(_pinServoX, 500, 2400, _posX);
+    _servoY.begin(_pinServoY, 500, 2400, _posY);
 }
 
 void SunTracker::setTolerance(int tol)
@@ -44,13 +82,73 @@ void SunTracker::setTolerance(int tol)
     _tolerance = tol;
 }
 
+void SunTracker::setMode(TrackerMode mode)
+{
+    // A posição contínua parte do ângulo atual para não dar salto na troca
+    _mode = mode;
+    _angleX = _posX;
+    _angleY = _posY;
+    _ctlX.reset();
+    _ctlY.reset();
+    _hasLastUpdate = false;
+}
+
+void SunTracker::setGains(TrackerAxis axis, const PidGains &gains)
+{
+    if (axis == TRACKER_AXIS_X)
+        _ctlX.setGains(gains);
+    else
+        _ctlY.setGains(gains);
+}
+
+void SunTracker::setMount(const TrackerMount &mount)
+{
+    _mount = mount;
+    _trimX = 0;
+    _trimY = 0;
+}
+
+void SunTracker::setSunPosition(const SolarPosition &sun)
+{
+    _sun = sun;
+    _sunValid = true;
+}
+
+void SunTracker::setTrim(const TrackerTrim &trim)
+{
+    _trim = trim;
+}
+
+void SunTracker::setMotion(const ServoMotion &motion)
+{
+    _servoX.setMotion(motion);
+    _servoY.setMotion(motion);
+}
+
 void SunTracker::update()
 {
-    // 1. Leitura e Armazenamento nas variáveis da classe
-    _valTL = analogRead(_pinLdrTopLeft);
-    _valTR = analogRead(_pinLdrTopRight);
-    _valBL = analogRead(_pinLdrBotLeft);
-    _valBR = analogRead(_pinLdrBotRight);
+    // Efeméride: os LDRs só são lidos quando a correção fina vai rodar
+    if (_mode == TRACKER_MODE_EPHEMERIS && _sunValid && !trimDue())
+    {
+        positionFromSun();
+        driveServos();
+        return;
+    }
+
+    AdcSource &adc = Hal::adc();
+    update(adc.read(_pinLdrTopLeft),
+           adc.read(_pinLdrTopRight),
+           adc.read(_pinLdrBotLeft),
+           adc.read(_pinLdrBotRight));
+}
+
+void SunTracker::update(int tl, int tr, int bl, int br)
+{
+    // 1. Armazenamento nas variáveis da classe
+    _valTL = tl;
+    _valTR = tr;
+    _valBL = bl;
+    _valBR = br;
 
     // 2. Cálculo das Médias
     int avgTop = (_valTL + _valTR) / 2;
@@ -58,40 +156,155 @@ void SunTracker::update()
     int avgLeft = (_valTL + _valBL) / 2;
     int avgRight = (_valTR + _valBR) / 2;
 
-    // 3. Lógica Vertical
-    int diffVert = avgTop - avgBot;
+    // 3. Diferenças: positivo = sol à direita (X) / embaixo (Y)
+    int diffHoriz = avgRight - avgLeft;
+    int diffVert = avgBot - avgTop;
+
+    if (_mode == TRACKER_MODE_EPHEMERIS && _sunValid)
+    {
+        if (trimDue())
+            applyTrim(diffHoriz, diffVert, (avgTop + avgBot) / 2);
+        positionFromSun();
+    }
+    else if (_mode == TRACKER_MODE_PID || _mode == TRACKER_MODE_EPHEMERIS)
+        updatePid(diffHoriz, diffVert);
+    else
+        updateStep(diffHoriz, diffVert);
+
+    // 4. Atualização
+    driveServos();
+}
+
+void SunTracker::driveServos()
+{
+    uint32_t now = Hal::clock().millis();
+    _servoX.setTarget(_posX);
+    _servoY.setTarget(_posY);
+    _servoX.update(now);
+    _servoY.update(now);
+}
+
+void SunTracker::updateStep(int diffHoriz, int diffVert)
+{
+    // Lógica Vertical
     if (abs(diffVert) > _tolerance)
     {
-        if (avgTop > avgBot)
+        if (diffVert < 0)
             _posY -= _stepSize;
         else
             _posY += _stepSize;
     }
 
-    // 4. Lógica Horizontal
-    int diffHoriz = avgLeft - avgRight;
+    // Lógica Horizontal
     if (abs(diffHoriz) > _tolerance)
     {
-        if (avgLeft > avgRight)
+        if (diffHoriz < 0)
             _posX -= _stepSize;
         else
             _posX += _stepSize;
     }
 
-    // 5. Restrições e Atualização
-    _posX = constrain(_posX, _limitMin, _limitMax);
-    _posY = constrain(_posY, _limitMin, _limitMax);
+    // Restrições
+    _posX = clampAngle(_posX);
+    _posY = clampAngle(_posY);
+}
+
+void SunTracker::updatePid(int diffHoriz, int diffVert)
+{
+    float dt = elapsedSec();
+
+    // Integra a velocidade pedida por cada eixo
+    float nextX = _angleX + _ctlX.update((float)diffHoriz, dt) * dt;
+    float nextY = _angleY + _ctlY.update((float)diffVert, dt) * dt;
+
+    // Anti-windup no fim de curso: o eixo travado não acumula integral
+    _angleX = clampAngle(nextX);
+    _angleY = clampAngle(nextY);
+    if (_angleX != nextX)
+        _ctlX.clearIntegral();
+    if (_angleY != nextY)
+        _ctlY.clearIntegral();
+
+    _posX = (int)lroundf(_angleX);
+    _posY = (int)lroundf(_angleY);
+}
+
+bool SunTracker::trimDue() const
+{
+    // À noite não há o que corrigir
+    return _sun.elevation >= 0 && Hal::clock().millis() - _lastTrimMs >= _trim.intervalMs;
+}
+
+void SunTracker::applyTrim(int diffHoriz, int diffVert, int brightness)
+{
+    // Correção fina em baixa taxa, só com luz direta suficiente
+    _lastTrimMs = Hal::clock().millis();
+    if (brightness < _trim.minLight)
+        return;
+
+    if (abs(diffHoriz) > _trim.deadband)
+        _trimX += (diffHoriz > 0) ? _trim.stepDeg : -_trim.stepDeg;
+    if (abs(diffVert) > _trim.deadband)
+        _trimY += (diffVert > 0) ? _trim.stepDeg : -_trim.stepDeg;
+
+    float limit = _trim.limitDeg;
+    _trimX = (_trimX < -limit) ? -limit : (_trimX > limit) ? limit : _trimX;
+    _trimY = (_trimY < -limit) ? -limit : (_trimY > limit) ? limit : _trimY;
+}
+
+void SunTracker::positionFromSun()
+{
+    // Sol abaixo do horizonte: mantém a posição até o amanhecer
+    if (_sun.elevation < 0)
+        return;
+
+    // Posição calculada (feed-forward) mais a correção
+    float azOffset = fmodf(_sun.azimuth - _mount.azimuthAtCenter + 540.0f, 360.0f) - 180.0f;
+    _angleX = clampAngle(90.0f + azOffset * _mount.azimuthScale + _trimX);
+    _angleY = clampAngle(90.0f + (_sun.elevation - _mount.elevationAtCenter) * _mount.elevationScale + _trimY);
+
+    _posX = (int)lroundf(_angleX);
+    _posY = (int)lroundf(_angleY);
+}
 
-    _servoX.write(_posX);
-    _servoY.write(_posY);
+float SunTracker::elapsedSec()
+{
+    // Período nominal da taskTracker na primeira chamada
+    uint32_t now = Hal::clock().micros();
+    float dt = 0.05f;
+    if (_hasLastUpdate)
+        dt = (now - _lastUpdateUs) / 1000000.0f;
+    _lastUpdateUs = now;
+    _hasLastUpdate = true;
+
+    // Após uma pausa longa o passo é limitado para não saltar de posição
+    if (dt > 0.2f)
+        dt = 0.2f;
+    return dt;
+}
+
+int SunTracker::clampAngle(int angle) const
+{
+    return (angle < _limitMin) ? _limitMin : (angle > _limitMax) ? _limitMax : angle;
 }
 
+float SunTracker::clampAngle(float angle) const
+{
+    return (angle < _limitMin) ? _limitMin : (angle > _limitMax) ? _limitMax : angle;
+}
+
+#ifdef ARDUINO
+#define TRACKER_LOG Serial.printf
+#else
+#define TRACKER_LOG printf
+#endif
+
 void SunTracker::debug()
 {
     // Formatação visual para facilitar o entendimento espacial dos sensores
-    Serial.println("--- Status Tracker ---");
-    Serial.printf("[ TL: %4d | TR: %4d ]\n", _valTL, _valTR);
-    Serial.printf("[ BL: %4d | BR: %4d ]\n", _valBL, _valBR);
-    Serial.printf("SERVOS -> X: %3d | Y: %3d\n", _posX, _posY);
-    Serial.println("----------------------");
+    TRACKER_LOG("--- Status Tracker ---\n");
+    TRACKER_LOG("[ TL: %4d | TR: %4d ]\n", _valTL, _valTR);
+    TRACKER_LOG("[ BL: %4d | BR: %4d ]\n", _valBL, _valBR);
+    TRACKER_LOG("SERVOS -> X: %3d | Y: %3d\n", _posX, _posY);
+    TRACKER_LOG("----------------------\n");
 }
\ No newline at end of file
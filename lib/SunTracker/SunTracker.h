@@ -1,8 +1,58 @@
 #ifndef SUNTRACKER_H
 #define SUNTRACKER_H
 
-#include <Arduino.h>
-#include <ESP32Servo.h>
+#include "Hal.h"
+#include "AxisController.h"
+#include "SolarEphemeris.h"
+#include "ServoActuator.h"
+
+/**
+ * @brief Lei de controle usada pelo tracker
+ */
+enum TrackerMode
+{
+    TRACKER_MODE_STEP, // Original: passo fixo quando a diferença passa da tolerância
+    TRACKER_MODE_PID,      // Velocidade proporcional ao erro (P, PI ou PID por eixo)
+    TRACKER_MODE_EPHEMERIS // Aponta pela efeméride; LDRs só corrigem um pequeno desvio
+};
+
+/**
+ * @brief Relação entre a posição do sol e os ângulos dos servos
+ *
+ * servoX = 90 + (azimute - azimuthAtCenter) * azimuthScale
+ * servoY = 90 + (elevação - elevationAtCenter) * elevationScale
+ * A escala negativa inverte o sentido do servo.
+ */
+struct TrackerMount
+{
+    float azimuthAtCenter;   // Azimute (graus) com o servo X em 90
+    float azimuthScale;      // Graus de servo por grau de azimute
+    float elevationAtCenter; // Elevação (graus) com o servo Y em 90
+    float elevationScale;    // Graus de servo por grau de elevação
+};
+
+// Eixo X voltado para o norte (hemisfério sul) e servo Y em 90 = zênite
+const TrackerMount TRACKER_DEFAULT_MOUNT = {0.0f, 1.0f, 90.0f, 1.0f};
+
+/**
+ * @brief Correção fina pelos LDRs no modo efeméride
+ */
+struct TrackerTrim
+{
+    uint32_t intervalMs; // Intervalo entre correções
+    float stepDeg;       // Passo de cada correção
+    float limitDeg;      // Correção máxima acumulada por eixo
+    int deadband;        // Diferença entre lados (contagens) tratada como alinhado
+    int minLight;        // Média mínima dos LDRs para corrigir (abaixo: nublado)
+};
+
+const TrackerTrim TRACKER_DEFAULT_TRIM = {5000, 0.5f, 10.0f, 25, 400};
+
+enum TrackerAxis
+{
+    TRACKER_AXIS_X,
+    TRACKER_AXIS_Y
+};
 
 class SunTracker
 {
@@ -11,14 +61,34 @@ private:
     uint8_t _pinLdrTopLeft, _pinLdrTopRight, _pinLdrBotLeft, _pinLdrBotRight;
     uint8_t _pinServoX, _pinServoY;
 
-    // Objetos Servo
-    Servo _servoX;
-    Servo _servoY;
+    // Servos (via Hal): escrita só na mudança, trajetória limitada, repouso sem PWM
+    ServoActuator _servoX;
+    ServoActuator _servoY;
 
     // Estado Atual (Posição)
     int _posX;
     int _posY;
 
+    // Posição contínua do modo PID (o servo recebe o valor arredondado)
+    float _angleX;
+    float _angleY;
+
+    // Controle
+    TrackerMode _mode;
+    AxisController _ctlX;
+    AxisController _ctlY;
+    uint32_t _lastUpdateUs;
+    bool _hasLastUpdate;
+
+    // Efeméride: posição do sol e correção fina pelos LDRs
+    TrackerMount _mount;
+    SolarPosition _sun;
+    bool _sunValid;
+    TrackerTrim _trim;
+    float _trimX;
+    float _trimY;
+    uint32_t _lastTrimMs;
+
     // Estado Atual (Leitura dos Sensores) - NOVO
     int _valTL, _valTR, _valBL, _valBR;
 
@@ -29,15 +99,97 @@ private:
     int _limitMax;
 
 public:
+    /**
+     * @brief Usa os servos 0 (X) e 1 (Y) do Hal
+     */
     SunTracker(uint8_t tl, uint8_t tr, uint8_t bl, uint8_t br, uint8_t servoX, uint8_t servoY);
+
+    /**
+     * @brief Usa servos fornecidos (ex: FakeServo no host)
+     */
+    SunTracker(uint8_t tl, uint8_t tr, uint8_t bl, uint8_t br, uint8_t servoX, uint8_t servoY,
+               HalServo &servoPortX, HalServo &servoPortY);
+    /**
+     * @brief Configura os pinos e leva os servos para 90 graus
+     */
     void begin();
+
+    /**
+     * @brief Como begin(), mas parte de uma posição conhecida
+     * @note Após o deep sleep o servo está parado no último ângulo: reescrevê-lo
+     *       só religa o PWM, sem ir a 90 e voltar
+     */
+    void begin(int startX, int startY);
+
+    /**
+     * @brief Lê os 4 LDRs e atualiza os servos
+     */
     void update();
+
+    /**
+     * @brief Atualiza os servos a partir de leituras já feitas
+     * @note Usado quando os LDRs são lidos pelo serviço de aquisição (AnalogAcquisition)
+     */
+    void update(int tl, int tr, int bl, int br);
     void setTolerance(int tol);
 
+    /**
+     * @brief Seleciona a lei de controle (padrão: TRACKER_MODE_STEP)
+     */
+    void setMode(TrackerMode mode);
+    TrackerMode getMode() const { return _mode; }
+
+    /**
+     * @brief Ajusta ganhos e limites do controlador de um eixo (modo PID)
+     */
+    void setGains(TrackerAxis axis, const PidGains &gains);
+
+    /**
+     * @brief Geometria da montagem usada no modo efeméride
+     */
+    void setMount(const TrackerMount &mount);
+
+    /**
+     * @brief Posição atual do sol (modo efeméride)
+     * @note Sem posição válida o modo efeméride se comporta como TRACKER_MODE_PID
+     */
+    void setSunPosition(const SolarPosition &sun);
+    void clearSunPosition() { _sunValid = false; }
+
+    /**
+     * @brief Ajusta a correção fina pelos LDRs do modo efeméride
+     */
+    void setTrim(const TrackerTrim &trim);
+
+    /**
+     * @brief Limites de movimento e repouso dos dois servos
+     */
+    void setMotion(const ServoMotion &motion);
+
+    const ServoActuator &actuatorX() const { return _servoX; }
+    const ServoActuator &actuatorY() const { return _servoY; }
+
+    float getTrimX() const { return _trimX; }
+    float getTrimY() const { return _trimY; }
+
+    int getPosX() const { return _posX; }
+    int getPosY() const { return _posY; }
+
     /**
      * @brief Imprime no Serial os valores dos sensores e ângulos atuais
      */
     void debug();
+
+private:
+    void updateStep(int diffHoriz, int diffVert);
+    void updatePid(int diffHoriz, int diffVert);
+    bool trimDue() const;
+    void applyTrim(int diffHoriz, int diffVert, int brightness);
+    void positionFromSun();
+    void driveServos();
+    float elapsedSec();
+    int clampAngle(int angle) const;
+    float clampAngle(float angle) const;
 };
 
 #endif
\ No newline at end of file
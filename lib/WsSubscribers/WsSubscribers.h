@@ -0,0 +1,99 @@
+#ifndef WSSUBSCRIBERS_H
+#define WSSUBSCRIBERS_H
+
+#include <stdint.h>
+#include <mutex>
+
+/**
+ * @brief Tabela de assinantes do WebSocket compartilhada entre duas tarefas
+ *
+ * A tarefa do AsyncTCP registra (add) e retira (remove) os clientes nos
+ * eventos de conexão; a tarefa de rede envia a cada amostra (forEach).
+ * O AsyncWebSocket libera o cliente logo depois do evento de desconexão,
+ * então o ponteiro só é usado com a trava: remove() espera um envio em
+ * andamento terminar e, depois dele, ninguém mais enxerga o cliente.
+ *
+ * O envio não passa pela lista do AsyncWebSocket (ws.client(id)), que a
+ * tarefa do AsyncTCP altera sem essa trava.
+ *
+ * @tparam Client Tipo do cliente (AsyncWebSocketClient no firmware)
+ * @tparam N Máximo de assinantes
+ */
+template <typename Client, uint8_t N>
+class WsSubscribers
+{
+public:
+    WsSubscribers()
+    {
+        for (uint8_t i = 0; i < N; i++)
+            _clients[i] = nullptr;
+    }
+
+    /**
+     * @brief Registra um cliente novo
+     * @return false se a tabela está cheia (o chamador recusa o cliente,
+     *         fora da trava)
+     */
+    bool add(Client *client)
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        for (uint8_t i = 0; i < N; i++)
+        {
+            if (_clients[i] == nullptr)
+            {
+                _clients[i] = client;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Retira um cliente; ao retornar, nenhum envio o usa mais
+     */
+    void remove(Client *client)
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        for (uint8_t i = 0; i < N; i++)
+        {
+            if (_clients[i] == client)
+                _clients[i] = nullptr;
+        }
+    }
+
+    /**
+     * @brief Chama fn(client) para cada assinante, com a trava
+     * @param fn Retorna true se enviou; não pode chamar add()/remove()
+     * @return Quantos envios deram certo
+     */
+    template <typename Fn>
+    uint8_t forEach(Fn fn)
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        uint8_t sent = 0;
+        for (uint8_t i = 0; i < N; i++)
+        {
+            if (_clients[i] != nullptr && fn(_clients[i]))
+                sent++;
+        }
+        return sent;
+    }
+
+    uint8_t count()
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        uint8_t n = 0;
+        for (uint8_t i = 0; i < N; i++)
+        {
+            if (_clients[i] != nullptr)
+                n++;
+        }
+        return n;
+    }
+
+private:
+    std::mutex _lock;
+    Client *_clients[N];
+};
+
+#endif
@@ -0,0 +1,72 @@
+"""
+Gera src/examples/main/index_html_gz.h a partir de src/examples/main/web/index.html
+
+A página é comprimida (gzip) em tempo de build e embutida na flash como
+array de bytes, junto com um ETag forte (hash do conteúdo). O firmware
+serve esse array com Content-Encoding: gzip e responde 304 quando o
+navegador já tem a mesma versão.
+
+Executado pelo PlatformIO (extra_scripts = pre:...) ou manualmente:
+    python scripts/build_dashboard.py
+"""
+
+import gzip
+import hashlib
+import os
+
+try:
+    Import("env")  # noqa: F821 (injetado pelo PlatformIO/SCons)
+    PROJECT_DIR = env.subst("$PROJECT_DIR")  # noqa: F821
+except NameError:
+    PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+SOURCE = os.path.join(PROJECT_DIR, "src", "examples", "main", "web", "index.html")
+OUTPUT = os.path.join(PROJECT_DIR, "src", "examples", "main", "index_html_gz.h")
+
+
+def build():
+    with open(SOURCE, "rb") as f:
+        raw = f.read()
+
+    # mtime=0 deixa a saída determinística (mesmo HTML -> mesmos bytes -> mesmo ETag)
+    compressed = gzip.compress(raw, compresslevel=9, mtime=0)
+    etag = hashlib.sha1(raw).hexdigest()[:16]
+
+    lines = []
+    for i in range(0, len(compressed), 16):
+        chunk = compressed[i:i + 16]
+        lines.append("    " + ", ".join("0x%02x" % b for b in chunk) + ",")
+
+    header = "\n".join([
+        "// Gerado por scripts/build_dashboard.py a partir de web/index.html - NÃO EDITAR",
+        "#ifndef INDEX_HTML_GZ_H",
+        "#define INDEX_HTML_GZ_H",
+        "",
+        "#include <Arduino.h>",
+        "",
+        '#define INDEX_HTML_ETAG "\\"%s\\""' % etag,
+        "#define INDEX_HTML_RAW_LEN %d" % len(raw),
+        "#define INDEX_HTML_GZ_LEN %d" % len(compressed),
+        "",
+        "const uint8_t index_html_gz[] PROGMEM = {",
+        *lines,
+        "};",
+        "",
+        "#endif",
+        "",
+    ])
+
+    # Só reescreve se mudou, para não forçar recompilação do main.cpp
+    old = None
+    if os.path.exists(OUTPUT):
+        with open(OUTPUT, "r", encoding="utf-8") as f:
+            old = f.read()
+    if old != header:
+        with open(OUTPUT, "w", encoding="utf-8") as f:
+            f.write(header)
+
+    saved = 100.0 * (1 - len(compressed) / len(raw))
+    print("Dashboard: %d bytes -> %d bytes gzip (-%.1f%%), ETag %s" % (len(raw), len(compressed), saved, etag))
+
+
+build()
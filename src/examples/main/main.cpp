@@ -9,14 +9,46 @@
 #include <SPI.h>
 #include <Adafruit_GFX.h>
 #include <Adafruit_SSD1306.h>
-#include <Adafruit_Sensor.h>
-#include <Adafruit_BME280.h>
+#include "BME280Burst.h"
 #include <ESP32Servo.h>
 #include <WiFi.h>
 #include <AsyncTCP.h>
 #include <ESPAsyncWebServer.h>
+#include <time.h>
+#include <sys/time.h>
+#include "Hal.h"
 #include "GYML8511.h"
+#include "AnalogCalibration.h"
+#include "SensorCurves.h"
 #include "SunTracker.h"
+#include "SolarEphemeris.h"
+#include "AnalogAcquisition.h"
+#include "SeqLock.h"
+#include "WsSubscribers.h"
+#include "StationSample.h"
+#include "StationJson.h"
+#include "StationBinary.h"
+#include "HistoryStore.h"
+#include "HistoryJsonStream.h"
+#include "SSD1306DiffFlusher.h"
+#include "LatencyHistogram.h"
+#include "MetricsRegistry.h"
+#include "PrometheusStream.h"
+#include "AdaptiveSampling.h"
+#include "DutyCycle.h"
+#include "AlarmEngine.h"
+#include "AlarmJsonStream.h"
+#include "SampleLog.h"
+#include "LogStorageLittleFS.h"
+#include "LogExportStream.h"
+#include "AdmissionControl.h"
+#include "HealthMonitor.h"
+#include "HealthJsonStream.h"
+#include "esp_heap_caps.h"
+#ifdef STATION_LOW_POWER
+#include "esp_sleep.h"
+#endif
+#include "index_html_gz.h"
 
 // ==========================================
 // CONFIGURAÇÕES DE HARDWARE
@@ -36,174 +68,217 @@
 #define LDR_BOT_LEFT 35
 #define LDR_BOT_RIGHT 36
 
-// --- Limiares de Alarme ---
-#define ALARM_TEMP 40.0
-#define ALARM_HUM 90
-#define ALARM_PRES 1100.0
-#define ALARM_UV 200.0
-#define ALARM_LUMENS 3500
+// --- Canais do serviço de aquisição (índices no AnalogSnapshot) ---
+enum AnalogChannel
+{
+    CH_LDR_TL = 0,
+    CH_LDR_TR,
+    CH_LDR_BL,
+    CH_LDR_BR,
+    CH_UV,
+    CH_COUNT
+};
+const uint8_t ANALOG_PINS[CH_COUNT] = {LDR_TOP_LEFT, LDR_TOP_RIGHT, LDR_BOT_LEFT, LDR_BOT_RIGHT, PIN_UV_IN};
+
+// --- Localização (efeméride solar do tracker) ---
+#define SITE_LATITUDE -23.55  // Graus, positivo ao norte
+#define SITE_LONGITUDE -46.63 // Graus, positivo a leste
+#define CLOCK_VALID_EPOCH 1700000000UL // Antes disso o relógio ainda não foi acertado
+
+// --- Regras de Alarme (carregadas no boot; editáveis em /rules) ---
+// {canal, tipo, ligada, -, limiar, histerese, duração mínima ms, janela da taxa ms}
+const AlarmRule DEFAULT_ALARM_RULES[] = {
+    {ALARM_CH_TEMP, ALARM_ABOVE, 1, 0, 40.0f, 1.0f, 5000, 0},
+    {ALARM_CH_HUM, ALARM_ABOVE, 1, 0, 90.0f, 3.0f, 10000, 0},
+    {ALARM_CH_PRES, ALARM_ABOVE, 1, 0, 1100.0f, 1.0f, 5000, 0},
+    {ALARM_CH_UV, ALARM_ABOVE, 1, 0, 200.0f, 0.5f, 5000, 0},
+    {ALARM_CH_LUMENS, ALARM_ABOVE, 1, 0, 270.0f, 30.0f, 5000, 0}, // Lux (equivale às ~3500 contagens do limiar antigo)
+    {ALARM_CH_PRES, ALARM_FALL, 1, 0, 3.0f, 1.0f, 0, 1800000},    // Queda de 3 hPa/h: frente chegando
+};
+#define ALARM_QUEUE_LEN 4 // Edições pendentes vindas do WebServer
+
+// --- LOG EM FLASH ---
+#define LOG_DIR "/log"
+#define LOG_PERIOD_MS 10000 // Uma amostra no log a cada 10 s (gravadas em lotes de 32)
+
+// --- SAÚDE (heap e pilhas) ---
+#define HEALTH_PERIOD_MS 60000 // Uma leitura por minuto: o anel cobre a última hora
+// Tarefas acompanhadas: as de tasks[] (mesma ordem), a do AsyncTCP e a do loop()
+const char *const HEALTH_TASK_NAMES[] = {"tracker", "sensors", "display", "network", "async_tcp", "loopTask"};
+#define HEALTH_TASK_COUNT (sizeof(HEALTH_TASK_NAMES) / sizeof(HEALTH_TASK_NAMES[0]))
+
+// --- Amostragem adaptativa (taskSensorsAndAlarm) ---
+#define SENSOR_TICK_MS 250       // Passo da tarefa: resolução do agendamento
+#define PUBLISH_PERIOD_MS 1000   // Publicação e histórico mesmo sem mudança
+#define INDICATOR_PERIOD_MS 1000 // Cadência do pisca do alarme e do LED azul
+// {período mínimo, período máximo, deadband}. O clima muda devagar: lê a cada
+// 5-10 s parado e desce até um passo da tarefa (mais rápido que a leitura
+// fixa de 1 s antiga) numa frente fria, numa queda de pressão ou perto do
+// limiar de uma regra de alarme (watchAlarmThresholds()).
+const SamplingPolicy TEMP_POLICY = {SENSOR_TICK_MS, 5000, 0.1f};  // °C
+const SamplingPolicy HUM_POLICY = {SENSOR_TICK_MS, 5000, 0.5f};   // %
+const SamplingPolicy PRES_POLICY = {SENSOR_TICK_MS, 10000, 0.1f}; // hPa
+// UV e luz saem da varredura do taskTracker (sem custo de leitura aqui);
+// a política só decide quando o valor publicado é atualizado.
+const SamplingPolicy UV_POLICY = {SENSOR_TICK_MS, 5000, 0.2f};   // mW/cm²
+const SamplingPolicy LUX_POLICY = {SENSOR_TICK_MS, 5000, 10.0f}; // Lux
+
+// --- Modo de baixo consumo (env ex-main-lowpower, -DSTATION_LOW_POWER) ---
+// Desperta pelo timer, amostra e volta ao deep sleep; WiFi e display só sobem
+// com o lote cheio ou num alarme novo (ver DUTY_DEFAULT_CONFIG)
+#define BME_CONVERSION_MS 10 // Conversão forçada x1/x1/x1: 9.3 ms no pior caso
 
 // --- OLED ---
 #define SCREEN_WIDTH 128
 #define SCREEN_HEIGHT 64
 Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, -1);
+SSD1306DiffFlusher oledFlusher(Hal::i2c(), 0x3C); // Envia só as regiões alteradas do quadro
 
 // --- Sensores Objetos ---
-Adafruit_BME280 bme;
+BME280Burst bme(Hal::i2c()); // Leitura em rajada única (T, P e H juntos)
+// Modo forçado (uma medição por ciclo), x1 em tudo, sem IIR: recomendado para clima
+const BME280Config BME_CONFIG = {1, 1, 1, 0, 0, false};
+AnalogAcquisition analogInputs(Hal::adc(), ANALOG_PINS, CH_COUNT); // Único ponto de leitura ADC
+AdcCalibration adcCal; // Contagens -> mV do ADC1 (eFuse quando houver, senão curva típica)
 GYML8511 uvSensor(PIN_UV_IN, 3.3);
 SunTracker solarTracker(LDR_TOP_LEFT, LDR_TOP_RIGHT, LDR_BOT_LEFT, LDR_BOT_RIGHT, PIN_SERVO_X, PIN_SERVO_Y);
 
 // --- WebServer ---
 AsyncWebServer server(80);
+AsyncWebSocket ws("/ws"); // Canal push: cada amostra nova vai uma vez para todos
 const char *ssid = "estacao-metereologica";
 const char *password = "micro123";
 bool bmeFound = false; // Variável de proteção
 // --- Variáveis de Controle de Conexão ---
 unsigned long lastWebAccess = 0;        // Marca a última vez que o site pediu dados
 const unsigned long WEB_TIMEOUT = 3000; // 3 segundos de tolerância
+
+// --- Admissão de requisições HTTP ---
+// Limite de requisições em andamento e de polling por cliente; o excesso
+// recebe 503 + Retry-After na hora. Usado só pela tarefa do AsyncTCP.
+AdmissionControl admission;
+
+// --- Clientes WebSocket ---
+// Tabela escrita pelo AsyncTCP (eventos) e lida pelo taskNetwork (envio),
+// sempre com a trava dela: o ponteiro do cliente morre com a desconexão
+#define WS_MAX_CLIENTS 8
+WsSubscribers<AsyncWebSocketClient, WS_MAX_CLIENTS> wsClients;
+uint32_t wsLastPushedSeq = 0;           // Última amostra enviada
+volatile uint32_t wsDroppedClients = 0; // Clientes derrubados por lentidão
 // ==========================================
 // VARIÁVEIS GLOBAIS (Compartilhadas entre Cores)
 // ==========================================
-// "volatile" garante que o compilador não otimize leitura/escrita entre cores
-volatile float sharedTemp = 0.0;
-volatile float sharedHum = 0.0;
-volatile float sharedPres = 0.0;
-volatile float sharedUV = 0.0;
-volatile int sharedLumens = 0;
-
-volatile bool alarmCondition = false;    // Se os sensores passaram do limite
-volatile bool alarmAcknowledged = false; // Se o usuário confirmou o popup
-
-// Timers
-unsigned long lastTrackerTime = 0;
-unsigned long lastSensorTime = 0;
-unsigned long lastDisplayTime = 0;
-unsigned long lastBlinkTime = 0;
+// Último ciclo de leitura, publicado inteiro pelo taskSensorsAndAlarm().
+// Leitores (display, WebServer) sempre recebem um registro consistente.
+SeqLock<StationSample> sampleBus;
+uint32_t sampleSeq = 0; // Escrito apenas pelo taskSensorsAndAlarm()
+
+// Histórico em memória (1 s / 1 min / 1 h), servido em /history
+HistoryStore history;
+
+// Regras de alarme: só o taskSensorsAndAlarm mexe na tabela. O WebServer pede
+// edições pela fila e lê a cópia publicada em alarmBus.
+AlarmEngine alarmEngine;
+SeqLock<AlarmSnapshot> alarmBus;
+QueueHandle_t alarmCommands = nullptr;
+static_assert((int)ALARM_CH_COUNT == (int)HIST_CHANNELS, "alarme e histórico usam a mesma ordem de canais");
+
+// Último snapshot analógico publicado pelo taskTracker (troca sem trava)
+SeqLock<AnalogSnapshot> analogBus;
+
+// Saúde do heap e das pilhas: o loop() lê e publica, o /health lê a cópia
+HealthMonitor healthMonitor(HEALTH_TASK_NAMES, HEALTH_TASK_COUNT);
+SeqLock<HealthSnapshot> healthBus;
+uint32_t lastHealthMs = 0;
+
 bool blinkState = false;
 
+// Estado da amostragem adaptativa (acessado apenas pelo taskSensorsAndAlarm)
+AdaptiveChannel tempChannel(TEMP_POLICY);
+AdaptiveChannel humChannel(HUM_POLICY);
+AdaptiveChannel presChannel(PRES_POLICY);
+AdaptiveChannel uvChannel(UV_POLICY);
+AdaptiveChannel luxChannel(LUX_POLICY);
+StationSample currentSample = {}; // Últimos valores lidos, mantidos entre leituras
+bool bmePending = false;          // Conversão forçada disparada, lida no próximo passo
+uint32_t lastPublishMs = 0;
+uint32_t lastIndicatorMs = 0;
+
+// Log de amostras no LittleFS. O taskSensorsAndAlarm escreve; quem lê de
+// outra tarefa trava logMutex (a instância não é thread-safe).
+LittleFsLogStorage logStorage;
+SampleLog sampleLog(logStorage, LOG_DIR);
+SemaphoreHandle_t logMutex = nullptr;
+bool logReady = false;
+uint32_t lastLogMs = 0;
+
+#ifdef STATION_LOW_POWER
+RTC_DATA_ATTR SampleBatch rtcBatch; // Sobrevive ao deep sleep
+RTC_DATA_ATTR AlarmRuleImage rtcRules; // Regras editadas em /rules, idem
+RTC_DATA_ATTR int16_t rtcServoX = -1;   // Ângulos ao dormir (-1: partida a frio)
+RTC_DATA_ATTR int16_t rtcServoY = -1;
+DutyCycle dutyCycle(rtcBatch);
+#endif
+
+/**
+ * @brief Tempo da estação em segundos, base do histórico
+ *
+ * No modo de baixo consumo o millis() recomeça a cada despertar, então o
+ * relógio soma o tempo dormido guardado na memória RTC.
+ */
+uint32_t stationSeconds()
+{
+#ifdef STATION_LOW_POWER
+    return dutyCycle.stationSec(millis());
+#else
+    return millis() / 1000;
+#endif
+}
+
+// ==========================================
+// AGENDAMENTO (FreeRTOS)
+// ==========================================
+// Core 1: controle (tracker e sensores). Core 0: display, WiFi e AsyncTCP.
+#define CORE_CONTROL 1
+#define CORE_IO 0
+
+/**
+ * @brief Configuração e estatísticas de uma tarefa periódica
+ * Os contadores são escritos apenas pela própria tarefa.
+ */
+struct PeriodicTask
+{
+    const char *name;
+    void (*run)();
+    uint32_t periodMs;
+    UBaseType_t priority;
+    BaseType_t core;
+    uint32_t stackSize;
+
+    TaskHandle_t handle;
+    volatile uint32_t runs;      // Execuções completas
+    volatile uint32_t misses;    // Execuções que terminaram depois do próximo disparo
+    volatile uint32_t lastExecUs; // Duração da última execução
+    volatile uint32_t maxExecUs;  // Maior duração observada
+
+    LatencyHistogram execHist; // Duração de cada execução (contador de ciclos)
+    LatencyHistogram lateHist; // Atraso do início em relação ao horário nominal
+};
+
+// Latência dos handlers HTTP/WebSocket (todos rodam na tarefa do AsyncTCP, core 0)
+LatencyHistogram httpRootHist, httpDataHist, httpDataBinHist, httpHistoryHist, httpHistoryChunkHist;
+LatencyHistogram httpTimeHist, httpResetHist, httpMetricsHist, httpRulesHist, httpExportChunkHist, httpHealthHist;
+LatencyHistogram wsEventHist;
+
+// Tabela do /metrics (montada uma vez em setupMetrics())
+MetricsRegistry metrics;
+
 // ==========================================
 // CÓDIGO HTML/JS (Armazenado na Flash)
 // ==========================================
-// Contém o site com 5 gráficos e Popup de Alerta
-// Usamos Chart.js via CDN (se houver internet no celular) ou desenhamos Canvas simples se for full offline.
-// Abaixo implemento desenhando em Canvas puro para garantir funcionamento OFFLINE.
-
-const char index_html[] PROGMEM = R"rawliteral(
-<!DOCTYPE HTML><html>
-<head>
-  <meta name="viewport" content="width=device-width, initial-scale=1">
-  <title>Estacao Metereologica</title>
-  <style>
-    body { font-family: Arial; text-align: center; margin: 0; background-color: #f4f4f4; }
-    h2 { color: #333; }
-    .cards { display: flex; flex-wrap: wrap; justify-content: center; }
-    .card { background: white; padding: 20px; margin: 10px; border-radius: 8px; box-shadow: 0 2px 5px rgba(0,0,0,0.1); width: 300px; }
-    canvas { width: 100%; height: 150px; border-bottom: 1px solid #ddd; }
-    .val { font-size: 1.2rem; font-weight: bold; color: #007BFF; }
-    
-    /* Popup Style */
-    .modal { display: none; position: fixed; z-index: 1; left: 0; top: 0; width: 100%; height: 100%; background-color: rgba(0,0,0,0.8); }
-    .modal-content { background-color: #ffcccc; margin: 15% auto; padding: 20px; border: 1px solid #888; width: 80%; max-width: 400px; text-align: center; border-radius: 10px; }
-    .btn-confirm { background-color: #d9534f; color: white; padding: 15px 32px; text-align: center; text-decoration: none; display: inline-block; font-size: 16px; margin: 4px 2px; cursor: pointer; border: none; border-radius: 5px; }
-  </style>
-</head>
-<body>
-  <h2>Monitoramento em Tempo Real</h2>
-  <div class="cards">
-    <div class="card"><h3>Temperatura</h3><canvas id="chartT"></canvas><div class="val" id="valT">-- C</div></div>
-    <div class="card"><h3>Umidade</h3><canvas id="chartH"></canvas><div class="val" id="valH">-- %</div></div>
-    <div class="card"><h3>Pressao</h3><canvas id="chartP"></canvas><div class="val" id="valP">-- hPa</div></div>
-    <div class="card"><h3>UV</h3><canvas id="chartU"></canvas><div class="val" id="valU">-- mW</div></div>
-    <div class="card"><h3>Luminosidade</h3><canvas id="chartL"></canvas><div class="val" id="valL">-- Lux</div></div>
-  </div>
-
-  <div id="alarmModal" class="modal">
-    <div class="modal-content">
-      <h1 style="color:red">ALERTA DE SEGURANÇA!</h1>
-      <p>Níveis críticos detectados nos sensores.</p>
-      <button class="btn-confirm" onclick="confirmAlarm()">CONFIRMAR E DESLIGAR ALARME</button>
-    </div>
-  </div>
-
-<script>
-// Simples biblioteca de graficos feita a mao para funcionar offline
-const maxPoints = 50;
-const charts = ['chartT', 'chartH', 'chartP', 'chartU', 'chartL'];
-const dataHistory = { chartT: [], chartH: [], chartP: [], chartU: [], chartL: [] };
-
-function drawChart(canvasId, dataArr, color) {
-    const c = document.getElementById(canvasId);
-    const ctx = c.getContext("2d");
-    const w = c.width = c.clientWidth;
-    const h = c.height = c.clientHeight;
-    ctx.clearRect(0, 0, w, h);
-    
-    if (dataArr.length < 2) return;
-    
-    let min = Math.min(...dataArr);
-    let max = Math.max(...dataArr);
-    let range = max - min;
-    if (range === 0) range = 1;
-
-    ctx.beginPath();
-    ctx.strokeStyle = color;
-    ctx.lineWidth = 2;
-
-    for (let i = 0; i < dataArr.length; i++) {
-        let x = (i / (maxPoints - 1)) * w;
-        let y = h - ((dataArr[i] - min) / range) * h * 0.8 - h * 0.1; 
-        if (i === 0) ctx.moveTo(x, y);
-        else ctx.lineTo(x, y);
-    }
-    ctx.stroke();
-}
-
-function updateData() {
-  fetch('/data').then(response => response.json()).then(data => {
-    // Atualiza valores
-    document.getElementById('valT').innerText = data.t.toFixed(1) + " C";
-    document.getElementById('valH').innerText = data.h.toFixed(1) + " %";
-    document.getElementById('valP').innerText = data.p.toFixed(0) + " hPa";
-    document.getElementById('valU').innerText = data.u.toFixed(2) + " mW";
-    document.getElementById('valL').innerText = data.l + " Raw";
-
-    // Atualiza Histórico
-    pushData('chartT', data.t);
-    pushData('chartH', data.h);
-    pushData('chartP', data.p);
-    pushData('chartU', data.u);
-    pushData('chartL', data.l);
-
-    // Desenha
-    drawChart('chartT', dataHistory.chartT, '#ff6384');
-    drawChart('chartH', dataHistory.chartH, '#36a2eb');
-    drawChart('chartP', dataHistory.chartP, '#cc65fe');
-    drawChart('chartU', dataHistory.chartU, '#ffce56');
-    drawChart('chartL', dataHistory.chartL, '#4bc0c0');
-
-    // Verifica Alarme
-    if (data.alarm && !data.ack) {
-        document.getElementById('alarmModal').style.display = "block";
-    }
-  });
-}
-
-function pushData(key, val) {
-    dataHistory[key].push(val);
-    if (dataHistory[key].length > maxPoints) dataHistory[key].shift();
-}
-
-function confirmAlarm() {
-    fetch('/reset').then(res => {
-        document.getElementById('alarmModal').style.display = "none";
-    });
-}
-
-setInterval(updateData, 1000); // Atualiza a cada 1 segundo
-</script>
-</body>
-</html>
-)rawliteral";
+// O site (5 gráficos e Popup de Alerta) fica em web/index.html, desenhado em
+// Canvas puro para garantir funcionamento OFFLINE. O build comprime a página
+// (scripts/build_dashboard.py) e gera index_html_gz.h com os bytes gzip e o ETag.
 
 // ==========================================
 // FUNÇÕES AUXILIARES
@@ -218,36 +293,403 @@ void setupWiFi()
     Serial.println(IP);
 }
 
+/**
+ * @brief Registra/remove clientes WebSocket na tabela de assinantes
+ * Roda na tarefa do AsyncTCP.
+ */
+void onWsEvent(AsyncWebSocket *socket, AsyncWebSocketClient *client, AwsEventType type, void *arg, uint8_t *data, size_t len)
+{
+    LatencyProbe probe(wsEventHist);
+    if (type == WS_EVT_CONNECT)
+    {
+        lastWebAccess = millis();
+        // Sem espaço: recusa, a página cai para polling
+        if (!wsClients.add(client))
+            client->close();
+    }
+    else if (type == WS_EVT_DISCONNECT)
+    {
+        // Espera um envio em andamento: o AsyncWebSocket libera o cliente na volta
+        wsClients.remove(client);
+    }
+}
+
+/**
+ * @brief Envia a amostra nova (uma única vez) a todos os assinantes
+ * Cliente com fila cheia não está consumindo: é desconectado.
+ */
+void pushSampleToClients()
+{
+    const StationSample sample = sampleBus.read();
+    if (sample.seq == wsLastPushedSeq)
+        return;
+    wsLastPushedSeq = sample.seq;
+
+    // Quadro binário (o mesmo do /data.bin): ~1/4 do JSON e sem formatar floats
+    uint8_t frame[STATION_BIN_SIZE];
+    size_t len = stationSampleToBinary(sample, frame, sizeof(frame));
+    if (len == 0)
+        return;
+
+    // Sem ws.client(id) nem ws.cleanupClients(): os dois percorrem a lista do
+    // AsyncWebSocket, que o AsyncTCP altera ao mesmo tempo. O excesso de
+    // clientes já é recusado na conexão.
+    uint8_t sent = wsClients.forEach([&](AsyncWebSocketClient *client)
+                                     {
+                                         if (client->queueIsFull())
+                                         {
+                                             wsDroppedClients++;
+                                             client->close();
+                                             return false;
+                                         }
+                                         client->binary(frame, len);
+                                         return true; });
+
+    if (sent > 0)
+        lastWebAccess = millis(); // Assinante ativo conta como usuário online
+}
+
+/**
+ * @brief Passa um handler pelo controle de admissão
+ *
+ * Recusada: responde 503 com Retry-After sem executar o handler. Admitida:
+ * a posição é liberada quando a conexão fecha (resposta enviada ou cliente
+ * caiu), o que cobre também as respostas chunked longas.
+ *
+ * @param poll true para rotas de polling (/data, /data.bin)
+ */
+ArRequestHandlerFunction admitted(bool poll, ArRequestHandlerFunction handler)
+{
+    return [poll, handler](AsyncWebServerRequest *request)
+    {
+        uint32_t ip = request->client()->remoteIP();
+        uint16_t retryAfter;
+        if (admission.admit(ip, millis(), poll, retryAfter) != ADMIT_OK)
+        {
+            char value[8];
+            snprintf(value, sizeof(value), "%u", (unsigned)retryAfter);
+            AsyncWebServerResponse *response = request->beginResponse(503, "text/plain", "ocupado");
+            response->addHeader("Retry-After", value);
+            request->send(response);
+            return;
+        }
+        request->onDisconnect([ip]()
+                              { admission.release(ip); });
+        handler(request);
+    };
+}
+
+/**
+ * @brief Entrega uma edição das regras ao taskSensorsAndAlarm e responde
+ */
+void sendAlarmCommand(AsyncWebServerRequest *request, const AlarmCommand &cmd)
+{
+    // Nunca bloqueia o AsyncTCP: fila cheia = tente de novo
+    if (xQueueSend(alarmCommands, &cmd, 0) != pdTRUE)
+    {
+        request->send(503, "text/plain", "ocupado");
+        return;
+    }
+    request->send(200, "text/plain", "OK");
+}
+
+/**
+ * @brief Lê o índice 'i' e confere contra a última tabela publicada
+ * @return false (e já respondeu 400) se não é um número da tabela
+ */
+bool ruleIndexParam(AsyncWebServerRequest *request, const AlarmSnapshot &snap, uint8_t &index)
+{
+    // toInt() devolve 0 para texto e o uint8_t truncaria 256 em 0
+    const String &text = request->getParam("i")->value();
+    char *end = nullptr;
+    long value = strtol(text.c_str(), &end, 10);
+    if (text.length() == 0 || *end != '\0' || value < 0 || value >= snap.count)
+    {
+        request->send(400, "text/plain", "i fora da tabela");
+        return false;
+    }
+    index = (uint8_t)value;
+    return true;
+}
+
+/**
+ * @brief Aplica os parâmetros de /rules/set sobre a regra (ausentes ficam iguais)
+ * @return false se algum parâmetro é inválido ou a regra resultante não é válida
+ */
+bool ruleFromParams(AsyncWebServerRequest *request, AlarmRule &rule)
+{
+    if (request->hasParam("ch") && !AlarmEngine::parseChannel(request->getParam("ch")->value().c_str(), rule.channel))
+        return false;
+    if (request->hasParam("kind") && !AlarmEngine::parseKind(request->getParam("kind")->value().c_str(), rule.kind))
+        return false;
+    if (request->hasParam("thr"))
+        rule.threshold = request->getParam("thr")->value().toFloat();
+    if (request->hasParam("hyst"))
+        rule.hysteresis = request->getParam("hyst")->value().toFloat();
+    if (request->hasParam("min"))
+        rule.minDurationMs = strtoul(request->getParam("min")->value().c_str(), nullptr, 10);
+    if (request->hasParam("win"))
+        rule.rateWindowMs = strtoul(request->getParam("win")->value().c_str(), nullptr, 10);
+    if (request->hasParam("on"))
+        rule.enabled = request->getParam("on")->value().toInt() != 0;
+    return AlarmEngine::valid(rule);
+}
+
 void setupWebServer()
 {
-    // Rota Principal
-    server.on("/", HTTP_GET, [](AsyncWebServerRequest *request)
+    // Rota Principal: página pré-comprimida + cache por ETag
+    server.on("/", HTTP_GET, admitted(false, [](AsyncWebServerRequest *request)
               {
+        LatencyProbe probe(httpRootHist);
         lastWebAccess = millis(); // Detecta acesso ao abrir a página
-        request->send_P(200, "text/html", index_html); });
+
+        // Navegador já tem esta versão: 304 sem corpo
+        if (request->hasHeader("If-None-Match") &&
+            request->getHeader("If-None-Match")->value().indexOf(INDEX_HTML_ETAG) >= 0)
+        {
+            AsyncWebServerResponse *response = request->beginResponse(304);
+            response->addHeader("ETag", INDEX_HTML_ETAG);
+            response->addHeader("Cache-Control", "no-cache");
+            request->send(response);
+            return;
+        }
+
+        AsyncWebServerResponse *response = request->beginResponse_P(200, "text/html", index_html_gz, INDEX_HTML_GZ_LEN);
+        response->addHeader("Content-Encoding", "gzip");
+        response->addHeader("ETag", INDEX_HTML_ETAG);
+        response->addHeader("Cache-Control", "no-cache"); // Sempre revalida (barato: 304)
+        request->send(response); }));
 
     // Rota de Dados (JSON)
-    server.on("/data", HTTP_GET, [](AsyncWebServerRequest *request)
+    server.on("/data", HTTP_GET, admitted(true, [](AsyncWebServerRequest *request)
               {
+        LatencyProbe probe(httpDataHist);
         lastWebAccess = millis(); //
-        
-        String json = "{";
-        json += "\"t\":" + String(sharedTemp) + ",";
-        json += "\"h\":" + String(sharedHum) + ",";
-        json += "\"p\":" + String(sharedPres) + ",";
-        json += "\"u\":" + String(sharedUV) + ",";
-        json += "\"l\":" + String(sharedLumens) + ",";
-        json += "\"alarm\":" + String(alarmCondition ? "true" : "false") + ",";
-        json += "\"ack\":" + String(alarmAcknowledged ? "true" : "false");
-        json += "}";
-        request->send(200, "application/json", json); });
-
-    // Rota de Reset do Alarme
-    server.on("/reset", HTTP_GET, [](AsyncWebServerRequest *request)
+
+        // Cópia única do último ciclo: todos os campos do mesmo instante
+        const StationSample sample = sampleBus.read();
+
+        // Serialização direto na pilha, sem concatenação de String. O
+        // send(String) copiaria duas vezes no heap e o send_P só guardaria o
+        // ponteiro da pilha: o JSON vai copiado uma vez para dentro do callback
+        char json[STATION_JSON_MAX];
+        size_t len = stationSampleToJson(sample, json, sizeof(json));
+        request->send(request->beginResponse("application/json", len,
+            [json, len](uint8_t *buffer, size_t maxLen, size_t index) -> size_t
+            {
+                size_t n = len - index < maxLen ? len - index : maxLen;
+                memcpy(buffer, json + index, n);
+                return n; })); }));
+
+    // Mesma amostra em binário (formato em StationBinary.h), lida com DataView
+    server.on("/data.bin", HTTP_GET, admitted(true, [](AsyncWebServerRequest *request)
               {
+        LatencyProbe probe(httpDataBinHist);
+        lastWebAccess = millis();
+
+        const StationSample sample = sampleBus.read();
+        uint8_t frame[STATION_BIN_SIZE];
+        size_t len = stationSampleToBinary(sample, frame, sizeof(frame));
+        // send_P só guarda o ponteiro: o quadro vai copiado para dentro do callback
+        request->send(request->beginResponse("application/octet-stream", len,
+            [frame, len](uint8_t *buffer, size_t maxLen, size_t index) -> size_t
+            {
+                size_t n = len - index < maxLen ? len - index : maxLen;
+                memcpy(buffer, frame + index, n);
+                return n; })); }));
+
+    // Rota de Histórico: /history?channel=t|h|p|u|l&res=s|m|h&from=<s de uptime>
+    // Resposta chunked: memória constante, gerada direto do HistoryStore
+    server.on("/history", HTTP_GET, admitted(false, [](AsyncWebServerRequest *request)
+              {
+        LatencyProbe probe(httpHistoryHist);
+        lastWebAccess = millis();
+
+        HistoryChannel ch;
+        HistoryResolution res = HIST_RES_SECOND;
+        if (!request->hasParam("channel") ||
+            !HistoryJsonStream::parseChannel(request->getParam("channel")->value().c_str(), ch))
+        {
+            request->send(400, "text/plain", "channel: t, h, p, u ou l");
+            return;
+        }
+        if (request->hasParam("res") &&
+            !HistoryJsonStream::parseResolution(request->getParam("res")->value().c_str(), res))
+        {
+            request->send(400, "text/plain", "res: s, m ou h");
+            return;
+        }
+        uint32_t from = request->hasParam("from") ? request->getParam("from")->value().toInt() : 0;
+
+        HistoryJsonStream stream(history, ch, res, from, stationSeconds());
+        request->send(request->beginChunkedResponse("application/json",
+            [stream](uint8_t *buffer, size_t maxLen, size_t index) mutable -> size_t
+            {
+                LatencyProbe chunkProbe(httpHistoryChunkHist);
+                return stream.fill(buffer, maxLen); })); }));
+
+    // Exportação do log em flash: /export?from=<unix>&to=<unix>&format=csv|ndjson
+    // Lê o log pedaço a pedaço (memória constante para qualquer intervalo)
+    server.on("/export", HTTP_GET, admitted(false, [](AsyncWebServerRequest *request)
+              {
+        lastWebAccess = millis();
+        if (!logReady)
+        {
+            request->send(503, "text/plain", "log indisponivel");
+            return;
+        }
+
+        LogExportFormat format = LOG_EXPORT_CSV;
+        if (request->hasParam("format") &&
+            !LogExportStream::parseFormat(request->getParam("format")->value().c_str(), format))
+        {
+            request->send(400, "text/plain", "format: csv ou ndjson");
+            return;
+        }
+        uint32_t from = request->hasParam("from") ? strtoul(request->getParam("from")->value().c_str(), nullptr, 10) : 0;
+        uint32_t to = request->hasParam("to") ? strtoul(request->getParam("to")->value().c_str(), nullptr, 10) : UINT32_MAX;
+
+        xSemaphoreTake(logMutex, portMAX_DELAY);
+        LogExportStream stream(sampleLog, from, to, format);
+        xSemaphoreGive(logMutex);
+
+        AsyncWebServerResponse *response = request->beginChunkedResponse(LogExportStream::contentType(format),
+            [stream](uint8_t *buffer, size_t maxLen, size_t index) mutable -> size_t
+            {
+                LatencyProbe chunkProbe(httpExportChunkHist);
+                // O sensor só espera durante um pedaço, nunca a exportação inteira
+                xSemaphoreTake(logMutex, portMAX_DELAY);
+                size_t len = stream.fill(buffer, maxLen);
+                xSemaphoreGive(logMutex);
+                return len; });
+        response->addHeader("Content-Disposition", format == LOG_EXPORT_CSV ? "attachment; filename=estacao.csv"
+                                                                            : "attachment; filename=estacao.ndjson");
+        request->send(response); }));
+
+    // Saúde: heap livre, maior bloco, mínimo e folga de pilha (última hora)
+    server.on("/health", HTTP_GET, admitted(false, [](AsyncWebServerRequest *request)
+              {
+        LatencyProbe probe(httpHealthHist);
+        HealthJsonStream stream(healthBus.read());
+        request->send(request->beginChunkedResponse("application/json",
+            [stream](uint8_t *buffer, size_t maxLen, size_t index) mutable -> size_t
+            { return stream.fill(buffer, maxLen); })); }));
+
+    // Métricas no formato texto do Prometheus (latência das tarefas e handlers)
+    server.on("/metrics", HTTP_GET, admitted(false, [](AsyncWebServerRequest *request)
+              {
+        LatencyProbe probe(httpMetricsHist);
+        PrometheusStream stream(metrics);
+        request->send(request->beginChunkedResponse("text/plain; version=0.0.4",
+            [stream](uint8_t *buffer, size_t maxLen, size_t index) mutable -> size_t
+            { return stream.fill(buffer, maxLen); })); }));
+
+    // Canal push (WebSocket)
+    ws.onEvent(onWsEvent);
+    server.addHandler(&ws);
+
+    // Rota de Hora: /time?epoch=<s Unix UTC>. A estação não tem RTC nem internet,
+    // então o navegador informa a hora ao abrir a página (efeméride do tracker)
+    server.on("/time", HTTP_GET, admitted(false, [](AsyncWebServerRequest *request)
+              {
+        LatencyProbe probe(httpTimeHist);
+        if (request->hasParam("epoch"))
+        {
+            uint32_t epoch = strtoul(request->getParam("epoch")->value().c_str(), nullptr, 10);
+            if (epoch < CLOCK_VALID_EPOCH)
+            {
+                request->send(400, "text/plain", "epoch invalido");
+                return;
+            }
+            struct timeval tv = {(time_t)epoch, 0};
+            settimeofday(&tv, nullptr);
+        }
+        char reply[12];
+        snprintf(reply, sizeof(reply), "%lu", (unsigned long)time(nullptr));
+        request->send(200, "text/plain", reply); }));
+
+    // Rota de Reset do Alarme: confirma todas as regras disparadas
+    server.on("/reset", HTTP_GET, admitted(false, [](AsyncWebServerRequest *request)
+              {
+        LatencyProbe probe(httpResetHist);
         lastWebAccess = millis(); // Considera como atividade também
-        alarmAcknowledged = true; 
-        request->send(200, "text/plain", "OK"); });
+        AlarmCommand cmd = {};
+        cmd.op = ALARM_OP_ACK_ALL;
+        sendAlarmCommand(request, cmd); }));
+
+    // Regras de alarme. As rotas /rules/... vêm antes de /rules, que também
+    // aceitaria os caminhos abaixo dele.
+    // /rules/set?i=<índice>&ch=t|h|p|u|l&kind=above|below|rise|fall&thr=&hyst=&min=<ms>&win=<ms>&on=0|1
+    // Sem 'i' acrescenta uma regra; com 'i' os campos ausentes ficam como estão
+    server.on("/rules/set", HTTP_GET, admitted(false, [](AsyncWebServerRequest *request)
+              {
+        LatencyProbe probe(httpRulesHist);
+        const AlarmSnapshot snap = alarmBus.read();
+        AlarmCommand cmd = {};
+        cmd.op = ALARM_OP_SET;
+        cmd.index = snap.count;
+        cmd.rule.enabled = 1;
+        if (request->hasParam("i"))
+        {
+            if (!ruleIndexParam(request, snap, cmd.index))
+                return;
+            cmd.rule = snap.rules[cmd.index];
+        }
+        else if (snap.count >= ALARM_MAX_RULES)
+        {
+            request->send(400, "text/plain", "tabela cheia");
+            return;
+        }
+        else if (!request->hasParam("ch") || !request->hasParam("kind") || !request->hasParam("thr"))
+        {
+            request->send(400, "text/plain", "regra nova exige ch, kind e thr");
+            return;
+        }
+        if (!ruleFromParams(request, cmd.rule))
+        {
+            request->send(400, "text/plain", "regra invalida");
+            return;
+        }
+        sendAlarmCommand(request, cmd); }));
+
+    // /rules/delete?i=<índice> (as regras seguintes andam uma posição)
+    server.on("/rules/delete", HTTP_GET, admitted(false, [](AsyncWebServerRequest *request)
+              {
+        LatencyProbe probe(httpRulesHist);
+        if (!request->hasParam("i"))
+        {
+            request->send(400, "text/plain", "i obrigatorio");
+            return;
+        }
+        AlarmCommand cmd = {};
+        cmd.op = ALARM_OP_REMOVE;
+        if (!ruleIndexParam(request, alarmBus.read(), cmd.index))
+            return;
+        sendAlarmCommand(request, cmd); }));
+
+    // /rules/ack?i=<índice> confirma uma regra; sem 'i' confirma todas
+    server.on("/rules/ack", HTTP_GET, admitted(false, [](AsyncWebServerRequest *request)
+              {
+        LatencyProbe probe(httpRulesHist);
+        lastWebAccess = millis();
+        AlarmCommand cmd = {};
+        cmd.op = ALARM_OP_ACK_ALL;
+        if (request->hasParam("i"))
+        {
+            cmd.op = ALARM_OP_ACK;
+            if (!ruleIndexParam(request, alarmBus.read(), cmd.index))
+                return;
+        }
+        sendAlarmCommand(request, cmd); }));
+
+    // Tabela com o estado de cada regra (chunked, a partir da última cópia publicada)
+    server.on("/rules", HTTP_GET, admitted(false, [](AsyncWebServerRequest *request)
+              {
+        LatencyProbe probe(httpRulesHist);
+        AlarmJsonStream stream(alarmBus.read());
+        request->send(request->beginChunkedResponse("application/json",
+            [stream](uint8_t *buffer, size_t maxLen, size_t index) mutable -> size_t
+            { return stream.fill(buffer, maxLen); })); }));
 
     server.begin();
 }
@@ -258,86 +700,309 @@ void setupWebServer()
 
 void taskTracker()
 {
-    solarTracker.update();
+    // Uma varredura de todos os canais analógicos por ciclo do tracker
+    const AnalogSnapshot &snap = analogInputs.scan(Hal::clock().millis());
+    analogBus.write(snap);
+
+    uvSensor.pushSample(snap.raw[CH_UV]);
+
+    // Posição do sol uma vez por segundo, depois que o relógio foi acertado
+    static uint32_t lastSunMs = 0;
+    if (snap.timestampMs - lastSunMs >= 1000)
+    {
+        lastSunMs = snap.timestampMs;
+        time_t now = time(nullptr);
+        if ((uint32_t)now >= CLOCK_VALID_EPOCH)
+        {
+            SolarPosition sun;
+            solarPosition((uint32_t)now, SITE_LATITUDE, SITE_LONGITUDE, sun);
+            solarTracker.setSunPosition(sun);
+        }
+    }
+
+    solarTracker.update(snap.raw[CH_LDR_TL], snap.raw[CH_LDR_TR], snap.raw[CH_LDR_BL], snap.raw[CH_LDR_BR]);
 }
-void taskSensorsAndAlarm()
+/**
+ * @brief Média em lux dos 4 LDRs de uma varredura
+ */
+int32_t luxFromSnapshot(const AnalogSnapshot &snap)
 {
-    // 1. Leitura de Sensores
-    if (bmeFound)
+    // Cada LDR é convertido para lux antes da média (a curva não é linear)
+    int32_t luxSum = 0;
+    for (uint8_t ch = CH_LDR_TL; ch <= CH_LDR_BR; ch++)
+        luxSum += calInterpolate(LDR_LUX_CURVE, adcCal.rawToMv(snap.raw[ch]));
+    return luxSum / 4;
+}
+
+/**
+ * @brief Valores da amostra na ordem dos canais (t, h, p, u, l)
+ *
+ * Sem leitura do BME280 os canais dele ficam ausentes (NaN, não zero).
+ */
+void sampleValues(const StationSample &sample, float values[HIST_CHANNELS])
+{
+    const bool ok = sample.bmeOk;
+    values[HIST_TEMP] = ok ? sample.temp : NAN;
+    values[HIST_HUM] = ok ? sample.hum : NAN;
+    values[HIST_PRES] = ok ? sample.pres : NAN;
+    values[HIST_UV] = sample.uv;
+    values[HIST_LUMENS] = (float)sample.lumens;
+}
+
+/**
+ * @brief Alguma regra de limiar ultrapassada nesta amostra isolada (sem duração)
+ */
+bool alarmActive(const StationSample &sample)
+{
+    float values[HIST_CHANNELS];
+    sampleValues(sample, values);
+    return alarmEngine.exceeds(values);
+}
+
+/**
+ * @brief Grava uma amostra no histórico
+ */
+void addToHistory(uint32_t sec, const StationSample &sample)
+{
+    // Publicações extras no mesmo segundo entram na média do slot
+    float values[HIST_CHANNELS];
+    sampleValues(sample, values);
+    history.add(sec, values);
+}
+
+/**
+ * @brief Vigia nos canais adaptativos os limiares das regras de valor ligadas
+ *
+ * Chamada quando a tabela de regras muda. Perto de um limiar o canal é lido
+ * no período mínimo, então a regra vê a travessia sem esperar o período longo.
+ */
+void watchAlarmThresholds()
+{
+    // Mesma ordem de AlarmChannel
+    AdaptiveChannel *const channels[ALARM_CH_COUNT] = {&tempChannel, &humChannel, &presChannel, &uvChannel,
+                                                       &luxChannel};
+    float levels[ALARM_CH_COUNT][ADAPTIVE_MAX_WATCH];
+    uint8_t counts[ALARM_CH_COUNT] = {0};
+    for (uint8_t i = 0; i < alarmEngine.count(); i++)
     {
-        sharedTemp = bme.readTemperature();
-        sharedHum = bme.readHumidity();
-        sharedPres = bme.readPressure() / 100.0F;
+        const AlarmRule &rule = alarmEngine.rule(i);
+        if (!rule.enabled || (rule.kind != ALARM_ABOVE && rule.kind != ALARM_BELOW))
+            continue;
+        if (counts[rule.channel] < ADAPTIVE_MAX_WATCH)
+            levels[rule.channel][counts[rule.channel]++] = rule.threshold;
     }
-    else
+    for (uint8_t c = 0; c < ALARM_CH_COUNT; c++)
+        channels[c]->setWatch(levels[c], counts[c]);
+}
+
+/**
+ * @brief Lê o BME280 quando qualquer um dos três canais vence
+ *
+ * As três grandezas saem da mesma rajada I2C, então o grupo é lido junto e
+ * todos os canais aproveitam a leitura. A conversão é disparada num passo e
+ * lida no seguinte (a conversão x1 leva ~10 ms), para o valor não ter a
+ * idade de um período inteiro como na leitura encadeada do modo forçado.
+ * @return true se algum canal mudou além da sua deadband
+ */
+bool sampleClimate(uint32_t now)
+{
+    if (!bmeFound)
+        return false;
+
+    if (!bmePending)
     {
-        sharedTemp = 0.0;
-        sharedHum = 0.0;
-        sharedPres = 0.0;
+        if (tempChannel.due(now) || humChannel.due(now) || presChannel.due(now))
+        {
+            bme.startMeasurement();
+            bmePending = true;
+        }
+        return false;
     }
+    bmePending = false;
 
-    sharedUV = uvSensor.readUVIntensity();
+    BME280Reading bmeReading;
+    if (bme.read(bmeReading, false))
+    {
+        currentSample.temp = bmeReading.temp;
+        currentSample.hum = bmeReading.hum;
+        currentSample.pres = bmeReading.pres;
+        currentSample.bmeOk = true;
+    }
+    else
+    {
+        currentSample.temp = 0.0;
+        currentSample.hum = 0.0;
+        currentSample.pres = 0.0;
+        currentSample.bmeOk = false;
+    }
 
-    int l1 = analogRead(LDR_TOP_LEFT);
-    int l2 = analogRead(LDR_TOP_RIGHT);
-    int l3 = analogRead(LDR_BOT_LEFT);
-    int l4 = analogRead(LDR_BOT_RIGHT);
-    sharedLumens = (l1 + l2 + l3 + l4) / 4;
+    // NaN = leitura falhou: os canais tentam de novo no período mínimo
+    const bool ok = currentSample.bmeOk;
+    bool changed = tempChannel.update(now, ok ? currentSample.temp : NAN);
+    changed |= humChannel.update(now, ok ? currentSample.hum : NAN);
+    changed |= presChannel.update(now, ok ? currentSample.pres : NAN);
+    return changed;
+}
 
-    // 2. Lógica de Alarme
-    bool condT = (sharedTemp > ALARM_TEMP);
-    bool condH = (sharedHum > ALARM_HUM);
-    bool condP = (sharedPres > ALARM_PRES);
-    bool condU = (sharedUV > ALARM_UV);
-    bool condL = (sharedLumens > ALARM_LUMENS);
+/**
+ * @brief Atualiza UV e luz a partir da última varredura do taskTracker
+ * @return true se algum canal mudou além da sua deadband
+ */
+bool sampleLight(uint32_t now)
+{
+    bool changed = false;
 
-    if (condT || condH || condP || condU || condL)
+    // Média do buffer circular, alimentado pelas varreduras do taskTracker().
+    // Com a janela cheia a média é uma leitura de palavra única, segura entre tarefas.
+    if (uvChannel.due(now) && uvSensor.isReady())
     {
-        alarmCondition = true;
+        currentSample.uv = uvSensor.getUVIntensity();
+        changed |= uvChannel.update(now, currentSample.uv);
     }
-    else
+
+    if (luxChannel.due(now))
     {
-        alarmCondition = false;
+        // Reaproveita a última varredura em vez de ler os LDRs de novo
+        currentSample.lumens = luxFromSnapshot(analogBus.read());
+        changed |= luxChannel.update(now, (float)currentSample.lumens);
     }
+    return changed;
+}
+
+/**
+ * @brief Avalia o alarme e publica os valores atuais para leitores e histórico
+ */
+void publishSample(uint32_t now)
+{
+    // Regras com histerese e duração mínima; a cópia vai para o /rules
+    float values[HIST_CHANNELS];
+    sampleValues(currentSample, values);
+    alarmEngine.evaluate(values, now);
+    alarmBus.write(alarmEngine.snapshot());
+    currentSample.alarm = alarmEngine.raised();
+    currentSample.ack = alarmEngine.raised() && !alarmEngine.active();
+    currentSample.timestampMs = now;
+
+    // Publicação: o escritor nunca bloqueia
+    currentSample.seq = ++sampleSeq;
+    sampleBus.write(currentSample);
+    lastPublishMs = now;
 
-    // 3. Controle dos LEDs
-    unsigned long currentMillis = millis();
+    history.add(stationSeconds(), values);
+}
 
+/**
+ * @brief Hora UTC para o log (0 enquanto o relógio não foi acertado)
+ * @param sec Tempo da estação da amostra, em segundos
+ */
+uint32_t unixTimeAt(uint32_t sec)
+{
+    time_t epoch = time(nullptr);
+    uint32_t age = stationSeconds() - sec;
+    if (epoch < (time_t)CLOCK_VALID_EPOCH + age)
+        return 0;
+    return (uint32_t)epoch - age;
+}
+
+/**
+ * @brief Acrescenta uma amostra ao log em flash (só grava quando o lote enche)
+ */
+void logSample(const StationSample &sample, uint32_t sec, uint32_t now)
+{
+    BatchRecord record;
+    batchRecordFromSample(sample, sec, record);
+    xSemaphoreTake(logMutex, portMAX_DELAY);
+    sampleLog.append(unixTimeAt(sec), record, now);
+    xSemaphoreGive(logMutex);
+}
+
+/**
+ * @brief LED vermelho/buzzer do alarme e LED azul de conexão web
+ */
+void updateIndicators(uint32_t now)
+{
     // --- LÓGICA DO LED VERMELHO (ALARME) ---
-    if (alarmCondition && !alarmAcknowledged)
+    if (currentSample.alarm && !currentSample.ack)
     {
         blinkState = !blinkState; // Pisca rápido no alarme
         if (blinkState)
         {
-            digitalWrite(PIN_LED_RED, HIGH);
-            tone(PIN_BUZZER, 2000);
+            Hal::gpio().write(PIN_LED_RED, true);
+            Hal::gpio().tone(PIN_BUZZER, 2000);
         }
         else
         {
-            digitalWrite(PIN_LED_RED, LOW);
-            noTone(PIN_BUZZER);
+            Hal::gpio().write(PIN_LED_RED, false);
+            Hal::gpio().noTone(PIN_BUZZER);
         }
     }
     else
     {
-        digitalWrite(PIN_LED_RED, LOW);
-        noTone(PIN_BUZZER);
+        Hal::gpio().write(PIN_LED_RED, false);
+        Hal::gpio().noTone(PIN_BUZZER);
     }
 
     // --- LÓGICA DO LED AZUL (STATUS CONEXÃO WEB) ---
     // Se o último acesso foi a menos de 3 segundos (WEB_TIMEOUT)
-    if (currentMillis - lastWebAccess < WEB_TIMEOUT)
+    if (now - lastWebAccess < WEB_TIMEOUT)
     {
-        digitalWrite(PIN_LED_BLUE, HIGH); // Acende FIXO indicando usuário online
+        Hal::gpio().write(PIN_LED_BLUE, true); // Acende FIXO indicando usuário online
     }
     else
     {
-        digitalWrite(PIN_LED_BLUE, LOW); // Apaga se ninguém estiver na página
+        Hal::gpio().write(PIN_LED_BLUE, false); // Apaga se ninguém estiver na página
     }
 }
 
+void taskSensorsAndAlarm()
+{
+    uint32_t now = Hal::clock().millis();
+
+    // Edições das regras pedidas pelo WebServer (saem na publicação abaixo)
+    bool changed = false;
+    AlarmCommand cmd;
+    while (xQueueReceive(alarmCommands, &cmd, 0) == pdTRUE)
+        changed |= alarmEngine.apply(cmd);
+    if (changed)
+    {
+        watchAlarmThresholds();
+#ifdef STATION_LOW_POWER
+        alarmEngine.saveRules(rtcRules); // O próximo despertar avalia a tabela editada
+#endif
+    }
+
+    // 1. Leitura de Sensores: cada canal só é lido quando a política dele vence
+    changed |= sampleClimate(now);
+    changed |= sampleLight(now);
+
+    // 2. Publicação: mudança relevante sai na hora, o resto a cada segundo
+    if (changed || now - lastPublishMs >= PUBLISH_PERIOD_MS)
+        publishSample(now);
+
+    // 3. Log em flash, numa cadência fixa
+    if (logReady && now - lastLogMs >= LOG_PERIOD_MS)
+    {
+        lastLogMs = now;
+        logSample(currentSample, stationSeconds(), now);
+    }
+
+    // 4. Controle dos LEDs (cadência fixa, independente do passo da tarefa)
+    if (now - lastIndicatorMs >= INDICATOR_PERIOD_MS)
+    {
+        lastIndicatorMs = now;
+        updateIndicators(now);
+    }
+}
+
+void taskNetwork()
+{
+    pushSampleToClients();
+}
+
 void taskDisplay()
 {
+    const StationSample sample = sampleBus.read();
+
     display.clearDisplay();
     display.setTextSize(1);
 
@@ -347,7 +1012,7 @@ void taskDisplay()
     display.println(WiFi.softAPIP());
     display.drawLine(0, 10, 128, 10, WHITE);
 
-    if (alarmCondition && !alarmAcknowledged)
+    if (sample.alarm && !sample.ack)
     {
         display.setCursor(20, 25);
         display.setTextSize(2);
@@ -359,26 +1024,360 @@ void taskDisplay()
     else
     {
         display.setCursor(0, 15);
-        display.printf("Temp: %.1f C", sharedTemp);
+        display.printf("Temp: %.1f C", sample.temp);
         display.setCursor(0, 25);
-        display.printf("Umid: %.1f %%", sharedHum);
+        display.printf("Umid: %.1f %%", sample.hum);
         display.setCursor(0, 35);
-        display.printf("Pres: %.0f hPa", sharedPres);
+        display.printf("Pres: %.0f hPa", sample.pres);
         display.setCursor(0, 45);
-        display.printf("UV:   %.2f", sharedUV);
+        display.printf("UV:   %.2f", sample.uv);
         display.setCursor(0, 55);
-        display.printf("Lux:  %d", sharedLumens);
+        display.printf("Lux:  %d", (int)sample.lumens);
+    }
+
+    // Em vez de display.display() (1 KB sempre), envia só o que mudou
+    const uint8_t *frame = display.getBuffer();
+    if (frame != nullptr)
+        oledFlusher.flush(frame);
+}
+
+// Tabela de tarefas: período, prioridade e core de cada subsistema.
+// Display (core 0) e BME280 (core 1) dividem o I2C: cada transação do Wire
+// é protegida internamente pelo core Arduino, e os endereços são distintos.
+PeriodicTask tasks[] = {
+    // nome       função               período  prio  core          stack
+    {"tracker", taskTracker, 50, 4, CORE_CONTROL, 4096},
+    {"sensors", taskSensorsAndAlarm, SENSOR_TICK_MS, 3, CORE_CONTROL, 4096},
+    {"display", taskDisplay, 200, 1, CORE_IO, 4096},
+    {"network", taskNetwork, 100, 2, CORE_IO, 4096},
+};
+const size_t TASK_COUNT = sizeof(tasks) / sizeof(tasks[0]);
+
+/**
+ * @brief Laço genérico das tarefas periódicas
+ * Usa vTaskDelayUntil para período fixo (sem deriva) e conta perdas de prazo.
+ */
+void periodicTaskLoop(void *arg)
+{
+    PeriodicTask *task = (PeriodicTask *)arg;
+    const TickType_t period = pdMS_TO_TICKS(task->periodMs);
+    const uint32_t periodUs = task->periodMs * 1000;
+    TickType_t lastWake = xTaskGetTickCount();
+    HalClock &clock = Hal::clock();
+    uint32_t expectedUs = clock.micros(); // Horário nominal da próxima execução
+
+    for (;;)
+    {
+        // Atraso (jitter) do despertar em relação ao período nominal
+        uint32_t startUs = clock.micros();
+        int32_t lateUs = (int32_t)(startUs - expectedUs);
+        task->lateHist.record(lateUs > 0 ? lateUs : 0);
+
+        // Duração pelo contador de ciclos (a tarefa é fixa em um core)
+        uint32_t startCycles = clock.cycles();
+        task->run();
+        uint32_t execUs = (clock.cycles() - startCycles) / clock.cyclesPerUs();
+
+        task->runs++;
+        task->lastExecUs = execUs;
+        if (execUs > task->maxExecUs)
+            task->maxExecUs = execUs;
+        task->execHist.record(execUs);
+
+        // Terminou depois do próximo disparo: prazo perdido.
+        // Ressincroniza em vez de executar várias vezes seguidas para "recuperar".
+        expectedUs += periodUs;
+        if ((TickType_t)(xTaskGetTickCount() - lastWake) >= period)
+        {
+            task->misses++;
+            lastWake = xTaskGetTickCount();
+            expectedUs = clock.micros() + periodUs;
+        }
+
+        vTaskDelayUntil(&lastWake, period);
+    }
+}
+
+void startTasks()
+{
+    for (size_t i = 0; i < TASK_COUNT; i++)
+    {
+        xTaskCreatePinnedToCore(periodicTaskLoop, tasks[i].name, tasks[i].stackSize, &tasks[i],
+                                tasks[i].priority, &tasks[i].handle, tasks[i].core);
+    }
+}
+
+/**
+ * @brief Monta a tabela do /metrics (tarefas, handlers e contadores)
+ */
+void setupMetrics()
+{
+    int taskExec = metrics.addFamily("station_task_exec", "Duração de cada execução da tarefa", "task", METRIC_HISTOGRAM);
+    int taskLate = metrics.addFamily("station_task_lateness", "Atraso do início em relação ao período nominal", "task", METRIC_HISTOGRAM);
+    int taskOverruns = metrics.addFamily("station_task_overruns", "Execuções que passaram do próximo disparo", "task", METRIC_COUNTER);
+    for (size_t i = 0; i < TASK_COUNT; i++)
+    {
+        metrics.addHistogram(taskExec, tasks[i].name, tasks[i].execHist);
+        metrics.addHistogram(taskLate, tasks[i].name, tasks[i].lateHist);
+        metrics.addCounter(taskOverruns, tasks[i].name, tasks[i].misses);
+    }
+
+    int http = metrics.addFamily("station_http_handler", "Tempo dos handlers HTTP/WebSocket", "route", METRIC_HISTOGRAM);
+    metrics.addHistogram(http, "/", httpRootHist);
+    metrics.addHistogram(http, "/data", httpDataHist);
+    metrics.addHistogram(http, "/data.bin", httpDataBinHist);
+    metrics.addHistogram(http, "/history", httpHistoryHist);
+    metrics.addHistogram(http, "/history:chunk", httpHistoryChunkHist);
+    metrics.addHistogram(http, "/time", httpTimeHist);
+    metrics.addHistogram(http, "/reset", httpResetHist);
+    metrics.addHistogram(http, "/metrics", httpMetricsHist);
+    metrics.addHistogram(http, "/rules", httpRulesHist);
+    metrics.addHistogram(http, "/export:chunk", httpExportChunkHist);
+    metrics.addHistogram(http, "/health", httpHealthHist);
+    metrics.addHistogram(http, "/ws", wsEventHist);
+
+    int wsDropped = metrics.addFamily("station_ws_dropped_clients", "Clientes WebSocket derrubados por fila cheia", "socket", METRIC_COUNTER);
+    metrics.addCounter(wsDropped, "/ws", wsDroppedClients);
+
+    int requests = metrics.addFamily("station_http_requests", "Requisições HTTP por decisão da admissão", "result", METRIC_COUNTER);
+    for (int i = 0; i < ADMIT_RESULT_COUNT; i++)
+        metrics.addCounter(requests, AdmissionControl::resultName((AdmissionResult)i), admission.stats().results[i]);
+}
+
+void printTaskStats()
+{
+    Serial.println("--- Tarefas ---");
+    for (size_t i = 0; i < TASK_COUNT; i++)
+    {
+        Serial.printf("%-8s core %d | %4lu ms | runs %6lu | misses %4lu | exec %6lu us (p99 %6lu, max %6lu) | atraso p99 %6lu us\n",
+                      tasks[i].name, (int)tasks[i].core, (unsigned long)tasks[i].periodMs,
+                      (unsigned long)tasks[i].runs, (unsigned long)tasks[i].misses,
+                      (unsigned long)tasks[i].lastExecUs, (unsigned long)tasks[i].execHist.percentileUs(990),
+                      (unsigned long)tasks[i].maxExecUs, (unsigned long)tasks[i].lateHist.percentileUs(990));
+    }
+    Serial.printf("OLED I2C: %lu B/s em %lu us/s (display() completo: %lu B/s)\n",
+                  (unsigned long)oledFlusher.bytesPerSec(), (unsigned long)oledFlusher.busyUsPerSec(),
+                  (unsigned long)oledFlusher.fullBytesPerSec());
+
+    uint32_t now = millis();
+    const ServoActuator &sx = solarTracker.actuatorX();
+    const ServoActuator &sy = solarTracker.actuatorY();
+    Serial.printf("Servos: X %lu escritas/h, PWM ativo %lu s | Y %lu escritas/h, PWM ativo %lu s\n",
+                  (unsigned long)sx.writesPerHour(now), (unsigned long)(sx.activeMs(now) / 1000),
+                  (unsigned long)sy.writesPerHour(now), (unsigned long)(sy.activeMs(now) / 1000));
+    Serial.printf("Amostragem: T %lu (%lu ms) | H %lu (%lu ms) | P %lu (%lu ms) | UV %lu | luz %lu\n",
+                  (unsigned long)tempChannel.samples(), (unsigned long)tempChannel.periodMs(),
+                  (unsigned long)humChannel.samples(), (unsigned long)humChannel.periodMs(),
+                  (unsigned long)presChannel.samples(), (unsigned long)presChannel.periodMs(),
+                  (unsigned long)uvChannel.samples(), (unsigned long)luxChannel.samples());
+    const AdmissionStats &adm = admission.stats();
+    Serial.printf("HTTP: %lu em andamento (pico %lu), %lu clientes | aceitas %lu | recusadas: ocupado %lu, polling %lu, tabela %lu\n",
+                  (unsigned long)adm.inFlight, (unsigned long)adm.peakInFlight, (unsigned long)adm.clients,
+                  (unsigned long)adm.results[ADMIT_OK], (unsigned long)adm.results[ADMIT_SHED_BUSY],
+                  (unsigned long)adm.results[ADMIT_SHED_RATE], (unsigned long)adm.results[ADMIT_SHED_TABLE]);
+
+    const HealthReading &health = healthMonitor.latest();
+    Serial.printf("Heap: livre %lu, maior bloco %lu (frag %u%%), mínimo %lu | tendência %ld B/h | pilha livre:",
+                  (unsigned long)health.freeHeap, (unsigned long)health.largestBlock,
+                  (unsigned)HealthMonitor::fragmentation(health), (unsigned long)health.minFreeHeap,
+                  (long)healthMonitor.snapshot().freeHeapTrendPerHour);
+    for (size_t i = 0; i < HEALTH_TASK_COUNT; i++)
+        Serial.printf(" %s %u", HEALTH_TASK_NAMES[i], (unsigned)health.stackFree[i]);
+    Serial.println(healthMonitor.warnings() ? " | AVISO" : "");
+
+    if (logReady)
+        Serial.printf("Log: seq %lu a %lu (%u na RAM) em %u segmentos | %lu escritas, %lu KB | descartadas %lu\n",
+                      (unsigned long)sampleLog.firstSeq(), (unsigned long)sampleLog.nextSeq(),
+                      (unsigned)sampleLog.pending(), (unsigned)sampleLog.segments(),
+                      (unsigned long)sampleLog.flushes(), (unsigned long)(sampleLog.bytesWritten() / 1024),
+                      (unsigned long)sampleLog.dropped());
+}
+
+/**
+ * @brief Lê heap e folga de pilha das tarefas acompanhadas
+ */
+void readHealth(HealthReading &reading)
+{
+    static_assert(HEALTH_TASK_COUNT == TASK_COUNT + 2, "HEALTH_TASK_NAMES = tasks[] + async_tcp + loopTask");
+    static TaskHandle_t asyncTcpTask = nullptr;
+    if (asyncTcpTask == nullptr)
+        asyncTcpTask = xTaskGetHandle("async_tcp"); // Criada pelo AsyncTCP no server.begin()
+
+    TaskHandle_t handles[HEALTH_TASK_COUNT];
+    for (size_t i = 0; i < TASK_COUNT; i++)
+        handles[i] = tasks[i].handle;
+    handles[TASK_COUNT] = asyncTcpTask;
+    handles[TASK_COUNT + 1] = xTaskGetCurrentTaskHandle(); // Chamado pelo loop()
+
+    memset(&reading, 0, sizeof(reading));
+    reading.uptimeSec = stationSeconds();
+    reading.freeHeap = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    reading.largestBlock = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+    reading.minFreeHeap = heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+    for (size_t i = 0; i < HEALTH_TASK_COUNT; i++)
+    {
+        // No ESP32 a marca d'água vem em bytes; sem handle (NULL seria a própria tarefa): desconhecida
+        UBaseType_t hwm = handles[i] ? uxTaskGetStackHighWaterMark(handles[i]) : 0xFFFF;
+        reading.stackFree[i] = hwm > 0xFFFF ? 0xFFFF : hwm;
     }
-    display.display();
+}
+
+/**
+ * @brief Nova leitura de saúde; avisa na serial quando um limite é cruzado
+ */
+void sampleHealth()
+{
+    lastHealthMs = millis();
+    HealthReading reading;
+    readHealth(reading);
+    if (healthMonitor.record(reading))
+    {
+        Serial.print("AVISO saude:");
+        for (uint8_t bit = HEALTH_WARN_FREE_HEAP; bit <= HEALTH_WARN_STACK; bit <<= 1)
+            if (healthMonitor.warnings() & bit)
+                Serial.printf(" %s", HealthMonitor::warningName(bit));
+        Serial.printf(" (livre %lu, maior bloco %lu)\n", (unsigned long)reading.freeHeap,
+                      (unsigned long)reading.largestBlock);
+    }
+    healthBus.write(healthMonitor.snapshot());
 }
 
 // ==========================================
 // SETUP & LOOP
 // ==========================================
 
+#ifdef STATION_LOW_POWER
+/**
+ * @brief Fecha o ciclo e entra em deep sleep (não retorna)
+ * @param uploaded true ao sair de uma janela de envio (esvazia o lote)
+ */
+void enterSleep(bool uploaded)
+{
+    uint32_t sleepMs = dutyCycle.sleepMs(millis(), uploaded);
+    const SampleBatch &batch = dutyCycle.batch();
+    Serial.printf("Dormindo %lu ms (lote %u, despertares %lu, envios %lu)\n", (unsigned long)sleepMs,
+                  (unsigned)batch.count, (unsigned long)batch.wakeCount, (unsigned long)batch.uploadCount);
+    Serial.flush();
+
+    if (uploaded)
+    {
+        // Só a janela de envio move os servos; o despertar rápido nem os liga.
+        // Guarda o último ângulo escrito (a trajetória pode não ter chegado ao alvo).
+        rtcServoX = solarTracker.actuatorX().position();
+        rtcServoY = solarTracker.actuatorY().position();
+        WiFi.mode(WIFI_OFF);
+        display.ssd1306_command(SSD1306_DISPLAYOFF); // Painel mantém o estado no sono
+    }
+    esp_sleep_enable_timer_wakeup((uint64_t)sleepMs * 1000ULL);
+    esp_deep_sleep_start();
+}
+
+/**
+ * @brief Caminho rápido de um despertar pelo timer
+ *
+ * Lê os sensores uma vez, guarda no lote da memória RTC e volta a dormir.
+ * Só retorna (para o setup completo) na partida a frio ou quando o lote
+ * pede uma janela de envio.
+ */
+void lowPowerWake()
+{
+    bool warm = dutyCycle.restore();
+    if (!warm || esp_sleep_get_wakeup_cause() != ESP_SLEEP_WAKEUP_TIMER)
+        return; // Partida a frio: sobe a estação completa numa janela de envio
+
+    StationSample sample = {};
+    Wire.begin();
+    // begin() aplica o modo forçado, que já dispara uma conversão
+    bmeFound = bme.begin(0x76, BME_CONFIG);
+    BME280Reading bmeReading;
+    if (bmeFound)
+    {
+        delay(BME_CONVERSION_MS);
+        if (bme.read(bmeReading, false))
+        {
+            sample.temp = bmeReading.temp;
+            sample.hum = bmeReading.hum;
+            sample.pres = bmeReading.pres;
+            sample.bmeOk = true;
+        }
+    }
+
+    adcCal.loadFromEfuse();
+    const AnalogSnapshot &snap = analogInputs.scan(millis());
+    sample.uv = calInterpolate(GYML8511_UV_CURVE, adcCal.rawToMv(snap.raw[CH_UV])) / 1000.0f;
+    sample.lumens = luxFromSnapshot(snap);
+    sample.alarm = alarmActive(sample);
+
+    BatchRecord record;
+    batchRecordFromSample(sample, dutyCycle.stationSec(millis()), record);
+    if (dutyCycle.onSample(record) == DUTY_SLEEP)
+        enterSleep(false);
+    // Lote cheio ou alarme novo: segue o setup completo e abre a janela de envio
+}
+
+/**
+ * @brief Carrega o lote no histórico e no log em flash (período dormido)
+ */
+void replayBatch()
+{
+    const SampleBatch &batch = dutyCycle.batch();
+    for (uint16_t i = 0; i < batch.count; i++)
+    {
+        StationSample sample;
+        batchRecordToSample(batch.records[i], sample);
+        addToHistory(batch.records[i].stationSec, sample);
+        if (logReady)
+            logSample(sample, batch.records[i].stationSec, millis());
+    }
+}
+#endif
+
+/**
+ * @brief Monta o LittleFS e recupera a posição de escrita do log
+ */
+void setupLog()
+{
+    logMutex = xSemaphoreCreateMutex();
+    // true: formata na primeira vez (partição vazia ou corrompida)
+    if (!LittleFS.begin(true))
+    {
+        Serial.println("Erro LittleFS - log desativado.");
+        return;
+    }
+    uint32_t start = micros();
+    logReady = sampleLog.begin();
+    Serial.printf("Log: seq %lu a %lu em %u segmentos, recuperado em %lu us (%lu leituras, %lu descartados)\n",
+                  (unsigned long)sampleLog.firstSeq(), (unsigned long)sampleLog.nextSeq(),
+                  (unsigned)sampleLog.segments(), (unsigned long)(micros() - start),
+                  (unsigned long)sampleLog.recoveryReads(), (unsigned long)sampleLog.recoveredTorn());
+}
+
+/**
+ * @brief Carrega a tabela de regras e cria a fila de edições
+ *
+ * No modo de baixo consumo vem da memória RTC (a tabela editada antes do
+ * último sono); na partida a frio, ou sem cópia válida, vale a padrão.
+ */
+void setupAlarms()
+{
+#ifdef STATION_LOW_POWER
+    if (!alarmEngine.loadRules(rtcRules))
+#endif
+        for (const AlarmRule &rule : DEFAULT_ALARM_RULES)
+            alarmEngine.addRule(rule);
+    watchAlarmThresholds();
+    alarmBus.write(alarmEngine.snapshot());
+    alarmCommands = xQueueCreate(ALARM_QUEUE_LEN, sizeof(AlarmCommand));
+}
+
 void setup()
 {
     Serial.begin(115200);
+    setupAlarms();
+
+#ifdef STATION_LOW_POWER
+    lowPowerWake();
+#endif
 
     // Inicializa Pinos
     pinMode(PIN_LED_RED, OUTPUT);
@@ -405,7 +1404,7 @@ void setup()
     }
 
     // Inicializa BME280 com proteção
-    if (bme.begin(0x76))
+    if (bme.begin(0x76, BME_CONFIG))
     {
         Serial.println("BME280 Encontrado!");
         bmeFound = true;
@@ -416,40 +1415,68 @@ void setup()
         bmeFound = false;
     }
 
+    // Calibração de fábrica do ADC (gravada no eFuse) quando o chip tiver
+    adcCal.loadFromEfuse();
+    Serial.printf("ADC: calibração %s\n", adcCal.source());
+
     uvSensor.begin();
-    solarTracker.begin();
+    uvSensor.setCalibration(adcCal);
+#ifdef STATION_LOW_POWER
+    // Volta do deep sleep sem passar por 90 graus
+    if (rtcServoX >= 0)
+        solarTracker.begin(rtcServoX, rtcServoY);
+    else
+#endif
+        solarTracker.begin();
     solarTracker.setTolerance(50);
 
+    // Aponta pela efeméride assim que o relógio for acertado; até lá (e sem hora)
+    // segue pelos LDRs com P + zona morta, ~3x mais rápido que o passo fixo
+    solarTracker.setMode(TRACKER_MODE_EPHEMERIS);
+    solarTracker.setGains(TRACKER_AXIS_X, TRACKER_P_GAINS);
+    solarTracker.setGains(TRACKER_AXIS_Y, TRACKER_P_GAINS);
+
     // --- CONFIGURAÇÃO DO WEBSERVER ---
+    setupLog();
     setupWiFi();
+    setupMetrics();
     setupWebServer();
 
     delay(1000);
+
+#ifdef STATION_LOW_POWER
+    replayBatch();
+#endif
+
+    // Primeira varredura antes de liberar os consumidores
+    analogBus.write(analogInputs.scan(millis()));
+    startTasks();
+    sampleHealth();
 }
 
-// O Loop do Arduino roda no CORE 1 por padrão no ESP32
+// Todo o trabalho roda nas tarefas FreeRTOS; o loop apenas reporta estatísticas
 void loop()
 {
-    unsigned long currentMillis = millis();
-
-    // Tarefa 1: Tracker (Prioridade de tempo real - 50ms)
-    if (currentMillis - lastTrackerTime >= 50)
-    {
-        lastTrackerTime = currentMillis;
-        taskTracker();
-    }
-
-    // Tarefa 2: Sensores, Lógica de Alarme e Atuadores (1000ms)
-    if (currentMillis - lastSensorTime >= 1000)
-    {
-        lastSensorTime = currentMillis;
-        taskSensorsAndAlarm();
-    }
+    if (millis() - lastHealthMs >= HEALTH_PERIOD_MS)
+        sampleHealth();
 
-    // Tarefa 3: Atualiza OLED (200ms)
-    if (currentMillis - lastDisplayTime >= 200)
+#ifdef STATION_LOW_POWER
+    // Janela de envio: volta a dormir quando ninguém mais está usando a página
+    if (dutyCycle.uploadFinished(millis(), lastWebAccess))
     {
-        lastDisplayTime = currentMillis;
-        taskDisplay();
+        // O lote do log está em RAM e não sobrevive ao deep sleep
+        if (logReady)
+        {
+            xSemaphoreTake(logMutex, portMAX_DELAY);
+            sampleLog.flush();
+            xSemaphoreGive(logMutex);
+        }
+        printTaskStats();
+        enterSleep(true);
     }
-}
\ No newline at end of file
+    vTaskDelay(pdMS_TO_TICKS(1000));
+#else
+    printTaskStats();
+    vTaskDelay(pdMS_TO_TICKS(10000));
+#endif
+}
@@ -0,0 +1,51 @@
+#include "NativeBench.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+static std::atomic<uint64_t> allocCount(0);
+
+uint64_t benchNowNs()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+uint64_t benchCycles()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+uint64_t benchAllocCount()
+{
+    return allocCount.load(std::memory_order_relaxed);
+}
+
+// Contagem de alocações: substitui o operator new global do executável nativo
+void *operator new(size_t size)
+{
+    allocCount.fetch_add(1, std::memory_order_relaxed);
+    void *p = std::malloc(size ? size : 1);
+    if (p == nullptr)
+        throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    std::free(p);
+}
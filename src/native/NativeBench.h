@@ -0,0 +1,70 @@
+/**
+ * @file NativeBench.h
+ * @brief Utilitários do executável nativo (host): cronometragem e contagem de alocações
+ */
+
+#ifndef NATIVEBENCH_H
+#define NATIVEBENCH_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+/**
+ * @brief Relógio de alta resolução do host em nanossegundos
+ */
+uint64_t benchNowNs();
+
+/**
+ * @brief Contador de ciclos da CPU do host (0 onde não houver um acessível)
+ */
+uint64_t benchCycles();
+
+/**
+ * @brief Alocações no heap (operator new/malloc via new) desde o início
+ */
+uint64_t benchAllocCount();
+
+/**
+ * @brief Resultado de uma medição
+ */
+struct BenchResult
+{
+    double nsPerOp;
+    double allocsPerOp;
+};
+
+/**
+ * @brief Executa fn() 'iterations' vezes e imprime ns/op e alocações/op
+ */
+template <typename Fn>
+BenchResult benchRun(const char *name, uint32_t iterations, Fn fn)
+{
+    // Aquecimento (cache, branch predictor)
+    for (uint32_t i = 0; i < iterations / 10 + 1; i++)
+        fn();
+
+    uint64_t allocs = benchAllocCount();
+    uint64_t start = benchNowNs();
+    for (uint32_t i = 0; i < iterations; i++)
+        fn();
+    uint64_t elapsed = benchNowNs() - start;
+    allocs = benchAllocCount() - allocs;
+
+    BenchResult r;
+    r.nsPerOp = (double)elapsed / iterations;
+    r.allocsPerOp = (double)allocs / iterations;
+    printf("  %-40s %10.1f ns/op  %6.2f allocs/op\n", name, r.nsPerOp, r.allocsPerOp);
+    return r;
+}
+
+/**
+ * @brief Impede o compilador de descartar um resultado não usado
+ */
+template <typename T>
+inline void benchKeep(const T &value)
+{
+    __asm__ __volatile__("" : : "g"(&value) : "memory");
+}
+
+#endif
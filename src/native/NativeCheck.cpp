@@ -0,0 +1,44 @@
+#include "NativeCheck.h"
+
+#include <math.h>
+#include <stdio.h>
+
+static uint32_t checkCount = 0;
+static uint32_t checkFailures = 0;
+
+bool nativeCheck(bool ok, const char *expr, const char *file, int line)
+{
+    checkCount++;
+    if (!ok)
+    {
+        checkFailures++;
+        printf("  FALHOU %s:%d: %s\n", file, line, expr);
+    }
+    return ok;
+}
+
+bool nativeCheckEq(long long actual, long long expected, const char *expr, const char *file, int line)
+{
+    bool ok = nativeCheck(actual == expected, expr, file, line);
+    if (!ok)
+        printf("         obtido %lld, esperado %lld\n", actual, expected);
+    return ok;
+}
+
+bool nativeCheckNear(double actual, double expected, double tolerance, const char *expr, const char *file, int line)
+{
+    bool ok = nativeCheck(fabs(actual - expected) <= tolerance, expr, file, line);
+    if (!ok)
+        printf("         obtido %g, esperado %g +/- %g\n", actual, expected, tolerance);
+    return ok;
+}
+
+uint32_t nativeCheckCount()
+{
+    return checkCount;
+}
+
+uint32_t nativeCheckFailures()
+{
+    return checkFailures;
+}
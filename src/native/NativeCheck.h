@@ -0,0 +1,35 @@
+/**
+ * @file NativeCheck.h
+ * @brief Verificações do executável nativo: cada falha é impressa e conta
+ *
+ * Os cenários continuam imprimindo os números medidos; as afirmações que
+ * precisam continuar valendo viram CHECKs. Qualquer falha faz o executável
+ * terminar com código diferente de zero.
+ */
+
+#ifndef NATIVECHECK_H
+#define NATIVECHECK_H
+
+#include <stdint.h>
+
+#define CHECK(cond) nativeCheck((cond), #cond, __FILE__, __LINE__)
+#define CHECK_EQ(actual, expected) \
+    nativeCheckEq((long long)(actual), (long long)(expected), #actual, __FILE__, __LINE__)
+#define CHECK_NEAR(actual, expected, tolerance) \
+    nativeCheckNear((double)(actual), (double)(expected), (double)(tolerance), #actual, __FILE__, __LINE__)
+
+/**
+ * @brief Registra uma verificação; imprime o local se falhou
+ * @return O próprio resultado (permite parar o cenário cedo)
+ */
+bool nativeCheck(bool ok, const char *expr, const char *file, int line);
+
+bool nativeCheckEq(long long actual, long long expected, const char *expr, const char *file, int line);
+
+bool nativeCheckNear(double actual, double expected, double tolerance, const char *expr, const char *file, int line);
+
+// Totais desde o início do executável
+uint32_t nativeCheckCount();
+uint32_t nativeCheckFailures();
+
+#endif
@@ -0,0 +1,57 @@
+/**
+ * @file NativeScenarios.h
+ * @brief Cenários de simulação e micro-benchmarks do executável nativo
+ */
+
+#ifndef NATIVESCENARIOS_H
+#define NATIVESCENARIOS_H
+
+// Estação completa (aquisição, tracker, UV, histórico, JSON) em tempo simulado
+void scenarioStation();
+
+// Leis de controle do SunTracker (passo fixo, P, PID) com luz simulada
+void scenarioTracker();
+
+// Efeméride solar: precisão vs referência NOAA, custo e um dia de seguimento
+void scenarioEphemeris();
+
+// Calibração do ADC em ponto fixo: erro contra os modelos e custo
+void scenarioCalibration();
+
+// Histogramas de latência e saída do /metrics
+void scenarioMetrics();
+
+// Amostragem adaptativa do BME280 contra traços sintéticos de 12 h
+void scenarioSampling();
+
+// Modo de baixo consumo: ciclos de sono em 24 h e energia por dia
+void scenarioLowPower();
+
+// Regras de alarme: histerese, duração mínima, rearme, taxa e custo
+void scenarioAlarms();
+
+// Log de amostras em flash: recuperação, queda de energia e desempenho
+void scenarioSampleLog();
+
+// Exportação CSV/NDJSON do log em pedaços
+void scenarioExport();
+
+// Admissão de requisições do servidor web com clientes agressivos
+void scenarioAdmission();
+
+// Saúde do heap e das pilhas: aviso antecipado e custo do monitor
+void scenarioHealth();
+
+// Verificações: média do ADC (AdcSampler) com a fonte simulada
+void scenarioCheckAdc();
+
+// Verificação: SeqLock com escritor e leitores concorrentes (threads)
+void scenarioCheckSeqLock();
+
+// Verificações: WebSocket, histórico, ida e volta (JSON, binário) e valores de referência
+void scenarioCheckCore();
+
+// Micro-benchmarks das rotinas de caminho quente
+void scenarioBenchCore();
+
+#endif
@@ -0,0 +1,87 @@
+/**
+ * @file SimLight.h
+ * @brief Fonte de luz simulada para os 4 LDRs do tracker
+ *
+ * Modelo simples: cada LDR recebe uma base proporcional à irradiância e um
+ * acréscimo proporcional ao erro de apontamento no seu lado, com ruído.
+ * Convenção igual à do SunTracker: sol em X menor -> lado esquerdo mais
+ * claro; sol em Y menor -> lado de cima mais claro.
+ */
+
+#ifndef SIMLIGHT_H
+#define SIMLIGHT_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include "HalFake.h"
+
+struct SimLight
+{
+    float sunX;       // Ângulo do servo X que aponta para o sol
+    float sunY;       // Ângulo do servo Y que aponta para o sol
+    float base;       // Leitura de cada LDR com o painel alinhado
+    float gain;       // Contagens ADC por grau de erro
+    int noise;        // Amplitude do ruído (+/- contagens)
+    uint32_t seed;    // Semente do gerador (reprodutível)
+
+    SimLight() : sunX(90), sunY(90), base(2000), gain(25), noise(8), seed(12345) {}
+
+    int jitter()
+    {
+        if (noise == 0)
+            return 0;
+        seed = seed * 1103515245u + 12345u;
+        return (int)((seed >> 16) % (2 * noise + 1)) - noise;
+    }
+
+    static int clampAdc(float v)
+    {
+        if (v < 0)
+            return 0;
+        if (v > 4095)
+            return 4095;
+        return (int)v;
+    }
+
+    /**
+     * @brief Atualiza as leituras dos LDRs no ADC simulado
+     */
+    void apply(FakeAdcSource &adc, float posX, float posY, uint8_t pinTL, uint8_t pinTR, uint8_t pinBL, uint8_t pinBR)
+    {
+        float errX = sunX - posX; // > 0: sol à direita
+        float errY = sunY - posY; // > 0: sol embaixo
+        float left = -gain * errX / 2, right = gain * errX / 2;
+        float top = -gain * errY / 2, bot = gain * errY / 2;
+
+        adc.setValue(pinTL, clampAdc(base + left + top + jitter()));
+        adc.setValue(pinTR, clampAdc(base + right + top + jitter()));
+        adc.setValue(pinBL, clampAdc(base + left + bot + jitter()));
+        adc.setValue(pinBR, clampAdc(base + right + bot + jitter()));
+    }
+};
+
+/**
+ * @brief Acompanha o deslocamento acumulado de um servo simulado
+ */
+struct TravelMeter
+{
+    int last;
+    uint32_t total; // Graus percorridos
+    uint32_t moves; // Mudanças de ângulo
+
+    void start(int angle)
+    {
+        last = angle;
+        total = 0;
+        moves = 0;
+    }
+    void sample(int angle)
+    {
+        if (angle != last)
+            moves++;
+        total += abs(angle - last);
+        last = angle;
+    }
+};
+
+#endif
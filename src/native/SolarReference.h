@@ -0,0 +1,50 @@
+/**
+ * @file SolarReference.h
+ * @brief Posição do sol de referência (planilha NOAA / Meeus), em double, só no host
+ *
+ * Usada para medir o erro da efeméride barata do firmware (SolarEphemeris).
+ * Inclui nutação, equação do tempo e excentricidade; precisão ~0.01 grau.
+ */
+
+#ifndef SOLARREFERENCE_H
+#define SOLARREFERENCE_H
+
+#include <math.h>
+#include <stdint.h>
+
+inline void solarPositionReference(int64_t unixTime, double latitude, double longitude, double &azimuth, double &elevation)
+{
+    const double D2R = M_PI / 180.0, R2D = 180.0 / M_PI;
+
+    double jd = unixTime / 86400.0 + 2440587.5;
+    double t = (jd - 2451545.0) / 36525.0;
+
+    double l0 = fmod(280.46646 + t * (36000.76983 + t * 0.0003032), 360.0);
+    double m = 357.52911 + t * (35999.05029 - 0.0001537 * t);
+    double e = 0.016708634 - t * (0.000042037 + 0.0000001267 * t);
+    double c = sin(m * D2R) * (1.914602 - t * (0.004817 + 0.000014 * t)) +
+               sin(2 * m * D2R) * (0.019993 - 0.000101 * t) +
+               sin(3 * m * D2R) * 0.000289;
+    double trueLong = l0 + c;
+    double omega = 125.04 - 1934.136 * t;
+    double appLong = trueLong - 0.00569 - 0.00478 * sin(omega * D2R);
+    double meanObliq = 23.0 + (26.0 + (21.448 - t * (46.815 + t * (0.00059 - t * 0.001813))) / 60.0) / 60.0;
+    double obliq = meanObliq + 0.00256 * cos(omega * D2R);
+    double dec = asin(sin(obliq * D2R) * sin(appLong * D2R));
+
+    double y = tan(obliq * D2R / 2) * tan(obliq * D2R / 2);
+    double eqTime = 4 * R2D * (y * sin(2 * l0 * D2R) - 2 * e * sin(m * D2R) + 4 * e * y * sin(m * D2R) * cos(2 * l0 * D2R) - 0.5 * y * y * sin(4 * l0 * D2R) - 1.25 * e * e * sin(2 * m * D2R));
+
+    double minutesUtc = fmod((double)unixTime, 86400.0) / 60.0;
+    if (minutesUtc < 0)
+        minutesUtc += 1440.0;
+    double trueSolarTime = fmod(minutesUtc + eqTime + 4 * longitude, 1440.0);
+    double hourAngle = trueSolarTime / 4 - 180.0;
+
+    double lat = latitude * D2R, ha = hourAngle * D2R;
+    double sinEl = sin(lat) * sin(dec) + cos(lat) * cos(dec) * cos(ha);
+    elevation = asin(sinEl) * R2D;
+    azimuth = fmod(atan2(-sin(ha), tan(dec) * cos(lat) - sin(lat) * cos(ha)) * R2D + 360.0, 360.0);
+}
+
+#endif
@@ -0,0 +1,140 @@
+/**
+ * @file bench_core.cpp
+ * @brief Micro-benchmarks das rotinas de caminho quente da estação
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include "AdcSampler.h"
+#include "HalFake.h"
+#include "BME280Compensation.h"
+#include "HistoryStore.h"
+#include "OledDiff.h"
+#include "SeqLock.h"
+#include "StationJson.h"
+#include "StationBinary.h"
+#include "NativeBench.h"
+#include "NativeScenarios.h"
+
+static const uint32_t N = 200000;
+
+/**
+ * @brief Reprodução do /data original: concatenação de String temporárias
+ * (String(float) do Arduino usa 2 casas; std::string + snprintf equivalente)
+ */
+static std::string floatString(float v)
+{
+    char buf[24];
+    snprintf(buf, sizeof(buf), "%.2f", v);
+    return std::string(buf);
+}
+
+static std::string legacyJson(const StationSample &s)
+{
+    std::string json = "{";
+    json += "\"t\":" + floatString(s.temp) + ",";
+    json += "\"h\":" + floatString(s.hum) + ",";
+    json += "\"p\":" + floatString(s.pres) + ",";
+    json += "\"u\":" + floatString(s.uv) + ",";
+    json += "\"l\":" + std::to_string(s.lumens) + ",";
+    json += "\"alarm\":" + std::string(s.alarm ? "true" : "false") + ",";
+    json += "\"ack\":" + std::string(s.ack ? "true" : "false");
+    json += "}";
+    return json;
+}
+
+static void benchJson()
+{
+    StationSample s = {};
+    s.seq = 123456;
+    s.temp = 23.456f;
+    s.hum = 61.23f;
+    s.pres = 1013.25f;
+    s.uv = 3.21f;
+    s.lumens = 2048;
+
+    printf(" JSON do /data\n");
+    char buf[STATION_JSON_MAX];
+    size_t fastLen = stationSampleToJson(s, buf, sizeof(buf));
+    size_t legacyLen = legacyJson(s).size();
+
+    BenchResult fast = benchRun("stationSampleToJson (buffer fixo)", N, [&]()
+                                { benchKeep(stationSampleToJson(s, buf, sizeof(buf))); });
+    BenchResult legacy = benchRun("concatenação de String (original)", N, [&]()
+                                  { benchKeep(legacyJson(s)); });
+
+    printf("  -> %.2f vs %.2f bytes/ns; %.0f vs %.0f alocações por resposta\n",
+           fastLen / fast.nsPerOp, legacyLen / legacy.nsPerOp, fast.allocsPerOp, legacy.allocsPerOp);
+
+    // Mesmo registro no quadro binário do /data.bin e do /ws
+    uint8_t bin[STATION_BIN_SIZE];
+    size_t binLen = stationSampleToBinary(s, bin, sizeof(bin));
+    BenchResult binary = benchRun("stationSampleToBinary", N, [&]()
+                                  { benchKeep(stationSampleToBinary(s, bin, sizeof(bin))); });
+    StationSample back;
+    stationSampleFromBinary(bin, binLen, back);
+    printf("  -> JSON %lu bytes, binário %lu bytes (%.0f%%); codificação %.1fx mais rápida\n", (unsigned long)fastLen,
+           (unsigned long)binLen, 100.0 * binLen / fastLen, fast.nsPerOp / binary.nsPerOp);
+    printf("  -> ida e volta: T %.2f H %.2f P %.2f UV %.3f l %ld seq %lu\n", back.temp, back.hum, back.pres, back.uv,
+           (long)back.lumens, (unsigned long)back.seq);
+}
+
+static void benchBme()
+{
+    printf(" BME280\n");
+    BME280Calib c = {};
+    c.T1 = 27504, c.T2 = 26435, c.T3 = -1000;
+    c.P1 = 36477, c.P2 = -10685, c.P3 = 3024, c.P4 = 2855, c.P5 = 140, c.P6 = -7, c.P7 = 15500, c.P8 = -14600, c.P9 = 6000;
+    c.H1 = 75, c.H2 = 362, c.H3 = 0, c.H4 = 313, c.H5 = 50, c.H6 = 30;
+    BME280Raw raw = {519888, 415148, 30000};
+    BME280Reading out;
+    uint32_t i = 0;
+    benchRun("bme280Compensate (T+P+H)", N, [&]()
+             { raw.adcT = 519888 + (i++ & 0xFF); bme280Compensate(c, raw, out); benchKeep(out); });
+}
+
+static void benchOled()
+{
+    printf(" OLED\n");
+    static uint8_t a[1024], b[1024];
+    memset(a, 0x55, sizeof(a));
+    memcpy(b, a, sizeof(b));
+    DirtySpan spans[8];
+    benchRun("computeDirtySpans (quadro idêntico)", N, [&]()
+             { benchKeep(computeDirtySpans(a, b, 128, 8, spans)); });
+    b[3 * 128 + 40] ^= 0xFF;
+    benchRun("computeDirtySpans (1 página alterada)", N, [&]()
+             { benchKeep(computeDirtySpans(a, b, 128, 8, spans)); });
+}
+
+static void benchHistoryAndBus()
+{
+    printf(" Histórico / troca entre tarefas / média UV\n");
+    static HistoryStore history;
+    float values[HIST_CHANNELS] = {25.0f, 60.0f, 1013.0f, 2.0f, 2000.0f};
+    uint32_t t = 0;
+    benchRun("HistoryStore::add (3 resoluções)", N, [&]()
+             { history.add(t++, values); });
+
+    SeqLock<StationSample> bus;
+    StationSample s = {};
+    benchRun("SeqLock<StationSample>::write", N, [&]()
+             { s.seq++; bus.write(s); });
+    benchRun("SeqLock<StationSample>::read", N, [&]()
+             { benchKeep(bus.read()); });
+
+    FakeAdcSource adc;
+    AdcSampler sampler(adc, 32);
+    int v = 0;
+    benchRun("AdcSampler push + average", N, [&]()
+             { sampler.push(v++ & 4095); benchKeep(sampler.average()); });
+}
+
+void scenarioBenchCore()
+{
+    benchJson();
+    benchBme();
+    benchOled();
+    benchHistoryAndBus();
+}
@@ -0,0 +1,92 @@
+/**
+ * @file check_adc.cpp
+ * @brief Verificações da média do ADC (AdcSampler) com a fonte simulada
+ *
+ * Aquecimento da janela, janela deslizante, soma corrente contra a média
+ * direta, volta do micros() e limites do tamanho da janela.
+ */
+
+#include <stdio.h>
+#include "AdcSampler.h"
+#include "HalFake.h"
+#include "NativeCheck.h"
+#include "NativeScenarios.h"
+
+static void checkAdcSampler()
+{
+    printf(" Média do ADC (AdcSampler com FakeAdcSource)\n");
+    const uint8_t PIN = 32;
+    static const int SEQ[] = {100, 200, 300, 400, 500, 600};
+    FakeAdcSource adc;
+    adc.setSequence(PIN, SEQ, 6);
+
+    // Janela de 4 enchendo: média só das amostras já coletadas
+    AdcSampler sampler(adc, PIN, 4, 500);
+    CHECK_EQ(sampler.average(), 0);
+    sampler.start(0);
+    CHECK(sampler.poll(0));
+    CHECK(!sampler.poll(499)); // Intervalo ainda não venceu: não lê
+    CHECK(sampler.poll(500));
+    CHECK_EQ(sampler.average(), 150);
+    CHECK(!sampler.ready());
+    CHECK(sampler.poll(1000) && sampler.poll(1500));
+    CHECK(sampler.ready());
+    CHECK_EQ(sampler.average(), 250);
+
+    // Janela cheia: a mais antiga sai da soma
+    sampler.poll(2000);
+    CHECK_EQ(sampler.average(), 350);
+    sampler.poll(2500);
+    CHECK_EQ(sampler.average(), 450);
+    CHECK_EQ(adc.readCount(), 6);
+
+    // stop() mantém a última média; start() recomeça a janela
+    sampler.stop();
+    CHECK(!sampler.poll(10000));
+    CHECK_EQ(sampler.average(), 450);
+    sampler.start(10000);
+    CHECK(!sampler.ready());
+    CHECK_EQ(sampler.average(), 0);
+
+    // Soma corrente contra a média calculada do zero, muitas voltas no anel
+    AdcSampler full(adc, PIN);
+    int values[4096];
+    uint32_t seed = 3;
+    uint32_t mismatches = 0;
+    for (int i = 0; i < 4096; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        values[i] = (seed >> 16) % 4096;
+        full.push(values[i]);
+        int n = i + 1 < AdcSampler::MAX_SAMPLES ? i + 1 : AdcSampler::MAX_SAMPLES;
+        long sum = 0;
+        for (int k = i + 1 - n; k <= i; k++)
+            sum += values[k];
+        if (full.average() != sum / n)
+            mismatches++;
+    }
+    CHECK_EQ(mismatches, 0);
+
+    // micros() dá a volta em ~71 min: o intervalo continua contando certo
+    AdcSampler wrap(adc, PIN, 4, 500);
+    wrap.start(0xFFFFFF00u);
+    CHECK(wrap.poll(0xFFFFFF00u));
+    CHECK(!wrap.poll(0xFFFFFF00u + 400));
+    CHECK(wrap.poll(0x000000F4u)); // 500 us depois, já do outro lado
+    CHECK(!wrap.poll(0x000000F4u + 100));
+
+    // Tamanho da janela limitado a [1, MAX_SAMPLES]
+    AdcSampler one(adc, PIN, 0);
+    one.push(7);
+    CHECK(one.ready());
+    AdcSampler big(adc, PIN, 200);
+    for (int i = 0; i < AdcSampler::MAX_SAMPLES; i++)
+        big.push(i);
+    CHECK(big.ready());
+    printf("  aquecimento, janela deslizante, %d amostras contra a média direta, volta do micros()\n", 4096);
+}
+
+void scenarioCheckAdc()
+{
+    checkAdcSampler();
+}
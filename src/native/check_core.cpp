@@ -0,0 +1,286 @@
+/**
+ * @file check_core.cpp
+ * @brief Verificações das rotinas de caminho quente: assinantes do WebSocket, histórico, BME280 e formatos de ida e volta
+ *
+ * Complementa o bench_core.cpp: lá mede o custo, aqui confere o resultado.
+ * A média do ADC e o SeqLock têm cenários próprios (check_adc.cpp e
+ * check_seqlock.cpp).
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <atomic>
+#include <thread>
+#include "BME280Compensation.h"
+#include "HistoryJsonStream.h"
+#include "StationJson.h"
+#include "StationBinary.h"
+#include "WsSubscribers.h"
+#include "NativeBench.h"
+#include "NativeCheck.h"
+#include "NativeScenarios.h"
+
+static StationSample makeSample()
+{
+    StationSample s = {};
+    s.seq = 123456;
+    s.temp = -5.256f;
+    s.hum = 61.23f;
+    s.pres = 1013.25f;
+    s.uv = 3.21f;
+    s.lumens = 2048;
+    s.alarm = 1;
+    s.bmeOk = 1;
+    return s;
+}
+
+static void checkJson()
+{
+    printf(" JSON do /data\n");
+    StationSample s = makeSample();
+    char buf[STATION_JSON_MAX];
+    size_t len = stationSampleToJson(s, buf, sizeof(buf));
+    const char *expected = "{\"seq\":123456,\"t\":-5.26,\"h\":61.23,\"p\":1013.25,\"u\":3.21,\"l\":2048,"
+                           "\"alarm\":true,\"ack\":false}";
+    CHECK(strcmp(buf, expected) == 0);
+    CHECK_EQ(len, strlen(expected));
+    printf("  %s\n", buf);
+
+    // Leitura ausente vira null; buffer curto não escreve JSON pela metade
+    s.temp = NAN;
+    stationSampleToJson(s, buf, sizeof(buf));
+    CHECK(strstr(buf, "\"t\":null,") != nullptr);
+    CHECK_EQ(stationSampleToJson(s, buf, 20), 0);
+}
+
+static void checkBinary()
+{
+    printf(" Quadro binário do /data.bin e /ws\n");
+    StationSample s = makeSample();
+    uint8_t bin[STATION_BIN_SIZE + 4];
+    CHECK_EQ(stationSampleToBinary(s, bin, STATION_BIN_SIZE - 1), 0);
+    size_t len = stationSampleToBinary(s, bin, sizeof(bin));
+    CHECK_EQ(len, STATION_BIN_SIZE);
+
+    StationSample back;
+    if (CHECK(stationSampleFromBinary(bin, len, back)))
+    {
+        CHECK_EQ(back.seq, s.seq);
+        CHECK_NEAR(back.temp, -5.26, 1e-4); // Arredonda para 0.01 C, longe de zero
+        CHECK_NEAR(back.hum, s.hum, 0.005);
+        CHECK_NEAR(back.pres, s.pres, 0.005);
+        CHECK_NEAR(back.uv, s.uv, 0.0005);
+        CHECK_EQ(back.lumens, s.lumens);
+        CHECK(back.alarm == 1 && back.ack == 0 && back.bmeOk == 1);
+        printf("  ida e volta: T %.2f H %.2f P %.2f UV %.3f l %ld seq %lu\n", back.temp, back.hum, back.pres,
+               back.uv, (long)back.lumens, (unsigned long)back.seq);
+    }
+
+    // Ausentes voltam como NaN; valores fora da faixa saturam
+    s.temp = NAN;
+    s.hum = NAN;
+    s.pres = NAN;
+    s.uv = 1000.0f;
+    stationSampleToBinary(s, bin, sizeof(bin));
+    stationSampleFromBinary(bin, STATION_BIN_SIZE, back);
+    CHECK(isnan(back.temp) && isnan(back.hum) && isnan(back.pres));
+    CHECK_NEAR(back.uv, 65.534, 1e-3);
+
+    // Quadro truncado ou de versão desconhecida é recusado; campos novos no fim são pulados
+    CHECK(!stationSampleFromBinary(bin, STATION_BIN_SIZE - 1, back));
+    bin[0] = STATION_BIN_VERSION + 1;
+    CHECK(!stationSampleFromBinary(bin, STATION_BIN_SIZE, back));
+    bin[0] = STATION_BIN_VERSION;
+    bin[2] = STATION_BIN_SIZE + 4;
+    CHECK(stationSampleFromBinary(bin, STATION_BIN_SIZE + 4, back));
+    CHECK(!stationSampleFromBinary(bin, STATION_BIN_SIZE, back));
+}
+
+// Cliente do WebSocket simulado: "liberado" logo depois de remove(), como
+// o AsyncWebSocket faz ao voltar do evento de desconexão
+struct FakeWsClient
+{
+    std::atomic<uint32_t> state;
+    std::atomic<uint32_t> frames;
+};
+static const uint32_t WS_ALIVE = 0xA11CE;
+static const uint32_t WS_FREED = 0xDEAD;
+
+static void checkWsSubscribers()
+{
+    printf(" WsSubscribers: conexões e desconexões (AsyncTCP) durante o envio (taskNetwork)\n");
+    const uint8_t SLOTS = 4;
+    const uint32_t POOL = 16;
+    const uint64_t RUN_NS = 300000000; // 300 ms
+    static WsSubscribers<FakeWsClient, SLOTS> table;
+    static FakeWsClient pool[POOL];
+    bool connected[POOL] = {false};
+    for (FakeWsClient &c : pool)
+        c.state = WS_FREED;
+    std::atomic<bool> stop(false);
+    std::atomic<uint32_t> pushes(0), frames(0), freedUse(0);
+    uint32_t connects = 0, refused = 0, disconnects = 0;
+
+    std::thread network([&]()
+                        {
+                            while (!stop.load(std::memory_order_relaxed))
+                            {
+                                uint8_t sent = table.forEach([&](FakeWsClient *c)
+                                                             {
+                                                                 // Janela de um envio real (cópia para a fila do cliente)
+                                                                 for (int k = 0; k < 64; k++)
+                                                                     if (c->state.load() != WS_ALIVE)
+                                                                         freedUse++;
+                                                                 c->frames++;
+                                                                 return true; });
+                                frames += sent;
+                                pushes++;
+                            } });
+
+    uint32_t seed = 12345;
+    uint64_t start = benchNowNs();
+    while (benchNowNs() - start < RUN_NS)
+    {
+        seed = seed * 1103515245u + 12345u;
+        uint32_t k = (seed >> 16) % POOL;
+        if (connected[k])
+        {
+            table.remove(&pool[k]);
+            pool[k].state = WS_FREED;
+            connected[k] = false;
+            disconnects++;
+        }
+        else
+        {
+            pool[k].state = WS_ALIVE;
+            connected[k] = table.add(&pool[k]);
+            if (!connected[k])
+            {
+                pool[k].state = WS_FREED;
+                refused++;
+            }
+            connects++;
+        }
+    }
+    stop = true;
+    network.join();
+
+    // A tabela termina com exatamente os clientes conectados
+    uint32_t expected = 0, visited = 0, strangers = 0;
+    for (uint32_t k = 0; k < POOL; k++)
+        expected += connected[k];
+    table.forEach([&](FakeWsClient *c)
+                  {
+                      visited++;
+                      if (!connected[c - pool])
+                          strangers++;
+                      return true; });
+
+    printf("  %lu conexões (%lu recusadas), %lu desconexões, %lu envios, %lu quadros, %lu usos após liberar\n",
+           (unsigned long)connects, (unsigned long)refused, (unsigned long)disconnects,
+           (unsigned long)pushes.load(), (unsigned long)frames.load(), (unsigned long)freedUse.load());
+    CHECK(pushes.load() > 0 && disconnects > 0 && refused > 0);
+    CHECK_EQ(freedUse.load(), 0);
+    CHECK_EQ(visited, expected);
+    CHECK_EQ(strangers, 0);
+    CHECK_EQ(table.count(), expected);
+}
+
+static void checkHistory()
+{
+    printf(" Histórico: 1 add() a cada ~2 us e leitores no slot mais antigo (o próximo a ser reaproveitado)\n");
+    static HistoryStore store;
+    const uint64_t RUN_NS = 300000000; // 300 ms
+    std::atomic<bool> stop(false);
+    std::atomic<uint32_t> reads(0), wrong(0);
+
+    // Valor de cada segundo derivado do próprio segundo: slot trocado não bate
+    std::thread writer([&]()
+                       {
+                           float values[HIST_CHANNELS] = {0, 50.0f, 1013.0f, 1.0f, 100.0f};
+                           for (uint32_t sec = 0; !stop.load(std::memory_order_relaxed); sec++)
+                           {
+                               values[HIST_TEMP] = (sec % 1000) * 0.01f;
+                               store.add(sec, values);
+                               // No firmware é 1 por segundo; sem pausa nenhum leitor terminaria
+                               uint64_t until = benchNowNs() + 2000;
+                               while (benchNowNs() < until)
+                               {
+                               }
+                           } });
+
+    std::thread readers[2];
+    for (std::thread &t : readers)
+        t = std::thread([&]()
+                        {
+                            uint32_t n = 0, bad = 0;
+                            while (!stop.load(std::memory_order_relaxed))
+                            {
+                                uint32_t first, last;
+                                float v;
+                                if (!store.range(HIST_RES_SECOND, first, last))
+                                    continue;
+                                const uint32_t slots[2] = {first, last};
+                                for (uint32_t slot : slots)
+                                {
+                                    if (!store.get(HIST_TEMP, HIST_RES_SECOND, slot, v))
+                                        continue;
+                                    n++;
+                                    if (fabsf(v - (slot % 1000) * 0.01f) > 0.006f)
+                                        bad++;
+                                }
+                            }
+                            reads += n;
+                            wrong += bad; });
+
+    uint64_t start = benchNowNs();
+    while (benchNowNs() - start < RUN_NS)
+        std::this_thread::yield();
+    stop = true;
+    writer.join();
+    for (std::thread &t : readers)
+        t.join();
+    printf("  %lu add(), %lu leituras, %lu de outro instante\n", (unsigned long)store.version(),
+           (unsigned long)reads.load(), (unsigned long)wrong.load());
+    CHECK(reads.load() > 0);
+    CHECK_EQ(wrong.load(), 0);
+
+    // Pedaço menor que o cabeçalho: pede outra chamada em vez de encerrar
+    HistoryJsonStream stream(store, HIST_TEMP, HIST_RES_HOUR, 0, 0);
+    uint8_t buf[512];
+    CHECK_EQ(stream.fill(buf, 16), RESPONSE_TRY_AGAIN);
+    size_t n = stream.fill(buf, sizeof(buf));
+    CHECK(n > 0 && n != RESPONSE_TRY_AGAIN && memcmp(buf, "{\"ch\":\"t\"", 8) == 0);
+}
+
+static void checkBme280()
+{
+    printf(" BME280: exemplo de calibração do datasheet (dig_T*, dig_P*)\n");
+    BME280Calib c = {};
+    c.T1 = 27504, c.T2 = 26435, c.T3 = -1000;
+    c.P1 = 36477, c.P2 = -10685, c.P3 = 3024, c.P4 = 2855, c.P5 = 140, c.P6 = -7, c.P7 = 15500, c.P8 = -14600, c.P9 = 6000;
+    BME280Raw raw = {519888, 415148, 0};
+
+    // Fórmulas inteiras: T em 0.01 C, P em Pa Q24.8
+    int32_t tempCenti;
+    uint32_t presQ24_8, humQ22_10;
+    bme280CompensateInt(c, raw, tempCenti, presQ24_8, humQ22_10);
+    CHECK_EQ(tempCenti, 2508);
+    CHECK_EQ(presQ24_8, 25767233);
+    printf("  T %ld (25.08 C), P %lu (%.2f Pa)\n", (long)tempCenti, (unsigned long)presQ24_8, presQ24_8 / 256.0);
+
+    BME280Reading out;
+    bme280Compensate(c, raw, out);
+    CHECK_NEAR(out.temp, 25.08, 1e-4);
+    CHECK_NEAR(out.pres, 1006.5325, 1e-3);
+}
+
+void scenarioCheckCore()
+{
+    checkWsSubscribers();
+    checkHistory();
+    checkBme280();
+    checkJson();
+    checkBinary();
+}
@@ -0,0 +1,80 @@
+/**
+ * @file main.cpp
+ * @brief Executável nativo (Linux): simulação da estação e micro-benchmarks
+ *
+ * Compila as bibliotecas de lib/ contra o backend simulado do Hal (HalFake.h).
+ *   pio run -e native && .pio/build/native/program [cenario ...]
+ * Sem argumentos, executa todos os cenários. Termina com código 1 se
+ * alguma verificação (NativeCheck.h) falhou.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "NativeCheck.h"
+#include "NativeScenarios.h"
+
+struct Scenario
+{
+    const char *name;
+    void (*run)();
+};
+
+static const Scenario SCENARIOS[] = {
+    {"station", scenarioStation},
+    {"tracker", scenarioTracker},
+    {"ephemeris", scenarioEphemeris},
+    {"calibration", scenarioCalibration},
+    {"metrics", scenarioMetrics},
+    {"sampling", scenarioSampling},
+    {"lowpower", scenarioLowPower},
+    {"alarms", scenarioAlarms},
+    {"samplelog", scenarioSampleLog},
+    {"export", scenarioExport},
+    {"admission", scenarioAdmission},
+    {"health", scenarioHealth},
+    {"adc", scenarioCheckAdc},
+    {"seqlock", scenarioCheckSeqLock},
+    {"check", scenarioCheckCore},
+    {"bench", scenarioBenchCore},
+};
+static const size_t SCENARIO_COUNT = sizeof(SCENARIOS) / sizeof(SCENARIOS[0]);
+
+int main(int argc, char **argv)
+{
+    int executed = 0;
+    for (size_t i = 0; i < SCENARIO_COUNT; i++)
+    {
+        bool selected = (argc < 2);
+        for (int a = 1; a < argc; a++)
+            if (strcmp(argv[a], SCENARIOS[i].name) == 0)
+                selected = true;
+        if (!selected)
+            continue;
+
+        printf("=== %s ===\n", SCENARIOS[i].name);
+        uint32_t checks = nativeCheckCount(), failures = nativeCheckFailures();
+        SCENARIOS[i].run();
+        checks = nativeCheckCount() - checks;
+        failures = nativeCheckFailures() - failures;
+        if (checks > 0)
+            printf(" verificações: %lu, falhas: %lu\n", (unsigned long)checks, (unsigned long)failures);
+        printf("\n");
+        executed++;
+    }
+
+    if (executed == 0)
+    {
+        printf("Cenários disponíveis:");
+        for (size_t i = 0; i < SCENARIO_COUNT; i++)
+            printf(" %s", SCENARIOS[i].name);
+        printf("\n");
+        return 1;
+    }
+    if (nativeCheckFailures() > 0)
+    {
+        printf("%lu de %lu verificações FALHARAM\n", (unsigned long)nativeCheckFailures(),
+               (unsigned long)nativeCheckCount());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,312 @@
+/**
+ * @file scenario_admission.cpp
+ * @brief Admissão de requisições: clientes agressivos contra um cliente comum
+ *
+ * Simulação em passos de 1 ms de 60 s de servidor. Cada conexão ocupa um
+ * PCB do lwIP (16 no ESP32) e heap do AsyncTCP enquanto está aberta; sem PCB
+ * livre a conexão é recusada. Os clientes agressivos mantêm várias
+ * requisições pesadas abertas, repetem assim que cada uma termina e, quando
+ * recusados, tentam de novo em 50 ms, ignorando o Retry-After.
+ * O cliente comum é a página, com polling de /data.bin a cada 1 s.
+ *
+ * Depois, o carregamento do painel (/time, um /history por gráfico e o
+ * primeiro /data.bin) em vários celulares ao mesmo tempo: a página antiga
+ * pedia tudo de uma vez e perdia o que levava 503; a atual pede uma de cada
+ * vez e repete após o Retry-After.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "AdmissionControl.h"
+#include "NativeCheck.h"
+#include "NativeScenarios.h"
+
+static const uint32_t SIM_MS = 60000;
+static const uint32_t AGGRESSIVE = 4;
+static const uint32_t LWIP_PCBS = 16;
+static const uint32_t HEAP_PER_REQUEST = 3000; // Request + cabeçalhos + buffers do AsyncTCP (estimado)
+static const uint32_t REJECT_MS = 3;           // 503 curto: conexão fechada logo
+static const uint32_t RETRY_MS = 50;           // Agressivo: ignora o Retry-After, só espera a volta do 503
+
+// Rotas simuladas: tempo de atendimento e se conta como polling
+struct Route
+{
+    uint32_t serviceMs;
+    bool poll;
+};
+static const Route POLL = {30, true};      // /data.bin
+static const Route HISTORY = {400, false}; // /history chunked
+static const Route TIME = {5, false};      // /time
+
+struct Stream
+{
+    uint32_t ip;
+    Route route;
+    uint32_t periodMs; // 0 = repete assim que a anterior termina
+    uint32_t nextMs;
+    uint32_t busyUntil;
+    bool open;
+    bool admitted;
+    uint32_t sent, ok, shed, refused;
+};
+
+struct SimResult
+{
+    uint32_t peakConnections;
+    uint32_t peakHeap;
+    uint32_t normalSent, normalOk;
+    uint32_t aggressiveOk;
+};
+
+static void simulate(bool admission, SimResult &r, AdmissionControl &control)
+{
+    Stream streams[AGGRESSIVE * 4 + 1];
+    int count = 0;
+    // Clientes agressivos com 3 requisições de /history sempre abertas e
+    // um laço apertado de /data.bin cada
+    for (uint32_t c = 0; c < AGGRESSIVE; c++)
+    {
+        for (int k = 0; k < 3; k++)
+            streams[count++] = {0x0A000002u + c, HISTORY, 0, c * 7 + k, 0, false, false, 0, 0, 0, 0};
+        streams[count++] = {0x0A000002u + c, POLL, 20, c * 3, 0, false, false, 0, 0, 0, 0};
+    }
+    const int normal = count;
+    streams[count++] = {0x0A000010u, POLL, 1000, 500, 0, false, false, 0, 0, 0, 0};
+
+    memset(&r, 0, sizeof(r));
+    uint32_t connections = 0, heapBytes = 0;
+
+    for (uint32_t now = 0; now < SIM_MS; now++)
+    {
+        // Requisições que terminam neste passo
+        for (int i = 0; i < count; i++)
+        {
+            Stream &s = streams[i];
+            if (!s.open || now < s.busyUntil)
+                continue;
+            s.open = false;
+            connections--;
+            heapBytes -= HEAP_PER_REQUEST;
+            if (s.admitted && admission)
+                control.release(s.ip);
+            if (s.admitted)
+                s.ok++;
+            s.nextMs = s.periodMs ? s.nextMs + s.periodMs : now + (s.admitted ? 0 : RETRY_MS);
+            if (s.nextMs < now && s.periodMs)
+                s.nextMs = now;
+        }
+
+        // Requisições que começam
+        for (int i = 0; i < count; i++)
+        {
+            Stream &s = streams[i];
+            if (s.open || now < s.nextMs)
+                continue;
+            s.sent++;
+            if (connections >= LWIP_PCBS)
+            {
+                // Sem PCB: a conexão nem chega ao servidor; tenta de novo
+                s.refused++;
+                s.nextMs = s.periodMs ? s.nextMs + s.periodMs : now + RETRY_MS;
+                continue;
+            }
+            connections++;
+            heapBytes += HEAP_PER_REQUEST;
+            s.open = true;
+
+            uint16_t retry;
+            s.admitted = !admission || control.admit(s.ip, now, s.route.poll, retry) == ADMIT_OK;
+            s.busyUntil = now + (s.admitted ? s.route.serviceMs : REJECT_MS);
+            if (!s.admitted)
+                s.shed++;
+        }
+
+        if (connections > r.peakConnections)
+            r.peakConnections = connections;
+        if (heapBytes > r.peakHeap)
+            r.peakHeap = heapBytes;
+    }
+
+    r.normalSent = streams[normal].sent;
+    r.normalOk = streams[normal].ok;
+    for (int i = 0; i < normal; i++)
+        r.aggressiveOk += streams[i].ok;
+}
+
+// Carregamento do painel: /time, um /history por gráfico e o primeiro /data.bin
+static const Route PAGE_LOAD[] = {TIME, HISTORY, HISTORY, HISTORY, HISTORY, HISTORY, POLL};
+static const int PAGE_REQUESTS = sizeof(PAGE_LOAD) / sizeof(PAGE_LOAD[0]);
+static const uint32_t MAX_PHONES = 8;
+static const uint32_t LOAD_SIM_MS = 30000;
+static const uint32_t NOT_YET = 0xFFFFFFFFu; // Espera a anterior (página sequencial)
+
+struct PageRequest
+{
+    uint32_t nextMs;
+    uint32_t busyUntil;
+    bool open, admitted, done, lost;
+};
+
+struct LoadResult
+{
+    uint32_t served, lost, shed;
+    uint32_t lastMs; // Quando a última requisição atendida terminou
+};
+
+static void loadPages(bool sequential, uint32_t phones, LoadResult &r)
+{
+    AdmissionControl control;
+    static PageRequest req[MAX_PHONES][PAGE_REQUESTS];
+    memset(req, 0, sizeof(req));
+    memset(&r, 0, sizeof(r));
+    for (uint32_t p = 0; p < phones; p++)
+        for (int i = 1; i < PAGE_REQUESTS; i++)
+            req[p][i].nextMs = sequential ? NOT_YET : 0;
+
+    for (uint32_t now = 0; now < LOAD_SIM_MS; now++)
+    {
+        for (uint32_t p = 0; p < phones; p++)
+            for (int i = 0; i < PAGE_REQUESTS; i++)
+            {
+                PageRequest &q = req[p][i];
+                if (!q.open || now < q.busyUntil)
+                    continue;
+                q.open = false;
+                control.release(0x0A000020u + p);
+                q.done = true;
+                r.served++;
+                r.lastMs = now;
+                if (sequential && i + 1 < PAGE_REQUESTS)
+                    req[p][i + 1].nextMs = now;
+            }
+
+        for (uint32_t p = 0; p < phones; p++)
+            for (int i = 0; i < PAGE_REQUESTS; i++)
+            {
+                PageRequest &q = req[p][i];
+                if (q.open || q.done || q.lost || now < q.nextMs)
+                    continue;
+                uint16_t retry;
+                q.admitted = control.admit(0x0A000020u + p, now, PAGE_LOAD[i].poll, retry) == ADMIT_OK;
+                if (q.admitted)
+                {
+                    q.open = true;
+                    q.busyUntil = now + PAGE_LOAD[i].serviceMs;
+                    continue;
+                }
+                r.shed++;
+                // Página antiga: r.json() falha no corpo "ocupado" e ninguém repete
+                if (sequential)
+                    q.nextMs = now + REJECT_MS + retry * 1000u;
+                else
+                {
+                    q.lost = true;
+                    r.lost++;
+                }
+            }
+    }
+}
+
+static void pageLoad()
+{
+    static const uint32_t PHONES[] = {1, 4, MAX_PHONES};
+    printf("\n Carregamento do painel (%d requisições) em N celulares ao mesmo tempo: atendidas/pedidas (503, última em s)\n",
+           PAGE_REQUESTS);
+    printf(" %-26s", "");
+    for (size_t k = 0; k < sizeof(PHONES) / sizeof(PHONES[0]); k++)
+        printf(" %16lu cel.", (unsigned long)PHONES[k]);
+    printf("\n");
+
+    for (int sequential = 0; sequential < 2; sequential++)
+    {
+        printf(" %-26s", sequential ? "sequencial + Retry-After" : "tudo junto, sem repetir");
+        for (size_t k = 0; k < sizeof(PHONES) / sizeof(PHONES[0]); k++)
+        {
+            LoadResult r;
+            loadPages(sequential != 0, PHONES[k], r);
+            printf(" %6lu/%-3lu (%2lu, %4.1f)", (unsigned long)r.served,
+                   (unsigned long)(PHONES[k] * PAGE_REQUESTS), (unsigned long)r.shed, r.lastMs / 1000.0f);
+            if (sequential)
+            {
+                CHECK_EQ(r.served, PHONES[k] * PAGE_REQUESTS); // Todas atendidas, cedo ou tarde
+                CHECK_EQ(r.lost, 0);
+            }
+            else if (PHONES[k] == 1)
+                CHECK(r.lost > 0); // O defeito que a página corrigiu
+        }
+        printf("\n");
+    }
+}
+
+void scenarioAdmission()
+{
+    printf(" 60 s: 4 clientes agressivos (3 /history abertos + /data.bin a cada 20 ms) e a página (/data.bin a cada 1 s)\n");
+    printf(" %-16s %9s %9s %14s %16s\n", "", "conexões", "heap KB", "página ok", "agressivos ok");
+
+    AdmissionControl unused;
+    SimResult off;
+    simulate(false, off, unused);
+    printf(" %-16s %9lu %9lu %8lu/%-5lu %16lu\n", "sem admissão", (unsigned long)off.peakConnections,
+           (unsigned long)(off.peakHeap / 1024), (unsigned long)off.normalOk, (unsigned long)off.normalSent,
+           (unsigned long)off.aggressiveOk);
+
+    AdmissionControl control;
+    SimResult on;
+    simulate(true, on, control);
+    printf(" %-16s %9lu %9lu %8lu/%-5lu %16lu\n", "com admissão", (unsigned long)on.peakConnections,
+           (unsigned long)(on.peakHeap / 1024), (unsigned long)on.normalOk, (unsigned long)on.normalSent,
+           (unsigned long)on.aggressiveOk);
+    CHECK_EQ(on.normalOk, on.normalSent); // A página nunca fica sem resposta
+    CHECK(on.peakConnections < LWIP_PCBS);
+
+    const AdmissionStats &st = control.stats();
+    printf("  contadores: ");
+    for (int i = 0; i < ADMIT_RESULT_COUNT; i++)
+        printf("%s %lu  ", AdmissionControl::resultName((AdmissionResult)i), (unsigned long)st.results[i]);
+    printf("\n  em andamento: pico %lu (limite %u), clientes na tabela %lu\n", (unsigned long)st.peakInFlight,
+           (unsigned)control.config().maxInFlight, (unsigned long)st.clients);
+    CHECK(st.peakInFlight <= control.config().maxInFlight);
+
+    // Retry-After do polling e reaproveitamento da tabela
+    AdmissionControl table;
+    uint16_t retry = 0;
+    table.admit(1, 0, true, retry);
+    table.release(1);
+    AdmissionResult early = table.admit(1, 100, true, retry);
+    printf("  polling 100 ms depois do anterior: %s, Retry-After %u s\n", AdmissionControl::resultName(early),
+           (unsigned)retry);
+    CHECK_EQ(early, ADMIT_SHED_RATE);
+    CHECK_EQ(retry, 1);
+    for (uint32_t ip = 2; ip <= ADMISSION_MAX_CLIENTS + 1; ip++)
+    {
+        table.admit(ip, 200, false, retry);
+        table.release(ip);
+    }
+    AdmissionResult full = table.admit(100, 300, false, retry);
+    AdmissionResult later = table.admit(100, 300 + table.config().idleMs, false, retry);
+    printf("  tabela cheia: cliente novo %s; depois de %lu s ociosos: %s (%lu reaproveitada(s))\n",
+           AdmissionControl::resultName(full), (unsigned long)(table.config().idleMs / 1000),
+           AdmissionControl::resultName(later), (unsigned long)table.stats().evictions);
+    CHECK_EQ(full, ADMIT_SHED_TABLE);
+    CHECK_EQ(later, ADMIT_OK);
+    CHECK_EQ(table.stats().evictions, 1);
+
+    // Limites por cliente e posições guardadas para quem não tem nada em andamento
+    AdmissionControl limits;
+    CHECK_EQ(limits.admit(1, 0, false, retry), ADMIT_OK);
+    CHECK_EQ(limits.admit(1, 0, false, retry), ADMIT_OK);
+    CHECK_EQ(limits.admit(1, 0, false, retry), ADMIT_SHED_BUSY); // maxPerClient = 2
+    CHECK_EQ(limits.admit(2, 0, false, retry), ADMIT_OK);
+    CHECK_EQ(limits.admit(2, 0, false, retry), ADMIT_OK);
+    // 4 em andamento: a segunda de um cliente esbarra nas 2 guardadas, a primeira entra
+    CHECK_EQ(limits.admit(3, 0, false, retry), ADMIT_OK);
+    CHECK_EQ(limits.admit(3, 0, false, retry), ADMIT_SHED_BUSY);
+    CHECK_EQ(limits.admit(4, 0, false, retry), ADMIT_OK);
+    CHECK_EQ(limits.admit(5, 0, false, retry), ADMIT_SHED_BUSY); // maxInFlight = 6
+    CHECK_EQ(retry, limits.config().retryAfterSec);
+    limits.release(1);
+    CHECK_EQ(limits.admit(5, 0, false, retry), ADMIT_OK);
+    CHECK_EQ(limits.stats().inFlight, 6);
+
+    pageLoad();
+}
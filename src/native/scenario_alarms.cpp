@@ -0,0 +1,200 @@
+/**
+ * @file scenario_alarms.cpp
+ * @brief Regras de alarme: oscilação no limiar, confirmação/rearme, taxa e custo
+ *
+ * O "legado" é o alarme antigo: OR de comparações diretas, e uma confirmação
+ * que nunca é desfeita.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "AlarmEngine.h"
+#include "AlarmJsonStream.h"
+#include "NativeBench.h"
+#include "NativeCheck.h"
+#include "NativeScenarios.h"
+
+static const uint32_t STEP_MS = 1000; // Uma publicação por segundo
+
+static const AlarmRule TEMP_RULE = {ALARM_CH_TEMP, ALARM_ABOVE, 1, 0, 40.0f, 1.0f, 5000, 0};
+static const AlarmRule PRES_FALL_RULE = {ALARM_CH_PRES, ALARM_FALL, 1, 0, 3.0f, 1.0f, 0, 1800000};
+
+static float noise(uint32_t &seed, float amplitude)
+{
+    seed = seed * 1103515245u + 12345u;
+    return ((int)((seed >> 16) % 2001) - 1000) * amplitude / 1000.0f;
+}
+
+static void fillValues(float values[ALARM_CH_COUNT], float temp, float pres)
+{
+    values[ALARM_CH_TEMP] = temp;
+    values[ALARM_CH_HUM] = 50.0f;
+    values[ALARM_CH_PRES] = pres;
+    values[ALARM_CH_UV] = 1.0f;
+    values[ALARM_CH_LUMENS] = 100.0f;
+}
+
+// 1. Temperatura passeando em volta de 40 C com ruído, por 30 min
+static void flapping()
+{
+    AlarmEngine engine;
+    engine.addRule(TEMP_RULE);
+    uint32_t seed = 7;
+    uint32_t legacyEdges = 0;
+    bool legacyLast = false;
+    float values[ALARM_CH_COUNT];
+
+    for (uint32_t t = 0; t < 1800; t++)
+    {
+        float temp = 39.8f + 0.6f * sinf(t / 120.0f) + noise(seed, 0.3f);
+        fillValues(values, temp, 1013.0f);
+        engine.evaluate(values, t * STEP_MS);
+        if (engine.active())
+            engine.acknowledgeAll(); // Usuário confirma cada alarme na hora
+
+        bool legacy = temp > 40.0f;
+        if (legacy && !legacyLast)
+            legacyEdges++;
+        legacyLast = legacy;
+    }
+    printf(" Oscilação em volta de 40 C (30 min, ruído +/-0.3): legado %lu disparos, regras %lu\n",
+           (unsigned long)legacyEdges, (unsigned long)engine.status(0).triggers);
+}
+
+// 2. Dois eventos de calor separados; o usuário confirma o primeiro
+static void rearm()
+{
+    AlarmEngine engine;
+    engine.addRule(TEMP_RULE);
+    bool legacyAck = false;
+    uint32_t legacyShown = 0, engineShown = 0;
+    bool legacyLast = false, engineLast = false;
+    float values[ALARM_CH_COUNT];
+
+    for (uint32_t t = 0; t < 600; t++)
+    {
+        // Calor em [60, 180) e [360, 480)
+        float temp = ((t >= 60 && t < 180) || (t >= 360 && t < 480)) ? 45.0f : 30.0f;
+        fillValues(values, temp, 1013.0f);
+        engine.evaluate(values, t * STEP_MS);
+        if (t == 90)
+        {
+            engine.acknowledgeAll();
+            legacyAck = true;
+        }
+
+        bool legacy = temp > 40.0f && !legacyAck;
+        bool shown = engine.active();
+        if (legacy && !legacyLast)
+            legacyShown++;
+        if (shown && !engineLast)
+            engineShown++;
+        legacyLast = legacy;
+        engineLast = shown;
+    }
+    printf(" Dois eventos, o 1o confirmado: popup do legado %lu vez(es), das regras %lu vez(es)\n",
+           (unsigned long)legacyShown, (unsigned long)engineShown);
+}
+
+// 3. Pressão caindo 4 hPa/h a partir de 1 h, com ruído do BME280
+static void pressureFall()
+{
+    AlarmEngine engine;
+    engine.addRule(PRES_FALL_RULE);
+    uint32_t seed = 11;
+    float values[ALARM_CH_COUNT];
+    long detectedS = -1;
+
+    for (uint32_t t = 0; t < 4 * 3600; t++)
+    {
+        float hours = t / 3600.0f;
+        float pres = 1013.0f - (hours > 1.0f ? 4.0f * (hours - 1.0f) : 0.0f) + noise(seed, 0.03f);
+        fillValues(values, 25.0f, pres);
+        engine.evaluate(values, t * STEP_MS);
+        if (detectedS < 0 && engine.active())
+            detectedS = t;
+    }
+    printf(" Queda de 4 hPa/h a partir de 1 h (regra: 3 hPa/h, janela 30 min): disparou em %.2f h (%.0f min após o início)\n",
+           detectedS / 3600.0, (detectedS - 3600) / 60.0);
+}
+
+// 4. Custo com a tabela cheia
+static void cost()
+{
+    AlarmEngine engine;
+    for (int i = 0; i < ALARM_MAX_RULES; i++)
+    {
+        AlarmRule rule = (i % 3 == 2) ? PRES_FALL_RULE : TEMP_RULE;
+        rule.channel = (i % 3 == 2) ? ALARM_CH_PRES : i % ALARM_CH_COUNT;
+        rule.threshold = (i % 3 == 2) ? 3.0f : 40.0f + i;
+        engine.addRule(rule);
+    }
+
+    uint32_t now = 0;
+    float values[ALARM_CH_COUNT];
+    fillValues(values, 41.0f, 1013.0f);
+    printf(" Custo (%d regras)\n", ALARM_MAX_RULES);
+    benchRun("AlarmEngine::evaluate", 200000, [&]()
+             {
+                 now += STEP_MS;
+                 values[ALARM_CH_TEMP] = 38.0f + (now / 1000 % 8);
+                 engine.evaluate(values, now);
+                 benchKeep(engine.active()); });
+
+    AlarmJsonStream stream(engine.snapshot());
+    uint8_t buf[512];
+    size_t total = 0, chunks = 0, n;
+    while ((n = stream.fill(buf, sizeof(buf))) > 0)
+    {
+        total += n;
+        chunks++;
+    }
+    printf("  /rules com %d regras: %lu bytes em %lu pedaços de até %lu\n", ALARM_MAX_RULES, (unsigned long)total,
+           (unsigned long)chunks, (unsigned long)sizeof(buf));
+}
+
+// 5. Tabela editada guardada antes do deep sleep e restaurada no despertar
+static void persistence()
+{
+    AlarmEngine before;
+    before.addRule(TEMP_RULE);
+    before.addRule(PRES_FALL_RULE);
+    AlarmRule edited = TEMP_RULE;
+    edited.threshold = 35.0f;
+    before.setRule(0, edited);
+
+    AlarmRuleImage image;
+    before.saveRules(image);
+
+    AlarmEngine after;
+    after.addRule(TEMP_RULE); // Tabela padrão carregada antes do restauro
+    CHECK(after.loadRules(image));
+    CHECK_EQ(after.snapshot().count, 2);
+    CHECK(memcmp(after.snapshot().rules, before.snapshot().rules, 2 * sizeof(AlarmRule)) == 0);
+
+    // Memória RTC após partida a frio (zeros) ou bit trocado: fica a padrão
+    AlarmRuleImage bad;
+    memset(&bad, 0, sizeof(bad));
+    CHECK(!after.loadRules(bad));
+    bad = image;
+    bad.rules[1].threshold = 4.0f;
+    CHECK(!after.loadRules(bad));
+    bad = image;
+    bad.count = ALARM_MAX_RULES + 1;
+    CHECK(!after.loadRules(bad));
+    CHECK_EQ(after.snapshot().count, 2);
+
+    printf(" Regras no deep sleep: %lu bytes de memória RTC, cópia corrompida rejeitada\n",
+           (unsigned long)sizeof(AlarmRuleImage));
+}
+
+void scenarioAlarms()
+{
+    flapping();
+    rearm();
+    pressureFall();
+    cost();
+    persistence();
+}
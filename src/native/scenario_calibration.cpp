@@ -0,0 +1,140 @@
+/**
+ * @file scenario_calibration.cpp
+ * @brief Conversões do ADC em ponto fixo: erro contra os modelos em double e custo
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "AnalogCalibration.h"
+#include "SensorCurves.h"
+#include "NativeBench.h"
+#include "NativeCheck.h"
+#include "NativeScenarios.h"
+
+// Modelos de referência (os mesmos usados para gerar as tabelas)
+static double typicalMv(int raw)
+{
+    double x = raw;
+    return (-9.824e-12 * x * x * x + 1.6557283e-8 * x * x + 8.54596860691e-4 * x + 0.065440348345433) * 1000.0;
+}
+
+static double ldrLux(double mv)
+{
+    double r = 10000.0 * (3300.0 / mv - 1.0);
+    return 10.0 * pow(15000.0 / r, 1.0 / 0.7);
+}
+
+// Fórmulas em float do código antigo (GYML8511)
+static float legacyVoltage(int raw)
+{
+    return (raw * 3.3f) / 4095;
+}
+
+static float legacyUv(float voltage)
+{
+    float intensity = (voltage - 0.99f) * (15.0f / (2.8f - 0.99f));
+    return intensity < 0 ? 0 : intensity;
+}
+
+static void accuracy()
+{
+    printf(" Precisão (todas as 4096 contagens)\n");
+    AdcCalibration typical;
+    AdcCalibration linear;
+    linear.setLinear(3300);
+
+    double worstTyp = 0, sumTyp = 0, worstLin = 0, worstUv = 0, worstLux = 0, worstLuxLow = 0;
+    uint32_t backwards = 0;
+    for (int raw = 0; raw < 4096; raw++)
+    {
+        if (raw > 0 && typical.rawToMv(raw) < typical.rawToMv(raw - 1))
+            backwards++;
+
+        double errTyp = fabs(typical.rawToMv(raw) - typicalMv(raw));
+        sumTyp += errTyp;
+        if (errTyp > worstTyp)
+            worstTyp = errTyp;
+
+        double errLin = fabs(linear.rawToMv(raw) - legacyVoltage(raw) * 1000.0);
+        if (errLin > worstLin)
+            worstLin = errLin;
+
+        double uv = calInterpolate(GYML8511_UV_CURVE, linear.rawToMv(raw)) / 1000.0;
+        double uvRef = legacyUv(legacyVoltage(raw));
+        if (uvRef > 15.0)
+            uvRef = 15.0; // Fim da escala do sensor
+        if (fabs(uv - uvRef) > worstUv)
+            worstUv = fabs(uv - uvRef);
+
+        // Lux: erro relativo a partir de 10 lux, absoluto abaixo (resolução de 1 lux)
+        double mv = typical.rawToMv(raw);
+        double luxRef = ldrLux(mv);
+        double lux = calInterpolate(LDR_LUX_CURVE, (int32_t)mv);
+        if (luxRef >= 10.0)
+        {
+            double rel = fabs(lux - luxRef) / luxRef;
+            if (rel > worstLux)
+                worstLux = rel;
+        }
+        else if (fabs(lux - luxRef) > worstLuxLow)
+        {
+            worstLuxLow = fabs(lux - luxRef);
+        }
+    }
+    printf("  contagens -> mV (tabela típica vs polinômio): erro med %.2f mV, max %.2f mV\n", sumTyp / 4096, worstTyp);
+    printf("  contagens -> mV (tabela linear vs fórmula antiga): erro max %.2f mV\n", worstLin);
+    printf("  UV em µW/cm² vs fórmula antiga em float:        erro max %.4f mW/cm²\n", worstUv);
+    printf("  lux por tabela vs modelo do LDR:               erro max %.1f%% (>= 10 lux), %.1f lux (< 10 lux)\n",
+           worstLux * 100, worstLuxLow);
+
+    // Limites declarados para as tabelas; uma tabela quebrada estoura algum deles
+    CHECK_EQ(backwards, 0);
+    CHECK(sumTyp / 4096 < 0.5);
+    CHECK(worstTyp < 1.5);
+    CHECK(worstLin < 1.0);
+    CHECK(worstUv < 0.01);
+    CHECK(worstLux < 0.09);
+    CHECK(worstLuxLow <= 1.0);
+
+    // Sem eFuse (host): loadFromEfuse() recusa e mantém a tabela em uso
+    uint16_t before[4096];
+    for (int raw = 0; raw < 4096; raw++)
+        before[raw] = linear.rawToMv(raw);
+    CHECK(!linear.loadFromEfuse());
+    CHECK(strcmp(linear.source(), "linear") == 0);
+    uint32_t changed = 0;
+    for (int raw = 0; raw < 4096; raw++)
+        changed += linear.rawToMv(raw) != before[raw];
+    CHECK_EQ(changed, 0);
+}
+
+static void cost()
+{
+    printf(" Custo por conversão\n");
+    AdcCalibration cal;
+    int raw = 0;
+
+    benchRun("contagens -> mV (tabela, inteiros)", 1000000, [&]()
+             { benchKeep(cal.rawToMv(raw = (raw + 37) & 4095)); });
+    benchRun("contagens -> mV (polinômio, float)", 1000000, [&]()
+             { raw = (raw + 37) & 4095; float x = raw; benchKeep((-9.824e-12f * x * x * x + 1.6557283e-8f * x * x + 8.54597e-4f * x + 0.06544f) * 1000.0f); });
+    benchRun("contagens -> lux (tabelas, inteiros)", 1000000, [&]()
+             { benchKeep(calInterpolate(LDR_LUX_CURVE, cal.rawToMv(raw = (raw + 37) & 4095))); });
+    benchRun("contagens -> lux (modelo, powf)", 1000000, [&]()
+             {
+                 raw = (raw + 37) & 4095;
+                 float mv = cal.rawToMv(raw) + 1.0f;
+                 float r = 10000.0f * (3300.0f / mv - 1.0f);
+                 benchKeep(10.0f * powf(15000.0f / r, 1.0f / 0.7f)); });
+    benchRun("contagens -> UV (tabelas, inteiros)", 1000000, [&]()
+             { benchKeep(calInterpolate(GYML8511_UV_CURVE, cal.rawToMv(raw = (raw + 37) & 4095))); });
+    benchRun("contagens -> UV (fórmula antiga, float)", 1000000, [&]()
+             { benchKeep(legacyUv(legacyVoltage(raw = (raw + 37) & 4095))); });
+}
+
+void scenarioCalibration()
+{
+    accuracy();
+    cost();
+}
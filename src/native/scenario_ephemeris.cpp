@@ -0,0 +1,247 @@
+/**
+ * @file scenario_ephemeris.cpp
+ * @brief Efeméride solar: precisão, custo e um dia de seguimento simulado
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include "Hal.h"
+#include "HalFake.h"
+#include "SolarEphemeris.h"
+#include "SunTracker.h"
+#include "NativeBench.h"
+#include "NativeCheck.h"
+#include "NativeScenarios.h"
+#include "SimLight.h"
+#include "SolarReference.h"
+
+struct Site
+{
+    const char *name;
+    float latitude;
+    float longitude;
+};
+
+static const Site SITES[] = {
+    {"São Paulo", -23.55f, -46.63f},
+    {"Quito", -0.18f, -78.47f},
+    {"Oslo", 59.91f, 10.75f},
+    {"Sydney", -33.87f, 151.21f},
+};
+
+// 2026-01-01 00:00 UTC
+static const uint32_t YEAR_2026 = 1767225600u;
+
+// Erro máximo aceito contra a referência (float de 32 bits; o tracker
+// tolera bem mais que isso)
+static const double MAX_ERROR_DEG = 0.05;
+
+/**
+ * @brief Ângulo entre duas direções (az/el) em graus
+ */
+static double angularDistance(double az1, double el1, double az2, double el2)
+{
+    const double D2R = M_PI / 180.0;
+    double c = sin(el1 * D2R) * sin(el2 * D2R) + cos(el1 * D2R) * cos(el2 * D2R) * cos((az1 - az2) * D2R);
+    if (c > 1)
+        c = 1;
+    return acos(c) / D2R;
+}
+
+static void accuracy()
+{
+    printf(" Precisão vs referência NOAA (sol acima do horizonte)\n");
+    printf("  %-12s %8s %14s %14s\n", "local", "amostras", "erro med", "erro max");
+
+    // Ano de 2026 de hora em hora, deslocado 17 min por dia para cobrir o relógio todo
+    for (size_t s = 0; s < sizeof(SITES) / sizeof(SITES[0]); s++)
+    {
+        double sum = 0, worst = 0;
+        uint32_t count = 0;
+        for (uint32_t h = 0; h < 365 * 24; h++)
+        {
+            uint32_t t = YEAR_2026 + h * 3600 + (h / 24) * 17 * 60;
+            double refAz, refEl;
+            solarPositionReference(t, SITES[s].latitude, SITES[s].longitude, refAz, refEl);
+            if (refEl < 0)
+                continue;
+
+            SolarPosition sun;
+            solarPosition(t, SITES[s].latitude, SITES[s].longitude, sun);
+            double err = angularDistance(sun.azimuth, sun.elevation, refAz, refEl);
+            sum += err;
+            if (err > worst)
+                worst = err;
+            count++;
+        }
+        printf("  %-12s %8u %10.4f deg %10.4f deg\n", SITES[s].name, count, sum / count, worst);
+        CHECK(count > 4000); // Metade do ano com sol
+        CHECK(worst < MAX_ERROR_DEG);
+    }
+
+    // Deriva ao longo dos anos (São Paulo, dia 1 de cada mês ao meio-dia local)
+    double worst = 0;
+    for (uint32_t month = 0; month < 50 * 12; month++)
+    {
+        uint32_t t = 946684800u + month * 2629746u + 15 * 3600;
+        double refAz, refEl;
+        SolarPosition sun;
+        solarPositionReference(t, SITES[0].latitude, SITES[0].longitude, refAz, refEl);
+        solarPosition(t, SITES[0].latitude, SITES[0].longitude, sun);
+        double err = angularDistance(sun.azimuth, sun.elevation, refAz, refEl);
+        if (err > worst)
+            worst = err;
+    }
+    printf("  2000-2049 (São Paulo, mensal): erro max %.4f deg\n", worst);
+    CHECK(worst < MAX_ERROR_DEG);
+
+    // Pontos conhecidos: equinócio em (0,0) e solstício no trópico de Câncer, ao meio-dia solar
+    SolarPosition sun;
+    solarPosition(1773964800u + 12 * 3600 + 7 * 60, 0.0f, 0.0f, sun); // 2026-03-20 12:07 UTC
+    printf("  Equinócio 2026, lat 0 lon 0, 12:07 UTC: elevação %.2f (esperado ~89.9)\n", sun.elevation);
+    CHECK_NEAR(sun.elevation, 89.9, 0.1);
+    solarPosition(1782043200u + 2 * 60, 23.44f, 0.0f, sun); // 2026-06-21 12:02 UTC
+    printf("  Solstício 2026, lat 23.44 lon 0, 12:02 UTC: elevação %.2f (esperado ~90.0)\n", sun.elevation);
+    CHECK_NEAR(sun.elevation, 90.0, 0.1);
+}
+
+static void cost()
+{
+    printf(" Custo por chamada\n");
+    SolarPosition sun;
+    uint32_t t = YEAR_2026;
+    benchRun("solarPosition (float)", 200000, [&]()
+             { solarPosition(t += 61, -23.55f, -46.63f, sun); benchKeep(sun); });
+
+    double az, el;
+    benchRun("solarPositionReference (double, NOAA)", 200000, [&]()
+             { solarPositionReference(t += 61, -23.55, -46.63, az, el); benchKeep(el); });
+
+    const uint32_t calls = 100000;
+    uint64_t start = benchCycles();
+    for (uint32_t i = 0; i < calls; i++)
+    {
+        solarPosition(t += 61, -23.55f, -46.63f, sun);
+        benchKeep(sun);
+    }
+    uint64_t cycles = benchCycles() - start;
+    if (cycles > 0)
+        printf("  %-40s %10.1f ciclos/chamada (TSC do host)\n", "solarPosition (float)", (double)cycles / calls);
+}
+
+/**
+ * @brief Ângulos de servo que apontam para o sol com a montagem real
+ */
+static void sunToServo(const SolarPosition &sun, const TrackerMount &mount, float &x, float &y)
+{
+    float azOffset = fmodf(sun.azimuth - mount.azimuthAtCenter + 540.0f, 360.0f) - 180.0f;
+    x = 90.0f + azOffset * mount.azimuthScale;
+    y = 90.0f + (sun.elevation - mount.elevationAtCenter) * mount.elevationScale;
+}
+
+static void trackingDay()
+{
+    enum
+    {
+        LDR_TL = 34,
+        LDR_TR = 39,
+        LDR_BL = 35,
+        LDR_BR = 36
+    };
+    static FakeClock clock;
+    static FakeGpio gpio;
+    static FakeAdcSource adc;
+    Hal::install(&clock, &gpio, &adc, nullptr);
+
+    printf(" Um dia em São Paulo (21/06/2026, 07h-17h), nuvens das 12h às 13h,\n");
+    printf(" montagem girada 3 graus em relação à configuração\n");
+    printf("  %-12s %16s %10s %12s %12s %12s\n", "modo", "erro med/max", "curso", "escritas/h", "PWM ativo", "ADC lidos");
+
+    // Montagem real difere da configurada: a correção fina deve compensar
+    TrackerMount actual = TRACKER_DEFAULT_MOUNT;
+    actual.azimuthAtCenter += 3.0f;
+
+    const TrackerMode modes[] = {TRACKER_MODE_PID, TRACKER_MODE_EPHEMERIS};
+    const char *names[] = {"LDR (PID)", "efeméride"};
+    const uint32_t start = 1782036000u; // 2026-06-21 10:00 UTC = 07:00 local
+    const uint32_t tickMs = 50;
+
+    for (int m = 0; m < 2; m++)
+    {
+        FakeServo servoX, servoY;
+        SunTracker tracker(LDR_TL, LDR_TR, LDR_BL, LDR_BR, 26, 27, servoX, servoY);
+        tracker.begin();
+        tracker.setTolerance(50);
+        tracker.setMode(modes[m]);
+        tracker.setGains(TRACKER_AXIS_X, TRACKER_P_GAINS);
+        tracker.setGains(TRACKER_AXIS_Y, TRACKER_P_GAINS);
+
+        SimLight light;
+        TravelMeter travelX, travelY;
+        travelX.start(servoX.angle());
+        travelY.start(servoY.angle());
+        uint32_t adcReads = adc.readCount();
+
+        double errSum = 0;
+        float errMax = 0;
+        uint32_t ticks = 0;
+        SolarPosition sun;
+        for (uint32_t ms = 0; ms < 10u * 3600u * 1000u; ms += tickMs)
+        {
+            uint32_t now = start + ms / 1000;
+            if (ms % 1000 == 0)
+            {
+                solarPosition(now, SITES[0].latitude, SITES[0].longitude, sun);
+                tracker.setSunPosition(sun);
+            }
+
+            float sx, sy;
+            sunToServo(sun, actual, sx, sy);
+            light.sunX = sx;
+            light.sunY = sy;
+            bool cloudy = (ms >= 5u * 3600u * 1000u && ms < 6u * 3600u * 1000u);
+            light.base = cloudy ? 300 : 2000;
+            light.gain = cloudy ? 0 : 25;
+
+            // No modo efeméride o tracker só lê os LDRs quando a correção vai rodar
+            light.apply(adc, servoX.angle(), servoY.angle(), LDR_TL, LDR_TR, LDR_BL, LDR_BR);
+            tracker.update();
+            clock.advanceMs(tickMs);
+            travelX.sample(servoX.angle());
+            travelY.sample(servoY.angle());
+
+            // Erro fora das nuvens e depois da primeira meia hora (aquisição)
+            if (!cloudy && ms > 1800u * 1000u)
+            {
+                float err = hypotf(sx - servoX.angle(), sy - servoY.angle());
+                errSum += err;
+                if (err > errMax)
+                    errMax = err;
+                ticks++;
+            }
+        }
+
+        uint32_t now = clock.millis();
+        const ServoActuator &ax = tracker.actuatorX();
+        const ServoActuator &ay = tracker.actuatorY();
+        float activePct = 100.0f * (ax.activeMs(now) + ay.activeMs(now)) / (2.0f * 10 * 3600 * 1000);
+        printf("  %-12s %7.2f/%5.2f deg %6u deg %12u %11.1f%% %12u\n", names[m], errSum / ticks, errMax,
+               travelX.total + travelY.total, ax.writesPerHour(now) + ay.writesPerHour(now), activePct,
+               adc.readCount() - adcReads);
+        if (modes[m] == TRACKER_MODE_EPHEMERIS)
+        {
+            printf("  correção final: X %.1f, Y %.1f graus\n", tracker.getTrimX(), tracker.getTrimY());
+            // A correção fina absorve os 3 graus de montagem e segura o erro abaixo de 1 grau
+            CHECK(errMax < 1.0f);
+            CHECK_NEAR(tracker.getTrimX(), -3.0, 0.5);
+            CHECK_NEAR(tracker.getTrimY(), 0.0, 0.5);
+        }
+    }
+}
+
+void scenarioEphemeris()
+{
+    accuracy();
+    cost();
+    trackingDay();
+}
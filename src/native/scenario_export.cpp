@@ -0,0 +1,233 @@
+/**
+ * @file scenario_export.cpp
+ * @brief Exportação CSV/NDJSON do log: vazão, memória de pico e filtro por hora
+ *
+ * O log tem 16 segmentos cheios (32768 registros, ~3,8 dias a 1 amostra/10 s)
+ * em arquivos do host. O "String" é o que um handler como o de /data faria:
+ * montar a resposta inteira na RAM antes de enviar.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include "LogExportStream.h"
+#include "LogStorageHost.h"
+#include "NativeBench.h"
+#include "NativeCheck.h"
+#include "NativeScenarios.h"
+
+static const char *LOG_DIR = "/log";
+static const char *HOST_ROOT = "/tmp/estacao-export";
+static const uint32_t T0 = 1767225600; // 2026-01-01 00:00 UTC
+static const uint32_t STEP_S = 10;
+static const uint32_t RECORDS = 32768;
+
+// Tamanho típico do pedaço pedido pelo AsyncWebServer (janela TCP livre)
+static const size_t CHUNK = 1436;
+
+static void fillLog(SampleLog &log)
+{
+    for (uint32_t i = 0; i < RECORDS; i++)
+    {
+        BatchRecord s = {};
+        s.stationSec = i * STEP_S;
+        s.temp = 1800 + (int16_t)((i * 7) % 1500) - 300;
+        s.hum = 4000 + (i * 13) % 5000;
+        s.pres = 10050 + (i % 200);
+        s.uv = (i * 3) % 2000;
+        s.lumens = (i * 11) % 60000;
+        s.flags = (i % 1000 == 0) ? BATCH_FLAG_ALARM : BATCH_FLAG_BME_OK;
+        // A primeira hora foi gravada antes de o relógio ser acertado
+        log.append(i < 360 ? 0 : T0 + i * STEP_S, s, i * STEP_S * 1000);
+    }
+    log.flush();
+}
+
+struct ExportResult
+{
+    uint32_t bytes;
+    uint32_t chunks;
+    uint32_t lines;
+    size_t maxChunk;
+    double sec;
+};
+
+static void runExport(SampleLog &log, uint32_t from, uint32_t to, LogExportFormat format, ExportResult &r)
+{
+    static uint8_t buf[CHUNK];
+    memset(&r, 0, sizeof(r));
+    uint64_t start = benchNowNs();
+
+    LogExportStream stream(log, from, to, format);
+    size_t n;
+    while ((n = stream.fill(buf, sizeof(buf))) > 0)
+    {
+        r.bytes += n;
+        r.chunks++;
+        if (n > r.maxChunk)
+            r.maxChunk = n;
+        for (size_t i = 0; i < n; i++)
+            r.lines += buf[i] == '\n';
+    }
+
+    r.sec = (benchNowNs() - start) / 1e9;
+}
+
+static void throughput(SampleLog &log)
+{
+    printf(" Log inteiro (%lu registros), pedaços de %lu bytes\n", (unsigned long)RECORDS, (unsigned long)CHUNK);
+    printf("  %-7s %10s %8s %9s %10s %14s\n", "formato", "bytes", "pedaços", "MB/s", "linhas", "\"String\" (B)");
+    const LogExportFormat formats[] = {LOG_EXPORT_CSV, LOG_EXPORT_NDJSON};
+    const char *names[] = {"csv", "ndjson"};
+    for (int f = 0; f < 2; f++)
+    {
+        ExportResult r;
+        runExport(log, 0, 0xFFFFFFFF, formats[f], r);
+        printf("  %-7s %10lu %8lu %9.1f %10lu %14lu\n", names[f], (unsigned long)r.bytes, (unsigned long)r.chunks,
+               r.bytes / r.sec / 1e6, (unsigned long)r.lines, (unsigned long)r.bytes);
+    }
+    printf("  memória de pico do stream: %lu bytes (objeto) + %lu (pedaço), qualquer que seja o intervalo\n",
+           (unsigned long)sizeof(LogExportStream), (unsigned long)CHUNK);
+}
+
+static void ranges(SampleLog &log)
+{
+    struct Range
+    {
+        const char *name;
+        uint32_t from;
+        uint32_t to;
+        uint32_t expected;
+    };
+    // Registro i tem hora T0 + 10 i (os 360 primeiros, sem hora)
+    const Range RANGES[] = {
+        {"tudo (from=0)", 0, 0xFFFFFFFF, RECORDS},
+        {"1 dia no meio", T0 + 86400, T0 + 2 * 86400 - 1, 8640},
+        {"última hora", T0 + (RECORDS - 360) * STEP_S, 0xFFFFFFFF, 360},
+        {"antes do log", T0 - 86400, T0 - 1, 0},
+    };
+    printf(" Filtro por hora (NDJSON)\n");
+    for (const Range &range : RANGES)
+    {
+        ExportResult r;
+        runExport(log, range.from, range.to, LOG_EXPORT_NDJSON, r);
+        printf("  %-14s %6lu linhas (esperado %6lu) em %7.2f ms\n", range.name, (unsigned long)r.lines,
+               (unsigned long)range.expected, r.sec * 1e3);
+        CHECK_EQ(r.lines, range.expected);
+    }
+}
+
+/**
+ * @brief Exportação inteira concatenada, em pedaços de chunkLen bytes
+ */
+static std::string renderExport(SampleLog &log, uint32_t from, uint32_t to, LogExportFormat format, size_t chunkLen)
+{
+    std::string out;
+    std::string buf(chunkLen, '\0');
+    LogExportStream stream(log, from, to, format);
+    size_t n;
+    while ((n = stream.fill((uint8_t *)&buf[0], chunkLen)) > 0)
+    {
+        // Aqui o maxLen nunca cresce: um item maior que o pedaço travaria a resposta
+        if (n == RESPONSE_TRY_AGAIN)
+        {
+            CHECK(n != RESPONSE_TRY_AGAIN);
+            break;
+        }
+        out.append(buf, 0, n);
+    }
+    return out;
+}
+
+/**
+ * @brief Confere cada linha contra o registro lido direto do log
+ * @return Linhas que não batem (seq, hora ou station_s)
+ */
+static uint32_t compareWithLog(SampleLog &log, const std::string &text, LogExportFormat format, uint32_t &lines)
+{
+    uint32_t mismatches = 0;
+    lines = 0;
+    size_t pos = 0;
+    if (format == LOG_EXPORT_CSV)
+        pos = text.find('\n') + 1; // Cabeçalho
+
+    LogRecord records[64];
+    for (uint32_t seq = log.firstSeq(); seq < log.nextSeq();)
+    {
+        uint16_t count = log.read(seq, records, 64);
+        if (count == 0)
+            break;
+        for (uint16_t i = 0; i < count; i++)
+        {
+            const LogRecord &rec = records[i];
+            char expected[96];
+            if (format == LOG_EXPORT_CSV)
+            {
+                if (rec.unixTime)
+                    snprintf(expected, sizeof(expected), "%lu,%lu,%lu,", (unsigned long)rec.seq,
+                             (unsigned long)rec.unixTime, (unsigned long)rec.sample.stationSec);
+                else
+                    snprintf(expected, sizeof(expected), "%lu,,%lu,", (unsigned long)rec.seq,
+                             (unsigned long)rec.sample.stationSec);
+            }
+            else if (rec.unixTime)
+                snprintf(expected, sizeof(expected), "{\"seq\":%lu,\"time\":%lu,\"st\":%lu,", (unsigned long)rec.seq,
+                         (unsigned long)rec.unixTime, (unsigned long)rec.sample.stationSec);
+            else
+                snprintf(expected, sizeof(expected), "{\"seq\":%lu,\"time\":null,\"st\":%lu,", (unsigned long)rec.seq,
+                         (unsigned long)rec.sample.stationSec);
+
+            size_t end = text.find('\n', pos);
+            if (end == std::string::npos || text.compare(pos, strlen(expected), expected) != 0)
+                mismatches++;
+            if (end == std::string::npos)
+                return mismatches + (log.nextSeq() - rec.seq - 1);
+            pos = end + 1;
+            lines++;
+        }
+        seq += count;
+    }
+    if (pos != text.size())
+        mismatches++; // Linhas a mais na exportação
+    return mismatches;
+}
+
+static void consistency(SampleLog &log)
+{
+    printf(" Pedaços pequenos vs um pedaço só, e cada linha vs leitura direta do log\n");
+    const LogExportFormat formats[] = {LOG_EXPORT_CSV, LOG_EXPORT_NDJSON};
+    const char *names[] = {"csv", "ndjson"};
+    for (int f = 0; f < 2; f++)
+    {
+        std::string whole = renderExport(log, 0, 0xFFFFFFFF, formats[f], 1 << 23);
+        std::string small = renderExport(log, 0, 0xFFFFFFFF, formats[f], 160);
+        uint32_t lines = 0;
+        uint32_t mismatches = compareWithLog(log, whole, formats[f], lines);
+        printf("  %-7s %s (%lu bytes), %lu linhas conferidas, %lu divergentes\n", names[f],
+               whole == small ? "idêntico" : "DIFERENTE", (unsigned long)whole.size(), (unsigned long)lines,
+               (unsigned long)mismatches);
+        CHECK(whole == small);
+        CHECK_EQ(lines, RECORDS);
+        CHECK_EQ(mismatches, 0);
+    }
+}
+
+void scenarioExport()
+{
+    FileLogStorage storage(HOST_ROOT);
+    storage.makeDir(LOG_DIR);
+    storage.list(LOG_DIR, [](const char *name, void *ctx)
+                 {
+                     char path[SAMPLE_LOG_PATH_MAX];
+                     snprintf(path, sizeof(path), "%s/%s", LOG_DIR, name);
+                     ((FileLogStorage *)ctx)->remove(path); },
+                 &storage);
+
+    SampleLog log(storage, LOG_DIR);
+    log.begin();
+    fillLog(log);
+
+    throughput(log);
+    ranges(log);
+    consistency(log);
+}
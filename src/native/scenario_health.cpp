@@ -0,0 +1,162 @@
+/**
+ * @file scenario_health.cpp
+ * @brief Saúde do heap e das pilhas: aviso antecipado, tendência e custo
+ *
+ * Traço sintético de 72 h com uma leitura por minuto: o heap livre vaza
+ * 600 B/h e o maior bloco encolhe mais rápido (fragmentação). Uma alocação
+ * de 6 KB (buffer do AsyncTCP/WebSocket) falha quando o maior bloco fica
+ * abaixo disso; o aviso precisa chegar antes.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "HealthMonitor.h"
+#include "HealthJsonStream.h"
+#include "NativeBench.h"
+#include "NativeCheck.h"
+#include "NativeScenarios.h"
+#include "SimLight.h"
+
+static const char *const TASK_NAMES[] = {"tracker", "sensors", "display", "network", "async_tcp", "loop"};
+static const uint8_t TASKS = sizeof(TASK_NAMES) / sizeof(TASK_NAMES[0]);
+static const uint32_t BIGGEST_ALLOC = 6144;
+static const float LEAK_PER_HOUR = 600.0f;
+
+static HealthReading readingAt(uint32_t minute, SimLight &rng)
+{
+    float hours = minute / 60.0f;
+    HealthReading r = {};
+    r.uptimeSec = minute * 60;
+    // Ruído de +/-2 KB das conexões abrindo e fechando
+    r.freeHeap = (uint32_t)(150000.0f - LEAK_PER_HOUR * hours + rng.jitter() * 2);
+    // Fragmentação: o maior bloco perde ~1.5 KB/h além do vazamento
+    float block = 110000.0f - (LEAK_PER_HOUR + 1500.0f) * hours + rng.jitter();
+    r.largestBlock = block > 0 ? (uint32_t)block : 0;
+    r.minFreeHeap = r.freeHeap - 4000;
+    for (uint8_t i = 0; i < TASKS; i++)
+        r.stackFree[i] = 1600 - 40 * i;
+    // A pilha do async_tcp encosta no limite quando um cliente lento pede /history
+    if (minute == 2000)
+        r.stackFree[4] = 380;
+    return r;
+}
+
+static void earlyWarning()
+{
+    HealthMonitor monitor(TASK_NAMES, TASKS);
+    SimLight rng;
+    rng.noise = 1000;
+    long warnMin = -1, failMin = -1, stackMin = -1;
+    int32_t trendAt24h = 0;
+
+    for (uint32_t minute = 0; minute < 72 * 60; minute++)
+    {
+        HealthReading r = readingAt(minute, rng);
+        bool raised = monitor.record(r);
+        if (raised && warnMin < 0 && (monitor.warnings() & (HEALTH_WARN_LARGEST_BLOCK | HEALTH_WARN_FREE_HEAP)))
+            warnMin = minute;
+        if (raised && stackMin < 0 && (monitor.warnings() & HEALTH_WARN_STACK))
+            stackMin = minute;
+        if (failMin < 0 && r.largestBlock < BIGGEST_ALLOC)
+            failMin = minute;
+        if (minute == 24 * 60)
+            trendAt24h = monitor.snapshot().freeHeapTrendPerHour;
+    }
+
+    printf(" 72 h sintéticas (vazamento de %.0f B/h, maior bloco caindo %.0f B/h)\n", LEAK_PER_HOUR,
+           LEAK_PER_HOUR + 1500.0f);
+    printf("  aviso de heap em %.1f h; primeira falha de malloc de %lu B em %.1f h -> %.1f h de antecedência\n",
+           warnMin / 60.0, (unsigned long)BIGGEST_ALLOC, failMin / 60.0, (failMin - warnMin) / 60.0);
+    printf("  tendência do heap livre em 24 h (médias de %d h): %ld B/h (real -%.0f)\n", HEALTH_TREND_HOURS,
+           (long)trendAt24h, LEAK_PER_HOUR);
+    printf("  pilha do %s abaixo de %u B: aviso em %.1f h; avisos ligados no total: %lu\n", TASK_NAMES[4],
+           (unsigned)HEALTH_DEFAULT_THRESHOLDS.minStackFree, stackMin / 60.0,
+           (unsigned long)monitor.snapshot().warnEvents);
+    printf("  fragmentação na última leitura: %u%%\n", (unsigned)HealthMonitor::fragmentation(monitor.latest()));
+
+    CHECK(warnMin >= 0 && failMin >= 0);
+    CHECK(failMin - warnMin > 0); // O aviso chega antes do primeiro malloc que falha
+    CHECK_NEAR(trendAt24h, -LEAK_PER_HOUR, LEAK_PER_HOUR * 0.1);
+    CHECK_EQ(stackMin, 2000);
+    CHECK(monitor.snapshot().stackWarned == 0); // A pilha voltou: o aviso desligou
+}
+
+/**
+ * @brief /health inteiro, em pedaços de chunkLen bytes
+ * @return Itens que não couberam (RESPONSE_TRY_AGAIN)
+ */
+static uint32_t renderHealth(const HealthSnapshot &snap, size_t chunkLen, char *out, size_t outSize, size_t &total)
+{
+    HealthJsonStream stream(snap);
+    static uint8_t buf[8192];
+    uint32_t retries = 0;
+    total = 0;
+    size_t n;
+    while ((n = stream.fill(buf, chunkLen)) > 0)
+    {
+        if (n == RESPONSE_TRY_AGAIN)
+        {
+            // O AsyncWebServer chama de novo com a janela maior; aqui, o dobro
+            retries++;
+            chunkLen *= 2;
+            continue;
+        }
+        if (total + n <= outSize)
+            memcpy(out + total, buf, n);
+        total += n;
+    }
+    return retries;
+}
+
+static void chunked()
+{
+    HealthMonitor monitor(TASK_NAMES, TASKS);
+    SimLight rng;
+    rng.noise = 1000;
+    for (uint32_t minute = 0; minute < 120; minute++)
+        monitor.record(readingAt(minute, rng));
+
+    static char whole[16384], small[16384];
+    size_t wholeLen, smallLen;
+    uint32_t wholeRetries = renderHealth(monitor.snapshot(), 8192, whole, sizeof(whole), wholeLen);
+    // 64 B: nem o cabeçalho nem uma leitura cabem, a resposta precisa continuar
+    uint32_t smallRetries = renderHealth(monitor.snapshot(), 64, small, sizeof(small), smallLen);
+    printf("  /health em pedaços de 64 B: %lu bytes, %lu TRY_AGAIN, %s pedaço único\n", (unsigned long)smallLen,
+           (unsigned long)smallRetries, smallLen == wholeLen && memcmp(whole, small, wholeLen) == 0 ? "igual ao" : "DIFERENTE do");
+    CHECK_EQ(wholeRetries, 0);
+    CHECK(smallRetries > 0);
+    CHECK(wholeLen < sizeof(whole));
+    CHECK_EQ(smallLen, wholeLen);
+    CHECK(memcmp(whole, small, wholeLen) == 0);
+    CHECK(wholeLen > 2 && whole[0] == '{' && whole[wholeLen - 2] == ']' && whole[wholeLen - 1] == '}');
+}
+
+static void cost()
+{
+    HealthMonitor monitor(TASK_NAMES, TASKS);
+    SimLight rng;
+    rng.noise = 1000;
+    uint32_t minute = 0;
+    printf(" Custo\n");
+    benchRun("HealthMonitor::record (anel cheio)", 100000, [&]()
+             { monitor.record(readingAt(minute++ % 4000, rng)); });
+
+    HealthJsonStream stream(monitor.snapshot());
+    uint8_t buf[1024];
+    size_t total = 0, chunks = 0, n;
+    while ((n = stream.fill(buf, sizeof(buf))) > 0)
+    {
+        total += n;
+        chunks++;
+    }
+    printf("  /health com %d leituras e %u tarefas: %lu bytes em %lu pedaços de até %lu; cópia do anel %lu bytes\n",
+           HEALTH_HISTORY, (unsigned)TASKS, (unsigned long)total, (unsigned long)chunks, (unsigned long)sizeof(buf),
+           (unsigned long)sizeof(HealthSnapshot));
+}
+
+void scenarioHealth()
+{
+    earlyWarning();
+    chunked();
+    cost();
+}
@@ -0,0 +1,161 @@
+/**
+ * @file scenario_lowpower.cpp
+ * @brief Modo de baixo consumo: máquina de estados em 24 h simuladas e energia por dia
+ *
+ * Cada despertar passa pelo mesmo caminho do firmware: restore() ->
+ * amostra -> onSample() -> janela de envio (uploadFinished()) -> sleepMs().
+ * O tempo acordado é modelado (boot + leitura), o resto é sono. Um alarme
+ * de luz cobre a tarde e um segundo alarme curto aparece à noite; quando há
+ * alarme novo alguém abre a página por 90 s.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "DutyCycle.h"
+#include "NativeCheck.h"
+#include "NativeScenarios.h"
+
+static const uint32_t DAY_MS = 24UL * 3600 * 1000;
+
+// Tempos acordado (ms) e correntes na bateria (mA) estimados para o ESP32 DevKit
+static const uint32_t BOOT_MS = 250;      // ROM + bootloader + init do Arduino
+static const uint32_t SAMPLE_MS = 20;     // Wire, BME280 forçado (10 ms), ADC
+static const uint32_t CLIENT_VIEW_MS = 90000;
+static const float WAKE_MA = 40.0f;       // CPU sem rádio
+static const float UPLOAD_MA = 135.0f;    // softAP + OLED + tarefas
+static const float ALWAYS_ON_MA = 145.0f; // Firmware atual: softAP, OLED e servos sempre ligados
+static const float SLEEP_MA_MODULE = 0.05f; // Deep sleep com regulador de baixo Iq
+static const float SLEEP_MA_DEVKIT = 5.0f;  // Deep sleep no DevKit (AMS1117 + CP2102)
+static const float BATTERY_MAH = 3000.0f;
+
+struct DutyRun
+{
+    const char *name;
+    DutyCycleConfig config;
+};
+
+struct DutyResult
+{
+    uint32_t wakes;
+    uint32_t uploads;
+    uint32_t alarmUploads;
+    uint32_t awakeMs;
+    uint32_t uploadMs;
+    uint32_t sleepMs;
+    uint32_t records;
+    uint32_t dropped;
+};
+
+// Alarme de luz das 12 h às 16 h e um alarme curto às 21 h
+static bool alarmAt(uint32_t ms)
+{
+    uint32_t min = ms / 60000;
+    return (min >= 12 * 60 && min < 16 * 60) || (min >= 21 * 60 && min < 21 * 60 + 3);
+}
+
+static void runDay(const DutyCycleConfig &config, DutyResult &result)
+{
+    static SampleBatch rtc; // Memória RTC: zerada só na partida a frio
+    memset(&rtc, 0xA5, sizeof(rtc)); // Lixo de uma perda de energia
+    memset(&result, 0, sizeof(result));
+
+    DutyCycle duty(rtc, config);
+    uint32_t simMs = 0; // Tempo real simulado
+    bool lastAlarm = false;
+
+    while (simMs < DAY_MS)
+    {
+        bool warm = duty.restore();
+        uint32_t awake = BOOT_MS;
+        bool upload = !warm; // Partida a frio: sobe a estação completa
+        bool newAlarm = false;
+
+        if (warm)
+        {
+            awake += SAMPLE_MS;
+            BatchRecord record = {};
+            bool alarm = alarmAt(simMs + awake);
+            newAlarm = alarm && !lastAlarm;
+            lastAlarm = alarm;
+            record.flags = BATCH_FLAG_BME_OK | (alarm ? BATCH_FLAG_ALARM : 0);
+            record.stationSec = duty.stationSec(awake);
+            upload = (duty.onSample(record) == DUTY_UPLOAD);
+            result.records++;
+        }
+        result.wakes++;
+
+        if (upload)
+        {
+            result.uploads++;
+            result.dropped += duty.batch().dropped;
+            if (newAlarm)
+                result.alarmUploads++;
+
+            // Janela de envio em passos de 1 s, como o loop() do firmware
+            uint32_t start = awake;
+            uint32_t lastClient = 0;
+            while (!duty.uploadFinished(awake, lastClient))
+            {
+                awake += 1000;
+                if (newAlarm && awake - start < CLIENT_VIEW_MS)
+                    lastClient = awake;
+            }
+            result.uploadMs += awake - start;
+        }
+
+        uint32_t sleep = duty.sleepMs(awake, upload);
+        result.awakeMs += awake;
+        result.sleepMs += sleep;
+        simMs += awake + sleep;
+    }
+}
+
+static const DutyRun RUNS[] = {
+    {"1 min / 60", DUTY_DEFAULT_CONFIG},
+    {"5 min / 12", {300000, 12, 30000, 300000, 10000, 1000}},
+    {"10 s / 120", {10000, 120, 30000, 300000, 10000, 1000}},
+};
+
+void scenarioLowPower()
+{
+    printf(" 24 h simuladas. Acordado: boot %lu ms + leitura %lu ms a %.0f mA; envio a %.0f mA\n",
+           (unsigned long)BOOT_MS, (unsigned long)SAMPLE_MS, WAKE_MA, UPLOAD_MA);
+    printf(" %-12s %7s %7s %7s %9s %9s %11s %11s %9s\n", "config", "desp.", "envios", "alarme", "acord. s",
+           "envio s", "mAh/d mód.", "mAh/d DevK", "dias mód.");
+
+    float alwaysOn = ALWAYS_ON_MA * 24.0f;
+    for (const DutyRun &run : RUNS)
+    {
+        DutyResult r;
+        runDay(run.config, r);
+
+        float sampleHours = (r.awakeMs - r.uploadMs) / 3600000.0f;
+        float uploadHours = r.uploadMs / 3600000.0f;
+        float sleepHours = r.sleepMs / 3600000.0f;
+        float activeMah = sampleHours * WAKE_MA + uploadHours * UPLOAD_MA;
+        float moduleMah = activeMah + sleepHours * SLEEP_MA_MODULE;
+        float devkitMah = activeMah + sleepHours * SLEEP_MA_DEVKIT;
+
+        printf(" %-12s %7lu %7lu %7lu %9.0f %9.0f %11.1f %11.1f %9.1f\n", run.name, (unsigned long)r.wakes,
+               (unsigned long)r.uploads, (unsigned long)r.alarmUploads, r.awakeMs / 1000.0, r.uploadMs / 1000.0,
+               moduleMah, devkitMah, BATTERY_MAH / moduleMah);
+        printf("   amostras %lu, descartadas %lu\n", (unsigned long)r.records, (unsigned long)r.dropped);
+
+        // RTC com lixo: só o primeiro despertar é partida a frio (sem amostra)
+        CHECK_EQ(r.records, r.wakes - 1);
+        CHECK_EQ(r.dropped, 0);
+        // Cada alarme novo (2 no dia) abre uma janela; fora isso, o lote cheio
+        CHECK_EQ(r.alarmUploads, 2);
+        CHECK(r.uploads >= r.records / run.config.batchSize);
+        CHECK(r.uploads <= r.records / run.config.batchSize + r.alarmUploads + 1);
+        CHECK(r.uploadMs >= r.uploads * run.config.uploadMinMs);
+        // Despertares no ritmo pedido (as janelas de envio tiram alguns)
+        uint32_t nominal = DAY_MS / run.config.sampleIntervalMs;
+        CHECK(r.wakes <= nominal && r.wakes * 100 >= nominal * 95);
+        CHECK(moduleMah * 10 < alwaysOn);
+        if (&run == &RUNS[0])
+            CHECK(BATTERY_MAH / moduleMah > 75); // Configuração padrão: ~80 dias
+    }
+    printf(" Sempre ligado (firmware atual): %.0f mAh/dia, %.1f dias com %.0f mAh\n", alwaysOn,
+           BATTERY_MAH / alwaysOn, BATTERY_MAH);
+}
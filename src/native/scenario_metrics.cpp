@@ -0,0 +1,139 @@
+/**
+ * @file scenario_metrics.cpp
+ * @brief Histogramas de latência e /metrics: precisão dos percentis, custo e saída
+ */
+
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "LatencyHistogram.h"
+#include "MetricsRegistry.h"
+#include "PrometheusStream.h"
+#include "NativeBench.h"
+#include "NativeCheck.h"
+#include "NativeScenarios.h"
+#include "SimLight.h"
+
+/**
+ * @brief Gera o /metrics inteiro em pedaços de chunkLen bytes
+ */
+static std::string renderMetrics(const MetricsRegistry &registry, size_t chunkLen, int &chunks)
+{
+    PrometheusStream stream(registry);
+    std::string out;
+    std::vector<uint8_t> buf(chunkLen);
+    chunks = 0;
+    size_t n;
+    while ((n = stream.fill(buf.data(), buf.size())) > 0)
+    {
+        // O maxLen não cresce aqui: uma linha maior que o pedaço travaria a resposta
+        if (n == RESPONSE_TRY_AGAIN)
+        {
+            CHECK(n != RESPONSE_TRY_AGAIN);
+            break;
+        }
+        CHECK(n <= chunkLen);
+        out.append((const char *)buf.data(), n);
+        chunks++;
+    }
+    return out;
+}
+
+void scenarioMetrics()
+{
+    // Latências sintéticas: tracker ~300 us com cauda rara de 4 ms
+    SimLight rng;
+    rng.noise = 1000;
+    std::vector<uint32_t> samples;
+    LatencyHistogram exec, late;
+    for (int i = 0; i < 20000; i++)
+    {
+        uint32_t us = 300 + rng.jitter() / 10 + ((i % 250 == 0) ? 4000 : 0);
+        samples.push_back(us);
+        exec.record(us);
+        late.record((uint32_t)(rng.jitter() + 1000) / 4);
+    }
+    std::sort(samples.begin(), samples.end());
+
+    printf(" Percentis estimados (baldes em potência de 2) vs exatos\n");
+    const uint16_t q[] = {500, 990, 999};
+    for (uint16_t pm : q)
+    {
+        uint32_t exact = samples[(samples.size() * pm + 999) / 1000 - 1];
+        uint32_t estimate = exec.percentileUs(pm);
+        double rel = fabs((double)estimate - exact) / exact;
+        printf("  p%-5.1f estimado %6u us   exato %6u us   erro %4.1f%%\n", pm / 10.0, estimate, exact, rel * 100);
+
+        // Garantia da estrutura: a estimativa cai no mesmo balde (2^(i-1), 2^i] do valor exato
+        CHECK(estimate <= exact * 2 && exact <= estimate * 2);
+        // Nesta distribuição: ~11% no p50 e ~28% no p99 (a cauda ocupa o balde 256-512 us)
+        if (pm <= 990)
+            CHECK(rel < 0.30);
+    }
+    printf("  max    %6u us (exato)\n", exec.maxUs());
+    CHECK_EQ(exec.maxUs(), samples.back());
+
+    printf(" Custo\n");
+    LatencyHistogram h;
+    uint32_t v = 1;
+    benchRun("LatencyHistogram::record", 1000000, [&]()
+             { h.record(v = v * 1664525u + 1013904223u); });
+    benchRun("LatencyHistogram::percentileUs(990)", 200000, [&]()
+             { benchKeep(exec.percentileUs(990)); });
+
+    // Tabela como a do firmware: 4 tarefas, 8 rotas, 1 contador extra
+    static const char *TASKS[] = {"tracker", "sensors", "display", "network"};
+    static const char *ROUTES[] = {"/", "/data", "/history", "/history:chunk", "/time", "/reset", "/metrics", "/ws"};
+    static LatencyHistogram taskExec[4], taskLate[4], routes[8];
+    static volatile uint32_t overruns[4] = {0, 1, 0, 3};
+    for (int i = 0; i < 4; i++)
+    {
+        taskExec[i] = exec;
+        taskLate[i] = late;
+    }
+    for (int i = 0; i < 8; i++)
+        routes[i] = late;
+
+    MetricsRegistry registry;
+    int fExec = registry.addFamily("station_task_exec", "Duração de cada execução da tarefa", "task", METRIC_HISTOGRAM);
+    int fLate = registry.addFamily("station_task_lateness", "Atraso do início em relação ao período nominal", "task", METRIC_HISTOGRAM);
+    int fOver = registry.addFamily("station_task_overruns", "Execuções que passaram do próximo disparo", "task", METRIC_COUNTER);
+    int fHttp = registry.addFamily("station_http_handler", "Tempo dos handlers HTTP/WebSocket", "route", METRIC_HISTOGRAM);
+    for (int i = 0; i < 4; i++)
+    {
+        registry.addHistogram(fExec, TASKS[i], taskExec[i]);
+        registry.addHistogram(fLate, TASKS[i], taskLate[i]);
+        registry.addCounter(fOver, TASKS[i], overruns[i]);
+    }
+    for (int i = 0; i < 8; i++)
+        registry.addHistogram(fHttp, ROUTES[i], routes[i]);
+
+    int chunksFull, chunksSmall;
+    std::string full = renderMetrics(registry, 1 << 20, chunksFull);
+    std::string chunked = renderMetrics(registry, 512, chunksSmall);
+    size_t lines = std::count(full.begin(), full.end(), '\n');
+
+    printf(" /metrics\n");
+    printf("  %zu bytes, %zu linhas (%d pedaço); em pedaços de 512 B: %d pedaços, %s\n", full.size(), lines, chunksFull, chunksSmall,
+           full == chunked ? "idêntico" : "DIFERENTE");
+    CHECK(full == chunked);
+    CHECK(chunksSmall > 1);
+    benchRun("PrometheusStream (resposta inteira, 1460 B)", 2000, [&]()
+             {
+                 PrometheusStream stream(registry);
+                 uint8_t buf[1460];
+                 while (stream.fill(buf, sizeof(buf)) > 0)
+                     benchKeep(buf[0]); });
+
+    // Trecho da saída: cabeçalho e os quantis do tracker
+    size_t header = full.find("# HELP station_task_exec_seconds");
+    printf("%.*s", (int)(full.find('\n', full.find('\n', header) + 1) - header + 1), full.c_str() + header);
+    size_t quant = full.find("station_task_exec_quantile_seconds{task=\"tracker\"");
+    size_t end = quant;
+    for (int i = 0; i < 3; i++)
+        end = full.find('\n', end) + 1;
+    printf("%.*s", (int)(end - quant), full.c_str() + quant);
+}
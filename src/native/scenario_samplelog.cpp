@@ -0,0 +1,230 @@
+/**
+ * @file scenario_samplelog.cpp
+ * @brief Log de amostras em flash: recuperação, queda de energia e desempenho
+ *
+ * A parte funcional usa o RamLogStorage (queda de energia injetada); o
+ * desempenho usa o FileLogStorage, com arquivos de verdade em /tmp.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "SampleLog.h"
+#include "LogStorageHost.h"
+#include "NativeBench.h"
+#include "NativeCheck.h"
+#include "NativeScenarios.h"
+
+static const char *LOG_DIR = "/log";
+static const char *HOST_ROOT = "/tmp/estacao-samplelog";
+
+static BatchRecord makeSample(uint32_t i)
+{
+    BatchRecord s = {};
+    s.stationSec = i * 10;
+    s.temp = 2000 + (i % 500);
+    s.hum = 6000;
+    s.pres = 10130;
+    s.flags = BATCH_FLAG_BME_OK;
+    return s;
+}
+
+// Confere que todos os registros de first a end-1 são lidos em ordem
+static bool verifyAll(SampleLog &log, uint32_t first, uint32_t end)
+{
+    LogRecord buf[64];
+    uint32_t seq = first;
+    while (seq < end)
+    {
+        uint16_t n = log.read(seq, buf, 64);
+        if (n == 0)
+            return false;
+        for (uint16_t k = 0; k < n; k++)
+            if (buf[k].seq != seq + k || buf[k].sample.stationSec != (seq + k) * 10)
+                return false;
+        seq += n;
+    }
+    return true;
+}
+
+static void recovery()
+{
+    static RamLogStorage storage;
+    const SampleLogConfig config = {32, 300000, 256, 4};
+    uint32_t now = 0;
+    uint32_t persisted;
+
+    printf(" Recuperação (segmentos de 256, 4 guardados, lote 32)\n");
+    {
+        SampleLog log(storage, LOG_DIR, config);
+        log.begin();
+        for (uint32_t i = 0; i < 2000; i++)
+            log.append(0, makeSample(i), now += 10000);
+        printf("  2000 amostras: %lu escritas, %u segmentos, do seq %lu ao %lu, %u pendentes na RAM\n",
+               (unsigned long)log.flushes(), (unsigned)log.segments(), (unsigned long)log.firstSeq(),
+               (unsigned long)log.nextSeq() - 1, (unsigned)log.pending());
+        persisted = log.persistedSeq();
+    }
+
+    // Reboot (o lote em RAM se perde); depois uma queda no meio de uma escrita
+    uint32_t reads = storage.reads(), lists = storage.lists();
+    {
+        SampleLog log(storage, LOG_DIR, config);
+        log.begin();
+        reads = storage.reads() - reads;
+        lists = storage.lists() - lists;
+        bool intact = verifyAll(log, log.firstSeq(), log.nextSeq());
+        printf("  boot: retoma no seq %lu com %lu leitura(s) de registro e %lu listagem(ns); íntegro: %s\n",
+               (unsigned long)log.nextSeq(), (unsigned long)reads, (unsigned long)lists, intact ? "sim" : "NÃO");
+        CHECK_EQ(log.nextSeq(), persisted); // Só o lote em RAM se perdeu
+        CHECK_EQ(reads, 1);
+        CHECK(intact);
+
+        // A energia cai no meio da próxima escrita: só 3 registros e meio chegam à flash
+        storage.cutNextAppend(100);
+        for (uint32_t i = log.nextSeq(); log.append(0, makeSample(i), now += 10000); i++)
+            ;
+        printf("  queda no meio da escrita do seq %lu ao %lu\n", (unsigned long)log.persistedSeq(),
+               (unsigned long)log.nextSeq() - 1);
+        persisted = log.persistedSeq();
+    }
+
+    {
+        SampleLog log(storage, LOG_DIR, config);
+        log.begin();
+        uint32_t resume = log.nextSeq();
+        printf("  reboot: retoma no seq %lu, %lu registro(s) descartado(s), %lu leitura(s)\n",
+               (unsigned long)resume, (unsigned long)log.recoveredTorn(), (unsigned long)log.recoveryReads());
+        CHECK_EQ(resume, persisted + 100 / sizeof(LogRecord)); // Os registros inteiros ficam
+        CHECK_EQ(log.recoveredTorn(), 1);
+
+        // Volta a escrever: o segmento rasgado não recebe mais nada
+        for (uint32_t i = resume; i < resume + 100; i++)
+            log.append(0, makeSample(i), now += 10000);
+        log.flush();
+        bool intact = verifyAll(log, log.firstSeq(), log.nextSeq());
+        printf("  depois de mais 100 amostras: %u segmentos, leitura contínua do seq %lu ao %lu: %s\n",
+               (unsigned)log.segments(), (unsigned long)log.firstSeq(), (unsigned long)log.nextSeq() - 1,
+               intact ? "ok" : "FALHOU");
+        CHECK(intact);
+        CHECK_EQ(log.nextSeq(), resume + 100);
+    }
+
+    // Último registro com um bit trocado
+    {
+        SampleLog log(storage, LOG_DIR, config);
+        log.begin();
+        uint32_t before = log.nextSeq();
+
+        // Nomes com 8 dígitos hex: o maior em ordem alfabética é o segmento mais novo
+        char newest[16] = "";
+        storage.list(LOG_DIR, [](const char *name, void *ctx)
+                     {
+                         if (strcmp(name, (char *)ctx) > 0)
+                             strcpy((char *)ctx, name); },
+                     newest);
+        char path[SAMPLE_LOG_PATH_MAX];
+        snprintf(path, sizeof(path), "%s/%s", LOG_DIR, newest);
+        uint32_t newestStart = strtoul(newest, nullptr, 16);
+        storage.corrupt(path, (before - 1 - newestStart) * sizeof(LogRecord) + 9);
+
+        log.begin();
+        printf("  bit trocado no último registro: retoma no seq %lu (era %lu)\n", (unsigned long)log.nextSeq(),
+               (unsigned long)before);
+        CHECK_EQ(log.nextSeq(), before - 1);
+        CHECK(verifyAll(log, log.firstSeq(), log.nextSeq()));
+    }
+}
+
+static void wear()
+{
+    // Uma amostra a cada 10 s, por 24 h
+    static RamLogStorage batched, single;
+    SampleLog a(batched, LOG_DIR, SAMPLE_LOG_DEFAULT_CONFIG);
+    SampleLogConfig unbatched = SAMPLE_LOG_DEFAULT_CONFIG;
+    unbatched.batchRecords = 1;
+    SampleLog b(single, LOG_DIR, unbatched);
+    a.begin();
+    b.begin();
+    uint32_t now = 0;
+    for (uint32_t i = 0; i < 8640; i++)
+    {
+        now += 10000;
+        a.append(0, makeSample(i), now);
+        b.append(0, makeSample(i), now);
+    }
+    printf(" Escritas na flash em 24 h (1 amostra/10 s, %lu bytes/registro): em lote %lu, uma por amostra %lu\n",
+           (unsigned long)sizeof(LogRecord), (unsigned long)batched.appends(), (unsigned long)single.appends());
+    CHECK_EQ(single.appends(), 8640);
+    CHECK(batched.appends() <= 8640 / 32 + 24 * 3600 / 300); // Lote cheio ou velho (5 min)
+}
+
+static void clearHostDir(FileLogStorage &storage)
+{
+    struct Ctx
+    {
+        FileLogStorage *storage;
+    } ctx = {&storage};
+    storage.makeDir(LOG_DIR);
+    storage.list(LOG_DIR, [](const char *name, void *c)
+                 {
+                     char path[SAMPLE_LOG_PATH_MAX];
+                     snprintf(path, sizeof(path), "%s/%s", LOG_DIR, name);
+                     ((Ctx *)c)->storage->remove(path); },
+                 &ctx);
+}
+
+static void throughput(uint16_t batch)
+{
+    FileLogStorage storage(HOST_ROOT);
+    clearHostDir(storage);
+    SampleLogConfig config = SAMPLE_LOG_DEFAULT_CONFIG;
+    config.batchRecords = batch;
+    SampleLog log(storage, LOG_DIR, config);
+    log.begin();
+
+    const uint32_t N = 32768; // 16 segmentos cheios
+    uint64_t start = benchNowNs();
+    for (uint32_t i = 0; i < N; i++)
+        log.append(1700000000 + i * 10, makeSample(i), i * 10000);
+    log.flush();
+    double sec = (benchNowNs() - start) / 1e9;
+    printf("  lote %2u: %8.0f registros/s, %6.2f MB/s, %lu escritas\n", (unsigned)batch, N / sec,
+           log.bytesWritten() / sec / 1e6, (unsigned long)log.flushes());
+}
+
+static void hostPerformance()
+{
+    printf(" Desempenho em arquivos do host (%s)\n", HOST_ROOT);
+    throughput(1);
+    throughput(32);
+
+    // Log cheio (do throughput acima): recuperação vs varredura completa
+    FileLogStorage storage(HOST_ROOT);
+    SampleLog log(storage, LOG_DIR);
+    uint64_t start = benchNowNs();
+    log.begin();
+    double bootUs = (benchNowNs() - start) / 1e3;
+
+    LogRecord buf[64];
+    uint32_t valid = 0;
+    start = benchNowNs();
+    for (uint32_t seq = log.firstSeq(); seq < log.nextSeq();)
+    {
+        uint16_t n = log.read(seq, buf, 64);
+        if (n == 0)
+            break;
+        valid += n;
+        seq += n;
+    }
+    double scanUs = (benchNowNs() - start) / 1e3;
+    printf("  boot com %u segmentos (%lu registros): %.0f us, %lu leitura(s); varredura completa com CRC: %.0f us\n",
+           (unsigned)log.segments(), (unsigned long)valid, bootUs, (unsigned long)log.recoveryReads(), scanUs);
+}
+
+void scenarioSampleLog()
+{
+    recovery();
+    wear();
+    hostPerformance();
+}
@@ -0,0 +1,248 @@
+/**
+ * @file scenario_sampling.cpp
+ * @brief Amostragem adaptativa do BME280 contra leitura fixa a cada 1 s
+ *
+ * Reproduz 12 h de traços sintéticos no formato do que o BME280 entrega
+ * (ruído e resolução do modo x1): ciclo diário, uma frente fria às 4 h
+ * (-5 °C e +20 % de umidade em 15 min) e uma queda de 3 hPa em 2 h a partir
+ * das 3 h. O grupo T/P/H é agendado como no taskSensorsAndAlarm: dispara a
+ * conversão quando qualquer canal vence e lê no passo seguinte.
+ *
+ * O atraso de detecção é medido no nível de cada evento; a segunda rodada
+ * adaptativa vigia esse nível como vigiaria o limiar de uma regra de alarme.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include "AdaptiveSampling.h"
+#include "NativeCheck.h"
+#include "NativeScenarios.h"
+
+static const uint32_t TICK_MS = 250;
+static const uint32_t FIXED_PERIOD_MS = 1000;
+static const uint32_t RUN_MS = 12UL * 3600 * 1000;
+static const float PI_F = 3.14159265f;
+
+// Mesmas políticas do firmware (src/examples/main/main.cpp)
+static const SamplingPolicy TEMP_POLICY = {TICK_MS, 5000, 0.1f};
+static const SamplingPolicy HUM_POLICY = {TICK_MS, 5000, 0.5f};
+static const SamplingPolicy PRES_POLICY = {TICK_MS, 10000, 0.1f};
+
+enum
+{
+    TEMP = 0,
+    HUM,
+    PRES,
+    CHANNELS
+};
+static const char *const NAMES[CHANNELS] = {"temperatura", "umidade", "pressão"};
+static const char *const UNITS[CHANNELS] = {"°C", "%", "hPa"};
+
+// Eventos: o canal cruza (valor antes do evento + delta) depois de startMs
+struct TraceEvent
+{
+    uint32_t startMs;
+    float delta;
+};
+static const TraceEvent EVENTS[CHANNELS] = {{4 * 3600000UL, -1.0f}, {4 * 3600000UL, 5.0f}, {3 * 3600000UL, -1.0f}};
+
+// Transição suave de 0 a 1 entre start e start + length
+static float ramp(float t, float start, float length)
+{
+    float x = (t - start) / length;
+    if (x <= 0)
+        return 0;
+    if (x >= 1)
+        return 1;
+    return x * x * (3 - 2 * x);
+}
+
+static void truth(uint32_t ms, float out[CHANNELS])
+{
+    float h = ms / 3600000.0f;
+    float front = ramp(h, 4.0f, 0.25f);
+    out[TEMP] = 22.0f + 4.0f * sinf(2 * PI_F * (h - 2.0f) / 24.0f) - 5.0f * front;
+    out[HUM] = 60.0f - 8.0f * sinf(2 * PI_F * (h - 2.0f) / 24.0f) + 20.0f * front;
+    out[PRES] = 1013.0f + 0.5f * sinf(2 * PI_F * h / 12.0f) - 3.0f * ramp(h, 3.0f, 2.0f);
+}
+
+/**
+ * @brief Leitura simulada: verdade + ruído, na resolução do sensor
+ */
+struct SimBme
+{
+    uint32_t seed = 2024;
+
+    float noise(float amplitude)
+    {
+        seed = seed * 1103515245u + 12345u;
+        return ((int)((seed >> 16) % 2001) - 1000) * amplitude / 1000.0f;
+    }
+
+    void read(uint32_t ms, float out[CHANNELS])
+    {
+        truth(ms, out);
+        out[TEMP] = roundf((out[TEMP] + noise(0.02f)) * 100) / 100;
+        out[HUM] = roundf((out[HUM] + noise(0.1f)) * 1024) / 1024;
+        out[PRES] = roundf((out[PRES] + noise(0.03f)) * 100) / 100;
+    }
+};
+
+struct SamplingStats
+{
+    uint32_t reads;
+    float maxErr[CHANNELS];
+    double sumErr[CHANNELS];
+    uint32_t errCount;
+    long detectMs[CHANNELS]; // -1 = não detectou
+};
+
+/**
+ * @brief Compara o valor mantido com a verdade e marca a detecção do evento
+ */
+static void track(SamplingStats &stats, uint32_t now, const float held[CHANNELS], const float real[CHANNELS],
+                  const float eventLevel[CHANNELS], long truthCrossMs[CHANNELS])
+{
+    for (int c = 0; c < CHANNELS; c++)
+    {
+        float err = fabsf(held[c] - real[c]);
+        if (err > stats.maxErr[c])
+            stats.maxErr[c] = err;
+        stats.sumErr[c] += err;
+
+        if (now < EVENTS[c].startMs)
+            continue;
+        bool down = EVENTS[c].delta < 0;
+        bool realCross = down ? real[c] <= eventLevel[c] : real[c] >= eventLevel[c];
+        bool heldCross = down ? held[c] <= eventLevel[c] : held[c] >= eventLevel[c];
+        if (truthCrossMs[c] < 0 && realCross)
+            truthCrossMs[c] = now;
+        if (stats.detectMs[c] < 0 && heldCross && truthCrossMs[c] >= 0)
+            stats.detectMs[c] = now - truthCrossMs[c];
+    }
+    stats.errCount++;
+}
+
+static void initStats(SamplingStats &stats)
+{
+    stats = SamplingStats();
+    for (int c = 0; c < CHANNELS; c++)
+        stats.detectMs[c] = -1;
+}
+
+static void runFixed(SamplingStats &stats, const float eventLevel[CHANNELS])
+{
+    initStats(stats);
+    SimBme bme;
+    float held[CHANNELS], real[CHANNELS];
+    long truthCrossMs[CHANNELS] = {-1, -1, -1};
+    uint32_t lastRead = 0;
+    bme.read(0, held);
+    stats.reads++;
+
+    for (uint32_t now = TICK_MS; now <= RUN_MS; now += TICK_MS)
+    {
+        if (now - lastRead >= FIXED_PERIOD_MS)
+        {
+            bme.read(now, held);
+            stats.reads++;
+            lastRead = now;
+        }
+        truth(now, real);
+        track(stats, now, held, real, eventLevel, truthCrossMs);
+    }
+}
+
+static void runAdaptive(SamplingStats &stats, const float eventLevel[CHANNELS], bool watch)
+{
+    initStats(stats);
+    SimBme bme;
+    AdaptiveChannel channels[CHANNELS] = {AdaptiveChannel(TEMP_POLICY), AdaptiveChannel(HUM_POLICY),
+                                          AdaptiveChannel(PRES_POLICY)};
+    if (watch)
+        for (int c = 0; c < CHANNELS; c++)
+            channels[c].setWatch(&eventLevel[c], 1);
+    float held[CHANNELS] = {0, 0, 0}, real[CHANNELS], reading[CHANNELS];
+    long truthCrossMs[CHANNELS] = {-1, -1, -1};
+    bool pending = false;
+    uint32_t triggerMs = 0;
+
+    for (uint32_t now = 0; now <= RUN_MS; now += TICK_MS)
+    {
+        if (!pending)
+        {
+            if (channels[TEMP].due(now) || channels[HUM].due(now) || channels[PRES].due(now))
+            {
+                pending = true;
+                triggerMs = now; // A conversão mede o instante do disparo
+            }
+        }
+        else
+        {
+            pending = false;
+            bme.read(triggerMs, reading);
+            stats.reads++;
+            for (int c = 0; c < CHANNELS; c++)
+            {
+                channels[c].update(now, reading[c]);
+                held[c] = reading[c];
+            }
+        }
+
+        if (now == 0)
+            continue;
+        truth(now, real);
+        track(stats, now, held, real, eventLevel, truthCrossMs);
+    }
+}
+
+void scenarioSampling()
+{
+    // Nível de cada evento a partir da verdade logo antes dele
+    float eventLevel[CHANNELS];
+    for (int c = 0; c < CHANNELS; c++)
+    {
+        float before[CHANNELS];
+        truth(EVENTS[c].startMs, before);
+        eventLevel[c] = before[c] + EVENTS[c].delta;
+    }
+
+    SamplingStats fixed, adaptive, watched;
+    runFixed(fixed, eventLevel);
+    runAdaptive(adaptive, eventLevel, false);
+    runAdaptive(watched, eventLevel, true);
+
+    printf(" 12 h simuladas, passo %lu ms\n", (unsigned long)TICK_MS);
+    printf(" Leituras I2C do BME280: fixo 1 s %lu | adaptativo %lu (%.1f%%) | vigiando o nível %lu (%.1f%%)\n",
+           (unsigned long)fixed.reads, (unsigned long)adaptive.reads, 100.0 * adaptive.reads / fixed.reads,
+           (unsigned long)watched.reads, 100.0 * watched.reads / fixed.reads);
+    printf(" %-12s %-5s %18s %18s %26s\n", "canal", "unid", "erro máx fixo/adap", "erro médio f/a",
+           "atraso evento f/a/vigiado");
+    for (int c = 0; c < CHANNELS; c++)
+    {
+        printf(" %-12s %-5s %8.3f / %7.3f %8.3f / %7.3f %7.2f s / %5.2f s / %5.2f s\n", NAMES[c], UNITS[c],
+               fixed.maxErr[c], adaptive.maxErr[c], fixed.sumErr[c] / fixed.errCount,
+               adaptive.sumErr[c] / adaptive.errCount, fixed.detectMs[c] / 1000.0, adaptive.detectMs[c] / 1000.0,
+               watched.detectMs[c] / 1000.0);
+
+        // Ler menos não pode custar atraso: eventos vistos no máximo quando o fixo de 1 s os vê
+        CHECK(fixed.detectMs[c] >= 0);
+        CHECK(adaptive.detectMs[c] >= 0 && adaptive.detectMs[c] <= fixed.detectMs[c]);
+        CHECK(watched.detectMs[c] >= 0 && watched.detectMs[c] <= fixed.detectMs[c]);
+    }
+    CHECK(adaptive.reads < fixed.reads / 4);
+    CHECK(watched.reads < fixed.reads / 2);
+
+    // Canal parado no período máximo volta ao mínimo ao chegar perto de um limiar vigiado
+    AdaptiveChannel channel(TEMP_POLICY);
+    const float level = 40.0f;
+    channel.setWatch(&level, 1);
+    uint32_t now = 0;
+    for (int i = 0; i < 20; i++, now += channel.periodMs())
+        channel.update(now, 39.5f);
+    CHECK_EQ(channel.periodMs(), TEMP_POLICY.maxPeriodMs);
+    channel.update(now, 39.95f);
+    CHECK_EQ(channel.periodMs(), TEMP_POLICY.minPeriodMs);
+    printf(" Limiar vigiado em 40 °C: parado em 39.5 °C lê a cada %lu ms, em 39.95 °C a cada %lu ms\n",
+           (unsigned long)TEMP_POLICY.maxPeriodMs, (unsigned long)channel.periodMs());
+}
@@ -0,0 +1,118 @@
+/**
+ * @file scenario_station.cpp
+ * @brief Estação completa em tempo simulado, com os mesmos componentes do firmware
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include "Hal.h"
+#include "HalFake.h"
+#include "AnalogAcquisition.h"
+#include "GYML8511.h"
+#include "AnalogCalibration.h"
+#include "SensorCurves.h"
+#include "SunTracker.h"
+#include "HistoryStore.h"
+#include "SeqLock.h"
+#include "StationSample.h"
+#include "StationJson.h"
+#include "NativeScenarios.h"
+#include "SimLight.h"
+
+// Mesmos pinos do firmware principal
+enum
+{
+    PIN_UV_IN = 32,
+    LDR_TL = 34,
+    LDR_TR = 39,
+    LDR_BL = 35,
+    LDR_BR = 36
+};
+
+static HistoryStore history;
+
+void scenarioStation()
+{
+    static FakeClock clock;
+    static FakeGpio gpio;
+    static FakeAdcSource adc;
+    FakeServo servoX, servoY;
+    Hal::install(&clock, &gpio, &adc, nullptr);
+
+    const uint8_t pins[] = {LDR_TL, LDR_TR, LDR_BL, LDR_BR, PIN_UV_IN};
+    AnalogAcquisition acquisition(adc, pins, 5);
+    AdcCalibration adcCal; // Curva típica (no host não há eFuse)
+    GYML8511 uvSensor(adc, PIN_UV_IN, 3.3);
+    uvSensor.setCalibration(adcCal);
+    SunTracker tracker(LDR_TL, LDR_TR, LDR_BL, LDR_BR, 26, 27, servoX, servoY);
+    tracker.begin();
+
+    SeqLock<StationSample> sampleBus;
+    SimLight light;
+    adc.setValue(PIN_UV_IN, 1800); // ~1.45 V -> ~3.8 mW/cm^2
+
+    const uint32_t durationMs = 10 * 60 * 1000;
+    const uint32_t tickMs = 50;
+    double errSum = 0;
+    float errMax = 0;
+    uint32_t ticks = 0, seq = 0;
+    char json[STATION_JSON_MAX];
+
+    for (uint32_t t = 0; t < durationMs; t += tickMs)
+    {
+        // Sol percorre 60 graus em X e 20 em Y durante a simulação
+        light.sunX = 60 + 60.0f * t / durationMs;
+        light.sunY = 80 + 20.0f * t / durationMs;
+        light.apply(adc, servoX.angle(), servoY.angle(), LDR_TL, LDR_TR, LDR_BL, LDR_BR);
+
+        // taskTracker()
+        const AnalogSnapshot &snap = acquisition.scan(clock.millis());
+        uvSensor.pushSample(snap.raw[4]);
+        tracker.update(snap.raw[0], snap.raw[1], snap.raw[2], snap.raw[3]);
+
+        float err = hypotf(light.sunX - servoX.angle(), light.sunY - servoY.angle());
+        if (t > 60000) // ignora o primeiro minuto (aquisição do alvo)
+        {
+            errSum += err;
+            if (err > errMax)
+                errMax = err;
+            ticks++;
+        }
+
+        // taskSensorsAndAlarm()
+        if (t % 1000 == 0)
+        {
+            StationSample sample = {};
+            sample.timestampMs = clock.millis();
+            sample.temp = 25.0f + 0.001f * (t / 1000);
+            sample.hum = 60.0f;
+            sample.pres = 1013.2f;
+            sample.uv = uvSensor.getUVIntensity();
+            int32_t luxSum = 0;
+            for (uint8_t ch = 0; ch < 4; ch++)
+                luxSum += calInterpolate(LDR_LUX_CURVE, adcCal.rawToMv(snap.raw[ch]));
+            sample.lumens = luxSum / 4;
+            sample.bmeOk = 1;
+            sample.seq = ++seq;
+            sampleBus.write(sample);
+
+            const float values[HIST_CHANNELS] = {sample.temp, sample.hum, sample.pres, sample.uv, (float)sample.lumens};
+            history.add(sample.timestampMs / 1000, values);
+        }
+
+        clock.advanceMs(tickMs);
+    }
+
+    uint32_t first, last;
+    history.range(HIST_RES_MINUTE, first, last);
+    stationSampleToJson(sampleBus.read(), json, sizeof(json));
+
+    printf("  Tempo simulado:        %u s (%u ciclos do tracker)\n", durationMs / 1000, durationMs / tickMs);
+    printf("  Erro de apontamento:   médio %.2f graus, máximo %.2f graus\n", errSum / ticks, errMax);
+    uint32_t now = clock.millis();
+    printf("  Servos:                %u + %u escritas, PWM ativo %u + %u ms\n", servoX.writeCount(), servoY.writeCount(),
+           tracker.actuatorX().activeMs(now), tracker.actuatorY().activeMs(now));
+    printf("  Leituras ADC:          %u (%.1f por ciclo)\n", adc.readCount(), (float)adc.readCount() / (durationMs / tickMs));
+    printf("  Histórico (minutos):   slots %u..%u\n", first, last);
+    printf("  Última amostra:        %s\n", json);
+}
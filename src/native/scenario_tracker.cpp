@@ -0,0 +1,182 @@
+/**
+ * @file scenario_tracker.cpp
+ * @brief Compara as leis de controle do SunTracker com a luz simulada
+ *
+ * Fase 1 (degrau): o painel parte de 90/90 e o sol está em 170/40.
+ * Fase 2 (seguimento): o sol anda 0.5 grau/s em X, com ruído nos LDRs.
+ * Despertar: o painel dormiu apontado para o sol e o setup religa o tracker.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include "Hal.h"
+#include "HalFake.h"
+#include "NativeCheck.h"
+#include "SunTracker.h"
+#include "NativeScenarios.h"
+#include "SimLight.h"
+
+enum
+{
+    LDR_TL = 34,
+    LDR_TR = 39,
+    LDR_BL = 35,
+    LDR_BR = 36
+};
+
+static const uint32_t TICK_MS = 50;
+static const float STEP_X = 170, STEP_Y = 40;
+static const float SETTLED_DEG = 1.5f;
+
+struct TrackerRun
+{
+    const char *name;
+    TrackerMode mode;
+    PidGains gains;
+};
+
+static void runMode(const TrackerRun &run)
+{
+    static FakeClock clock;
+    static FakeGpio gpio;
+    static FakeAdcSource adc;
+    FakeServo servoX, servoY;
+    Hal::install(&clock, &gpio, &adc, nullptr);
+
+    SunTracker tracker(LDR_TL, LDR_TR, LDR_BL, LDR_BR, 26, 27, servoX, servoY);
+    tracker.begin();
+    tracker.setTolerance(50);
+    tracker.setMode(run.mode);
+    tracker.setGains(TRACKER_AXIS_X, run.gains);
+    tracker.setGains(TRACKER_AXIS_Y, run.gains);
+
+    SimLight light;
+    light.sunX = STEP_X;
+    light.sunY = STEP_Y;
+
+    TravelMeter travelX, travelY;
+    travelX.start(servoX.angle());
+    travelY.start(servoY.angle());
+
+    // Fase 1: degrau
+    const uint32_t stepMs = 15000;
+    uint32_t settledAt = 0;
+    float overshootX = 0, overshootY = 0;
+    for (uint32_t t = 0; t < stepMs; t += TICK_MS)
+    {
+        light.apply(adc, servoX.angle(), servoY.angle(), LDR_TL, LDR_TR, LDR_BL, LDR_BR);
+        tracker.update();
+        clock.advanceMs(TICK_MS);
+        travelX.sample(servoX.angle());
+        travelY.sample(servoY.angle());
+
+        // Ultrapassagem no sentido do movimento (X sobe, Y desce)
+        float ox = servoX.angle() - STEP_X;
+        float oy = STEP_Y - servoY.angle();
+        if (ox > overshootX)
+            overshootX = ox;
+        if (oy > overshootY)
+            overshootY = oy;
+
+        float err = hypotf(STEP_X - servoX.angle(), STEP_Y - servoY.angle());
+        if (err > SETTLED_DEG)
+            settledAt = t + TICK_MS;
+    }
+    uint32_t stepTravel = travelX.total + travelY.total;
+
+    // Fase 2: seguimento com o sol em movimento
+    const uint32_t trackMs = 60000;
+    double errSum = 0;
+    float errMax = 0;
+    uint32_t ticks = 0;
+    travelX.start(servoX.angle());
+    travelY.start(servoY.angle());
+    for (uint32_t t = 0; t < trackMs; t += TICK_MS)
+    {
+        light.sunX = STEP_X - 0.5f * t / 1000.0f;
+        light.apply(adc, servoX.angle(), servoY.angle(), LDR_TL, LDR_TR, LDR_BL, LDR_BR);
+        tracker.update();
+        clock.advanceMs(TICK_MS);
+        travelX.sample(servoX.angle());
+        travelY.sample(servoY.angle());
+
+        float err = hypotf(light.sunX - servoX.angle(), light.sunY - servoY.angle());
+        errSum += err;
+        if (err > errMax)
+            errMax = err;
+        ticks++;
+    }
+
+    // Distância percorrida pelo sol na fase 2 (o mínimo que os servos andam)
+    float sunTravel = 0.5f * trackMs / 1000.0f;
+
+    printf("  %-16s %7.2f s %6.1f/%4.1f deg %8u deg %8.2f/%4.2f deg %7u deg (sol %.0f) %8u\n",
+           run.name, settledAt / 1000.0f, overshootX, overshootY, stepTravel,
+           errSum / ticks, errMax, travelX.total + travelY.total, sunTravel,
+           servoX.writeCount() + servoY.writeCount());
+}
+
+// Despertar do deep sleep com o sol onde o painel parou: begin() volta a 90
+// e retorna, begin(x, y) parte do ângulo guardado na memória RTC
+static uint32_t wakeTravel(bool restore)
+{
+    static FakeClock clock;
+    static FakeGpio gpio;
+    static FakeAdcSource adc;
+    FakeServo servoX, servoY;
+    Hal::install(&clock, &gpio, &adc, nullptr);
+
+    SunTracker tracker(LDR_TL, LDR_TR, LDR_BL, LDR_BR, 26, 27, servoX, servoY);
+    if (restore)
+        tracker.begin((int)STEP_X, (int)STEP_Y);
+    else
+        tracker.begin();
+    tracker.setMode(TRACKER_MODE_PID);
+    tracker.setGains(TRACKER_AXIS_X, TRACKER_P_GAINS);
+    tracker.setGains(TRACKER_AXIS_Y, TRACKER_P_GAINS);
+
+    SimLight light;
+    light.sunX = STEP_X;
+    light.sunY = STEP_Y;
+    TravelMeter travelX, travelY;
+    // O servo está fisicamente no ângulo em que dormiu
+    travelX.start((int)STEP_X);
+    travelY.start((int)STEP_Y);
+    travelX.sample(servoX.angle());
+    travelY.sample(servoY.angle());
+
+    for (uint32_t t = 0; t < 5000; t += TICK_MS)
+    {
+        light.apply(adc, servoX.angle(), servoY.angle(), LDR_TL, LDR_TR, LDR_BL, LDR_BR);
+        tracker.update();
+        clock.advanceMs(TICK_MS);
+        travelX.sample(servoX.angle());
+        travelY.sample(servoY.angle());
+    }
+    if (restore)
+    {
+        CHECK_EQ(servoX.angle(), (int)STEP_X);
+        CHECK_EQ(servoY.angle(), (int)STEP_Y);
+    }
+    return travelX.total + travelY.total;
+}
+
+void scenarioTracker()
+{
+    static const TrackerRun RUNS[] = {
+        {"passo fixo", TRACKER_MODE_STEP, TRACKER_PID_GAINS},
+        {"P + zona morta", TRACKER_MODE_PID, TRACKER_P_GAINS},
+        {"PID", TRACKER_MODE_PID, TRACKER_PID_GAINS},
+    };
+
+    printf("  %-16s %9s %16s %12s %17s %11s %17s\n", "modo", "converg.", "overshoot X/Y", "curso", "erro med/max", "curso seg.", "escritas");
+    for (size_t i = 0; i < sizeof(RUNS) / sizeof(RUNS[0]); i++)
+        runMode(RUNS[i]);
+
+    uint32_t homed = wakeTravel(false);
+    uint32_t restored = wakeTravel(true);
+    CHECK(homed > 0);
+    CHECK_EQ(restored, 0);
+    printf("  Despertar com o sol em %.0f/%.0f: curso %u deg indo a 90, %u deg com o ângulo da memória RTC\n",
+           STEP_X, STEP_Y, homed, restored);
+}